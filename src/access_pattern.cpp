@@ -0,0 +1,176 @@
+#include "access_pattern.hpp"
+
+#include <cstdlib>
+
+#include "string_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+// Ratio of transitions covered by the suggested readahead size.
+constexpr double READAHEAD_COVERAGE = 0.9;
+
+// Max readahead size to suggest.
+constexpr uint64_t MAX_READAHEAD_BYTES = 1ULL << 40;
+
+// Get the access pattern with the most transitions, earlier patterns win ties.
+AccessPattern GetMostCommonPattern(const std::array<uint64_t, kAccessPatternCount> &transition_counts) {
+	idx_t most_common_idx = 0;
+	for (idx_t idx = 1; idx < kAccessPatternCount; ++idx) {
+		if (transition_counts[idx] > transition_counts[most_common_idx]) {
+			most_common_idx = idx;
+		}
+	}
+	if (transition_counts[most_common_idx] == 0) {
+		return AccessPattern::kUnknown;
+	}
+	return static_cast<AccessPattern>(most_common_idx);
+}
+} // namespace
+
+const std::array<const char *, kAccessPatternCount> ACCESS_PATTERN_NAMES = {{
+    "sequential",
+    "strided",
+    "random",
+}};
+
+const char *GetAccessPatternName(AccessPattern access_pattern) {
+	if (access_pattern == AccessPattern::kUnknown) {
+		return "unknown";
+	}
+	return ACCESS_PATTERN_NAMES[static_cast<idx_t>(access_pattern)];
+}
+
+AccessPatternTracker::AccessPatternTracker() {
+}
+
+void AccessPatternTracker::RecordRead(idx_t location, int64_t nr_bytes) {
+	const idx_t end_offset = location + static_cast<idx_t>(nr_bytes);
+	std::lock_guard<std::mutex> lck(mu);
+	if (read_count++ == 0) {
+		prev_end_offset = end_offset;
+		return;
+	}
+
+	const int64_t gap = static_cast<int64_t>(location) - static_cast<int64_t>(prev_end_offset);
+	AccessPattern access_pattern = AccessPattern::kRandom;
+	if (gap == 0) {
+		access_pattern = AccessPattern::kSequential;
+	} else if (gap == prev_gap) {
+		access_pattern = AccessPattern::kStrided;
+	}
+	++transition_counts[static_cast<idx_t>(access_pattern)];
+	if (gap != 0) {
+		gap_histogram.Add(static_cast<double>(std::llabs(gap)));
+	}
+	// Distance is recorded half a byte less, so a distance of exactly 2^k falls into buckets below 2^k, whose bounds
+	// are aligned to powers of two.
+	if (gap >= 0 && end_offset > prev_end_offset) {
+		readahead_distance_histogram.Add(static_cast<double>(end_offset - prev_end_offset) - 0.5);
+	}
+
+	prev_end_offset = end_offset;
+	prev_gap = gap;
+}
+
+AccessPattern AccessPatternTracker::Classify() const {
+	std::lock_guard<std::mutex> lck(mu);
+	return GetMostCommonPattern(transition_counts);
+}
+
+AccessPatternStats::AccessPatternStats()
+    : gap_histogram(make_uniq<Histogram>()), readahead_distance_histogram(make_uniq<Histogram>()) {
+}
+
+void AccessPatternStats::RecordHandleClose(const AccessPatternTracker &tracker) {
+	std::lock_guard<std::mutex> lck(tracker.mu);
+	++handle_count;
+	read_count += tracker.read_count;
+	for (idx_t idx = 0; idx < kAccessPatternCount; ++idx) {
+		transition_counts[idx] += tracker.transition_counts[idx];
+	}
+	gap_histogram->Merge(tracker.gap_histogram);
+	readahead_distance_histogram->Merge(tracker.readahead_distance_histogram);
+}
+
+void AccessPatternStats::Merge(const AccessPatternStats &other) {
+	handle_count += other.handle_count;
+	read_count += other.read_count;
+	for (idx_t idx = 0; idx < kAccessPatternCount; ++idx) {
+		transition_counts[idx] += other.transition_counts[idx];
+	}
+	gap_histogram->Merge(*other.gap_histogram);
+	readahead_distance_histogram->Merge(*other.readahead_distance_histogram);
+}
+
+uint64_t AccessPatternStats::GetTransitionCount() const {
+	uint64_t transition_count = 0;
+	for (auto cur_count : transition_counts) {
+		transition_count += cur_count;
+	}
+	return transition_count;
+}
+
+AccessPattern AccessPatternStats::Classify() const {
+	return GetMostCommonPattern(transition_counts);
+}
+
+double AccessPatternStats::GetTransitionRatio(AccessPattern access_pattern) const {
+	const auto transition_count = GetTransitionCount();
+	if (transition_count == 0) {
+		return 0.0;
+	}
+	return static_cast<double>(transition_counts[static_cast<idx_t>(access_pattern)]) / transition_count;
+}
+
+uint64_t AccessPatternStats::GetSuggestedReadaheadBytes() const {
+	const auto forward_count = readahead_distance_histogram->counts();
+	if (forward_count == 0 || forward_count * 2 < GetTransitionCount()) {
+		return 0;
+	}
+	const double target_count = static_cast<double>(forward_count) * READAHEAD_COVERAGE;
+	uint64_t readahead_bytes = 1;
+	while (readahead_bytes < MAX_READAHEAD_BYTES &&
+	       static_cast<double>(GetAvoidableRequestCount(readahead_bytes)) < target_count) {
+		readahead_bytes <<= 1;
+	}
+	return readahead_bytes;
+}
+
+uint64_t AccessPatternStats::GetAvoidableRequestCount(uint64_t readahead_bytes) const {
+	// Bucket bounds are aligned to powers of two, so it's exact for a power-of-two readahead size.
+	// Distances are recorded half a byte less, so buckets below [readahead_bytes] hold all distances within it.
+	uint64_t avoidable_count = 0;
+	const auto &histogram = *readahead_distance_histogram;
+	for (idx_t idx = 0; idx < histogram.BucketCount(); ++idx) {
+		if (histogram.BucketUpperBound(idx) > static_cast<double>(readahead_bytes)) {
+			break;
+		}
+		avoidable_count += histogram.BucketRecordCount(idx);
+	}
+	return avoidable_count;
+}
+
+void AccessPatternCollector::RecordHandleClose(const string &filepath, const AccessPatternTracker &tracker) {
+	auto &cur_stats = stats[std::make_pair(GetObjectStorageBucket(filepath), GetFileType(filepath))];
+	if (cur_stats == nullptr) {
+		cur_stats = make_uniq<AccessPatternStats>();
+	}
+	cur_stats->RecordHandleClose(tracker);
+}
+
+void AccessPatternCollector::Merge(const AccessPatternCollector &other) {
+	for (const auto &key_and_stats : other.stats) {
+		auto &cur_stats = stats[key_and_stats.first];
+		if (cur_stats == nullptr) {
+			cur_stats = make_uniq<AccessPatternStats>();
+		}
+		cur_stats->Merge(*key_and_stats.second);
+	}
+}
+
+void AccessPatternCollector::Reset() {
+	stats.clear();
+}
+
+} // namespace duckdb
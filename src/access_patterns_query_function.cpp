@@ -0,0 +1,133 @@
+#include "access_patterns_query_function.hpp"
+
+#include <array>
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "access_pattern.hpp"
+#include "metrics_collector.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct AccessPatternRow {
+	string filesystem;
+	// Empty if not an object storage path.
+	string bucket;
+	// Empty if the file has no extension.
+	string file_type;
+	uint64_t handle_count = 0;
+	uint64_t read_count = 0;
+	AccessPattern access_pattern = AccessPattern::kUnknown;
+	std::array<double, kAccessPatternCount> transition_ratios {};
+	// Only valid if there's any non-sequential transition.
+	bool has_gap = false;
+	double p50_gap_bytes = 0.0;
+	double p90_gap_bytes = 0.0;
+	uint64_t suggested_readahead_bytes = 0;
+	uint64_t avoidable_request_count = 0;
+};
+
+unique_ptr<FunctionData> ObservefsAccessPatternsQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                              vector<LogicalType> &return_types,
+                                                              vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        // NULL if not an object storage path.
+	        {"bucket", LogicalTypeId::VARCHAR},
+	        // NULL if the file has no extension.
+	        {"file_type", LogicalTypeId::VARCHAR},
+	        {"handles", LogicalTypeId::UBIGINT},
+	        {"reads", LogicalTypeId::UBIGINT},
+	        // Most common kind of transition between consecutive reads, one of "sequential", "strided", "random" and
+	        // "unknown".
+	        {"pattern", LogicalTypeId::VARCHAR},
+	        {"sequential_ratio", LogicalTypeId::DOUBLE},
+	        {"strided_ratio", LogicalTypeId::DOUBLE},
+	        {"random_ratio", LogicalTypeId::DOUBLE},
+	        // Absolute gaps between non-sequential consecutive reads, NULL if all reads are sequential.
+	        {"p50_gap_bytes", LogicalTypeId::DOUBLE},
+	        {"p90_gap_bytes", LogicalTypeId::DOUBLE},
+	        // Readahead size which would have served most reads with the previous request, 0 if readahead doesn't
+	        // help.
+	        {"suggested_readahead_bytes", LogicalTypeId::UBIGINT},
+	        // Number of requests which would have been avoided with the suggested readahead size.
+	        {"avoidable_requests", LogicalTypeId::UBIGINT},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsAccessPatternsQueryFuncInit(ClientContext &context,
+                                                                          TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<AccessPatternRow>>();
+	const auto snapshots = GetAllMetricsSnapshots(context);
+	for (const auto &cur_snapshot : snapshots) {
+		for (const auto &key_and_stats : cur_snapshot.second.access_pattern_stats.GetAllStats()) {
+			const auto &stats = *key_and_stats.second;
+			AccessPatternRow row;
+			row.filesystem = cur_snapshot.first;
+			row.bucket = key_and_stats.first.first;
+			row.file_type = key_and_stats.first.second;
+			row.handle_count = stats.handle_count;
+			row.read_count = stats.read_count;
+			row.access_pattern = stats.Classify();
+			for (idx_t idx = 0; idx < kAccessPatternCount; ++idx) {
+				row.transition_ratios[idx] = stats.GetTransitionRatio(static_cast<AccessPattern>(idx));
+			}
+			const auto &gap_histogram = stats.GetGapHistogram();
+			row.has_gap = gap_histogram.counts() > 0;
+			if (row.has_gap) {
+				row.p50_gap_bytes = gap_histogram.Quantile(0.5);
+				row.p90_gap_bytes = gap_histogram.Quantile(0.9);
+			}
+			row.suggested_readahead_bytes = stats.GetSuggestedReadaheadBytes();
+			if (row.suggested_readahead_bytes > 0) {
+				row.avoidable_request_count = stats.GetAvoidableRequestCount(row.suggested_readahead_bytes);
+			}
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	return std::move(result);
+}
+
+void EmitAccessPatternRow(const AccessPatternRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetStringColumnValueOrNull(output.data[1], row_idx, row.bucket);
+	SetStringColumnValueOrNull(output.data[2], row_idx, row.file_type);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, row.handle_count);
+	SetColumnValue<uint64_t>(output.data[4], row_idx, row.read_count);
+	SetStringColumnValue(output.data[5], row_idx, GetAccessPatternName(row.access_pattern));
+	SetColumnValue<double>(output.data[6], row_idx,
+	                       row.transition_ratios[static_cast<idx_t>(AccessPattern::kSequential)]);
+	SetColumnValue<double>(output.data[7], row_idx, row.transition_ratios[static_cast<idx_t>(AccessPattern::kStrided)]);
+	SetColumnValue<double>(output.data[8], row_idx, row.transition_ratios[static_cast<idx_t>(AccessPattern::kRandom)]);
+	if (row.has_gap) {
+		SetColumnValue<double>(output.data[9], row_idx, row.p50_gap_bytes);
+		SetColumnValue<double>(output.data[10], row_idx, row.p90_gap_bytes);
+	} else {
+		FlatVector::SetNull(output.data[9], row_idx, true);
+		FlatVector::SetNull(output.data[10], row_idx, true);
+	}
+	SetColumnValue<uint64_t>(output.data[11], row_idx, row.suggested_readahead_bytes);
+	SetColumnValue<uint64_t>(output.data[12], row_idx, row.avoidable_request_count);
+}
+
+} // namespace
+
+TableFunction ObservefsAccessPatternsQueryFunc() {
+	TableFunction access_patterns_query_func {
+	    /*name=*/"observefs_access_patterns",
+	    /*arguments=*/ {},
+	    /*function=*/EmitMaterializedRows<AccessPatternRow, EmitAccessPatternRow>,
+	    /*bind=*/ObservefsAccessPatternsQueryFuncBind,
+	    /*init_global=*/ObservefsAccessPatternsQueryFuncInit};
+	return access_patterns_query_func;
+}
+
+} // namespace duckdb
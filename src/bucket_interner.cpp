@@ -0,0 +1,35 @@
+#include "bucket_interner.hpp"
+
+namespace duckdb {
+
+namespace {
+// FNV-1a hash over the given byte range.
+uint64_t HashSlice(const StringSlice &slice) {
+	constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+	uint64_t hash = FNV_OFFSET_BASIS;
+	for (idx_t idx = 0; idx < slice.size; ++idx) {
+		hash ^= static_cast<uint8_t>(slice.data[idx]);
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+} // namespace
+
+idx_t BucketInterner::GetOrIntern(const StringSlice &bucket) {
+	const auto hash = HashSlice(bucket);
+	auto &ids = hash_to_ids[hash];
+	for (const auto cur_id : ids) {
+		const auto &cur_bucket = buckets[cur_id];
+		if (cur_bucket.compare(0, string::npos, bucket.data, bucket.size) == 0) {
+			return cur_id;
+		}
+	}
+
+	const idx_t new_id = buckets.size();
+	buckets.emplace_back(bucket.data, bucket.size);
+	ids.emplace_back(new_id);
+	return new_id;
+}
+
+} // namespace duckdb
@@ -0,0 +1,85 @@
+#include "cache_mrc_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct CacheMrcRow {
+	string filesystem;
+	uint64_t block_size = 0;
+	uint64_t sampled_access_count = 0;
+	double sample_rate = 0.0;
+	CacheMissRatioPoint point;
+};
+
+unique_ptr<FunctionData> ObservefsCacheMrcQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types, vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        {"block_size", LogicalTypeId::UBIGINT},
+	        // Simulated LRU cache size.
+	        {"cache_size_bytes", LogicalTypeId::UBIGINT},
+	        // Number of block references sampled, and the current fraction of blocks sampled.
+	        {"sampled_accesses", LogicalTypeId::UBIGINT},
+	        {"sample_rate", LogicalTypeId::DOUBLE},
+	        {"hit_ratio", LogicalTypeId::DOUBLE},
+	        {"miss_ratio", LogicalTypeId::DOUBLE},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsCacheMrcQueryFuncInit(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<CacheMrcRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto curve = cur_filesystem->GetCacheMissRatioCurve();
+		// Skip filesystems without any simulated read.
+		if (curve.sampled_access_count == 0) {
+			continue;
+		}
+		const auto filesystem = cur_filesystem->GetName();
+		for (const auto &cur_point : curve.points) {
+			CacheMrcRow row;
+			row.filesystem = filesystem;
+			row.block_size = curve.block_size;
+			row.sampled_access_count = curve.sampled_access_count;
+			row.sample_rate = curve.sample_rate;
+			row.point = cur_point;
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	return std::move(result);
+}
+
+void EmitCacheMrcRow(const CacheMrcRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetColumnValue<uint64_t>(output.data[1], row_idx, row.block_size);
+	SetColumnValue<uint64_t>(output.data[2], row_idx, row.point.cache_size_bytes);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, row.sampled_access_count);
+	SetColumnValue<double>(output.data[4], row_idx, row.sample_rate);
+	SetColumnValue<double>(output.data[5], row_idx, row.point.hit_ratio);
+	SetColumnValue<double>(output.data[6], row_idx, 1.0 - row.point.hit_ratio);
+}
+
+} // namespace
+
+TableFunction ObservefsCacheMrcQueryFunc() {
+	TableFunction cache_mrc_query_func {/*name=*/"observefs_cache_mrc",
+	                                    /*arguments=*/ {},
+	                                    /*function=*/EmitMaterializedRows<CacheMrcRow, EmitCacheMrcRow>,
+	                                    /*bind=*/ObservefsCacheMrcQueryFuncBind,
+	                                    /*init_global=*/ObservefsCacheMrcQueryFuncInit};
+	return cache_mrc_query_func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,164 @@
+#include "cache_mrc_simulator.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "duckdb/common/assert.hpp"
+
+namespace duckdb {
+
+constexpr idx_t CacheMrcSimulator::MAX_SAMPLED_BLOCK_COUNT;
+constexpr idx_t CacheMrcSimulator::DEFAULT_BLOCK_SIZE;
+constexpr idx_t CacheMrcSimulator::CACHE_SIZE_COUNT;
+constexpr uint64_t CacheMrcSimulator::MIN_CACHE_SIZE;
+constexpr uint64_t CacheMrcSimulator::CACHE_SIZE_GROWTH_FACTOR;
+constexpr idx_t CacheMrcSimulator::TIMESTAMP_CAPACITY;
+
+namespace {
+// Mix block id into path hash, so that consecutive blocks of the same file are spread uniformly (splitmix64).
+uint64_t GetBlockHash(uint64_t path_hash, uint64_t block_id) {
+	uint64_t hash = path_hash + 0x9E3779B97F4A7C15ULL * (block_id + 1);
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+	return hash ^ (hash >> 31);
+}
+
+// Get the simulated cache size at the given index.
+uint64_t GetCacheSize(idx_t idx) {
+	uint64_t cache_size = CacheMrcSimulator::MIN_CACHE_SIZE;
+	for (idx_t cur_idx = 0; cur_idx < idx; ++cur_idx) {
+		cache_size *= CacheMrcSimulator::CACHE_SIZE_GROWTH_FACTOR;
+	}
+	return cache_size;
+}
+} // namespace
+
+CacheMrcSimulator::CacheMrcSimulator() {
+	ResetWithLock();
+}
+
+void CacheMrcSimulator::UpdateTimestamp(idx_t timestamp, int32_t delta) {
+	for (idx_t idx = timestamp + 1; idx <= TIMESTAMP_CAPACITY; idx += idx & (~idx + 1)) {
+		timestamp_tree[idx] += delta;
+	}
+}
+
+idx_t CacheMrcSimulator::CountTimestampsBefore(idx_t timestamp) const {
+	int64_t count = 0;
+	for (idx_t idx = timestamp; idx > 0; idx -= idx & (~idx + 1)) {
+		count += timestamp_tree[idx];
+	}
+	return static_cast<idx_t>(count);
+}
+
+void CacheMrcSimulator::ResetWithLock() {
+	sample_threshold = UINT64_MAX;
+	block_timestamps.clear();
+	timestamp_tree.assign(TIMESTAMP_CAPACITY + 1, 0);
+	next_timestamp = 0;
+	sampled_access_count = 0;
+	hit_counts.fill(0);
+}
+
+void CacheMrcSimulator::CompactTimestampsWithLock() {
+	vector<std::pair<idx_t, uint64_t>> timestamp_and_hashes;
+	timestamp_and_hashes.reserve(block_timestamps.size());
+	for (const auto &hash_and_timestamp : block_timestamps) {
+		timestamp_and_hashes.emplace_back(hash_and_timestamp.second, hash_and_timestamp.first);
+	}
+	std::sort(timestamp_and_hashes.begin(), timestamp_and_hashes.end());
+
+	std::fill(timestamp_tree.begin(), timestamp_tree.end(), 0);
+	next_timestamp = 0;
+	for (const auto &timestamp_and_hash : timestamp_and_hashes) {
+		block_timestamps[timestamp_and_hash.second] = next_timestamp;
+		UpdateTimestamp(next_timestamp, /*delta=*/1);
+		++next_timestamp;
+	}
+}
+
+void CacheMrcSimulator::RecordBlockWithLock(uint64_t block_hash) {
+	if (block_hash >= sample_threshold) {
+		return;
+	}
+	if (next_timestamp == TIMESTAMP_CAPACITY) {
+		CompactTimestampsWithLock();
+	}
+
+	++sampled_access_count;
+	auto iter = block_timestamps.find(block_hash);
+	if (iter != block_timestamps.end()) {
+		// Reuse distance is the number of distinct blocks accessed since the last access, scaled by sample rate.
+		const auto last_timestamp = iter->second;
+		const auto sampled_distance = CountTimestampsBefore(next_timestamp) - CountTimestampsBefore(last_timestamp + 1);
+		const double sample_rate = static_cast<double>(sample_threshold) / static_cast<double>(UINT64_MAX);
+		const double distance_bytes = static_cast<double>(sampled_distance) / sample_rate * block_size;
+		for (idx_t idx = 0; idx < CACHE_SIZE_COUNT; ++idx) {
+			if (distance_bytes < static_cast<double>(GetCacheSize(idx))) {
+				++hit_counts[idx];
+			}
+		}
+		UpdateTimestamp(last_timestamp, /*delta=*/-1);
+		iter->second = next_timestamp;
+		UpdateTimestamp(next_timestamp++, /*delta=*/1);
+		return;
+	}
+
+	// First access to the block is a compulsory miss for all cache sizes.
+	block_timestamps.emplace(block_hash, next_timestamp);
+	UpdateTimestamp(next_timestamp++, /*delta=*/1);
+	if (block_timestamps.size() > MAX_SAMPLED_BLOCK_COUNT) {
+		auto evict_iter = std::prev(block_timestamps.end());
+		UpdateTimestamp(evict_iter->second, /*delta=*/-1);
+		sample_threshold = evict_iter->first;
+		block_timestamps.erase(evict_iter);
+	}
+}
+
+void CacheMrcSimulator::SetBlockSize(idx_t block_size_p) {
+	D_ASSERT(block_size_p > 0);
+	std::lock_guard<std::mutex> lck(mu);
+	if (block_size == block_size_p) {
+		return;
+	}
+	block_size = block_size_p;
+	ResetWithLock();
+}
+
+void CacheMrcSimulator::RecordRead(const string &path, idx_t location, idx_t nr_bytes) {
+	if (!IsEnabled() || nr_bytes == 0) {
+		return;
+	}
+	const uint64_t path_hash = std::hash<string> {}(path);
+	std::lock_guard<std::mutex> lck(mu);
+	const idx_t last_block_id = (location + nr_bytes - 1) / block_size;
+	for (idx_t block_id = location / block_size; block_id <= last_block_id; ++block_id) {
+		RecordBlockWithLock(GetBlockHash(path_hash, block_id));
+	}
+}
+
+CacheMissRatioCurve CacheMrcSimulator::GetMissRatioCurve() {
+	std::lock_guard<std::mutex> lck(mu);
+	CacheMissRatioCurve curve;
+	curve.block_size = block_size;
+	curve.sampled_access_count = sampled_access_count;
+	curve.sample_rate = static_cast<double>(sample_threshold) / static_cast<double>(UINT64_MAX);
+	curve.points.reserve(CACHE_SIZE_COUNT);
+	for (idx_t idx = 0; idx < CACHE_SIZE_COUNT; ++idx) {
+		CacheMissRatioPoint point;
+		point.cache_size_bytes = GetCacheSize(idx);
+		if (sampled_access_count > 0) {
+			point.hit_ratio = static_cast<double>(hit_counts[idx]) / static_cast<double>(sampled_access_count);
+		}
+		curve.points.emplace_back(point);
+	}
+	return curve;
+}
+
+void CacheMrcSimulator::Reset() {
+	std::lock_guard<std::mutex> lck(mu);
+	ResetWithLock();
+}
+
+} // namespace duckdb
@@ -0,0 +1,58 @@
+#include "cached_range_index.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+void CachedRangeIndex::AddRange(const string &path, idx_t location, idx_t nr_bytes) {
+	if (nr_bytes == 0) {
+		return;
+	}
+	path_to_ranges[path].emplace_back(CachedRange {location, location + nr_bytes});
+}
+
+void CachedRangeIndex::Finalize() {
+	for (auto &path_and_ranges : path_to_ranges) {
+		auto &ranges = path_and_ranges.second;
+		std::sort(ranges.begin(), ranges.end(),
+		          [](const CachedRange &lhs, const CachedRange &rhs) { return lhs.start < rhs.start; });
+		idx_t merged_count = 0;
+		for (const auto &cur_range : ranges) {
+			if (merged_count > 0 && cur_range.start <= ranges[merged_count - 1].end) {
+				auto &last_range = ranges[merged_count - 1];
+				last_range.end = std::max(last_range.end, cur_range.end);
+				continue;
+			}
+			ranges[merged_count++] = cur_range;
+		}
+		ranges.resize(merged_count);
+		ranges.shrink_to_fit();
+	}
+}
+
+idx_t CachedRangeIndex::GetCachedBytes(const string &path, idx_t location, idx_t nr_bytes) const {
+	auto iter = path_to_ranges.find(path);
+	if (iter == path_to_ranges.end() || nr_bytes == 0) {
+		return 0;
+	}
+	const auto &ranges = iter->second;
+	const idx_t end = location + nr_bytes;
+
+	// Start from the last range starting at or before the request, which is the only one that could cover its start.
+	auto range_iter = std::upper_bound(ranges.begin(), ranges.end(), location,
+	                                   [](idx_t offset, const CachedRange &range) { return offset < range.start; });
+	if (range_iter != ranges.begin()) {
+		--range_iter;
+	}
+	idx_t cached_bytes = 0;
+	for (; range_iter != ranges.end() && range_iter->start < end; ++range_iter) {
+		const auto overlap_start = std::max(range_iter->start, location);
+		const auto overlap_end = std::min(range_iter->end, end);
+		if (overlap_start < overlap_end) {
+			cached_bytes += overlap_end - overlap_start;
+		}
+	}
+	return cached_bytes;
+}
+
+} // namespace duckdb
@@ -0,0 +1,160 @@
+#include "ddsketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "duckdb/common/assert.hpp"
+
+namespace duckdb {
+
+constexpr double DDSketch::DEFAULT_RELATIVE_ACCURACY;
+constexpr idx_t DDSketch::MAX_BUCKET_COUNT;
+
+namespace {
+// Values are tracked down to nanoseconds when recorded in microseconds, smaller ones are indistinguishable from zero.
+constexpr double MIN_TRACKED_VALUE = 1e-3;
+} // namespace
+
+DDSketch::DDSketch(double relative_accuracy_p)
+    : relative_accuracy(relative_accuracy_p), gamma((1 + relative_accuracy_p) / (1 - relative_accuracy_p)),
+      log_gamma(std::log(gamma)), min_indexable_value(MIN_TRACKED_VALUE) {
+	D_ASSERT(relative_accuracy > 0 && relative_accuracy < 1);
+}
+
+int32_t DDSketch::Key(double val) const {
+	return static_cast<int32_t>(std::ceil(std::log(val) / log_gamma));
+}
+
+double DDSketch::Value(int32_t key) const {
+	// Midpoint (in relative terms) of bucket (gamma^(key-1), gamma^key].
+	return 2.0 * std::pow(gamma, key) / (gamma + 1);
+}
+
+idx_t DDSketch::GetOrExtendBucket(int32_t key) {
+	if (buckets.empty()) {
+		key_offset = key;
+		buckets.resize(1, 0);
+		return 0;
+	}
+
+	// Extend towards higher keys; collapse lowest buckets if the bucket count limit is exceeded.
+	if (key >= key_offset + static_cast<int32_t>(buckets.size())) {
+		const idx_t new_size = static_cast<idx_t>(key - key_offset) + 1;
+		if (new_size > MAX_BUCKET_COUNT) {
+			const idx_t collapse_count = new_size - MAX_BUCKET_COUNT;
+			uint64_t collapsed = 0;
+			for (idx_t idx = 0; idx < collapse_count && idx < buckets.size(); ++idx) {
+				collapsed += buckets[idx];
+			}
+			if (collapse_count >= buckets.size()) {
+				std::fill(buckets.begin(), buckets.end(), 0);
+			} else {
+				buckets.erase(buckets.begin(), buckets.begin() + static_cast<int64_t>(collapse_count));
+			}
+			key_offset += static_cast<int32_t>(collapse_count);
+			buckets.resize(MAX_BUCKET_COUNT, 0);
+			buckets[0] += collapsed;
+		} else {
+			buckets.resize(new_size, 0);
+		}
+		return static_cast<idx_t>(key - key_offset);
+	}
+
+	// Extend towards lower keys; keys beyond the bucket count limit fall into the lowest bucket.
+	// Buckets are prepended geometrically (but never below the min indexable key), so a slowly decreasing minimum
+	// doesn't shift and reallocate all buckets every time.
+	if (key < key_offset) {
+		const int32_t min_key = Key(min_indexable_value);
+		const idx_t required_count = static_cast<idx_t>(key_offset - key);
+		const idx_t padded_count =
+		    std::min(std::max(required_count, buckets.size()), static_cast<idx_t>(key_offset - min_key));
+		const idx_t extend_count = std::min(padded_count, MAX_BUCKET_COUNT - buckets.size());
+		if (extend_count == 0) {
+			return 0;
+		}
+		buckets.insert(buckets.begin(), extend_count, 0);
+		key_offset -= static_cast<int32_t>(extend_count);
+		return key < key_offset ? 0 : static_cast<idx_t>(key - key_offset);
+	}
+
+	return static_cast<idx_t>(key - key_offset);
+}
+
+void DDSketch::Add(double val) {
+	val = std::max(val, 0.0);
+	if (val < min_indexable_value) {
+		++zero_count;
+	} else {
+		++buckets[GetOrExtendBucket(Key(val))];
+	}
+
+	if (total_count == 0) {
+		min_value = val;
+		max_value = val;
+	} else {
+		min_value = std::min(min_value, val);
+		max_value = std::max(max_value, val);
+	}
+	++total_count;
+}
+
+void DDSketch::Merge(const DDSketch &other) {
+	D_ASSERT(relative_accuracy == other.relative_accuracy);
+	if (other.total_count == 0) {
+		return;
+	}
+
+	zero_count += other.zero_count;
+	for (idx_t idx = 0; idx < other.buckets.size(); ++idx) {
+		if (other.buckets[idx] == 0) {
+			continue;
+		}
+		buckets[GetOrExtendBucket(other.key_offset + static_cast<int32_t>(idx))] += other.buckets[idx];
+	}
+
+	if (total_count == 0) {
+		min_value = other.min_value;
+		max_value = other.max_value;
+	} else {
+		min_value = std::min(min_value, other.min_value);
+		max_value = std::max(max_value, other.max_value);
+	}
+	total_count += other.total_count;
+}
+
+double DDSketch::Quantile(double q) const {
+	if (total_count == 0) {
+		return 0.0;
+	}
+	if (q <= 0.0) {
+		return min_value;
+	}
+	if (q >= 1.0) {
+		return max_value;
+	}
+
+	const double rank = q * static_cast<double>(total_count - 1);
+	double cumulative_count = static_cast<double>(zero_count);
+	if (cumulative_count > rank) {
+		return min_value;
+	}
+	for (idx_t idx = 0; idx < buckets.size(); ++idx) {
+		cumulative_count += static_cast<double>(buckets[idx]);
+		if (cumulative_count > rank) {
+			const double estimate = Value(key_offset + static_cast<int32_t>(idx));
+			return std::min(std::max(estimate, min_value), max_value);
+		}
+	}
+	return max_value;
+}
+
+void DDSketch::Reset() {
+	zero_count = 0;
+	std::fill(buckets.begin(), buckets.end(), 0);
+	total_count = 0;
+	min_value = 0.0;
+	max_value = 0.0;
+}
+
+} // namespace duckdb
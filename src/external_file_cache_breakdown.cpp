@@ -0,0 +1,81 @@
+#include "external_file_cache_breakdown.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "string_utils.hpp"
+
+namespace duckdb {
+
+constexpr idx_t ExternalFileCacheBreakdown::PATH_CAPACITY;
+
+void CacheAccessRecord::RecordAccess(idx_t requested_bytes, idx_t cached_bytes) {
+	hit_bytes += cached_bytes;
+	miss_bytes += requested_bytes - cached_bytes;
+	if (cached_bytes == 0) {
+		++miss_count;
+	} else if (cached_bytes < requested_bytes) {
+		++partial_hit_count;
+		++partial_hit_coverage_counts[GetPartialHitCoverageBucket(requested_bytes, cached_bytes)];
+	} else {
+		++hit_count;
+	}
+}
+
+void CacheAccessRecord::Merge(const CacheAccessRecord &other) {
+	hit_count += other.hit_count;
+	miss_count += other.miss_count;
+	partial_hit_count += other.partial_hit_count;
+	hit_bytes += other.hit_bytes;
+	miss_bytes += other.miss_bytes;
+	for (idx_t idx = 0; idx < PARTIAL_HIT_COVERAGE_BUCKET_COUNT; ++idx) {
+		partial_hit_coverage_counts[idx] += other.partial_hit_coverage_counts[idx];
+	}
+}
+
+void PathCacheAccessRecord::RecordAccess(idx_t requested_bytes, idx_t cached_bytes) {
+	++request_count;
+	record.RecordAccess(requested_bytes, cached_bytes);
+}
+
+void PathCacheAccessRecord::Merge(const PathCacheAccessRecord &other) {
+	D_ASSERT(path == other.path);
+	request_count += other.request_count;
+	request_count_error += other.request_count_error;
+	record.Merge(other.record);
+}
+
+void PathCacheAccessRecord::ResetTrackedStats() {
+	record = CacheAccessRecord {};
+}
+
+void ExternalFileCacheBreakdown::RecordAccess(const string &filepath, idx_t requested_bytes, idx_t cached_bytes) {
+	path_sketch.GetOrCreate(filepath).RecordAccess(requested_bytes, cached_bytes);
+
+	const auto bucket = GetObjectStorageBucketSlice(filepath);
+	if (bucket.empty()) {
+		return;
+	}
+	const auto bucket_id = bucket_interner.GetOrIntern(bucket);
+	if (bucket_id == bucket_records.size()) {
+		bucket_records.emplace_back();
+	}
+	bucket_records[bucket_id].RecordAccess(requested_bytes, cached_bytes);
+}
+
+vector<NamedCacheAccessRecord> ExternalFileCacheBreakdown::GetBucketRecords() const {
+	vector<NamedCacheAccessRecord> named_bucket_records;
+	named_bucket_records.reserve(bucket_records.size());
+	for (idx_t bucket_id = 0; bucket_id < bucket_records.size(); ++bucket_id) {
+		named_bucket_records.emplace_back(
+		    NamedCacheAccessRecord {bucket_interner.GetBucket(bucket_id), bucket_records[bucket_id]});
+	}
+	return named_bucket_records;
+}
+
+void ExternalFileCacheBreakdown::Reset() {
+	for (auto &cur_bucket_record : bucket_records) {
+		cur_bucket_record = CacheAccessRecord {};
+	}
+	path_sketch.Reset();
+}
+
+} // namespace duckdb
@@ -1,6 +1,9 @@
 #include "external_file_cache_query_function.hpp"
 
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "external_file_cache_stats_recorder.hpp"
+#include "observefs_instance_state.hpp"
 
 namespace duckdb {
 
@@ -18,8 +21,8 @@ unique_ptr<FunctionData> ExternalFileCacheAccessBind(ClientContext &context, Tab
 	D_ASSERT(return_types.empty());
 	D_ASSERT(names.empty());
 
-	return_types.reserve(3);
-	names.reserve(3);
+	return_types.reserve(6 + PARTIAL_HIT_COVERAGE_BUCKET_COUNT);
+	names.reserve(6 + PARTIAL_HIT_COVERAGE_BUCKET_COUNT);
 
 	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
 	names.emplace_back("cache hit count");
@@ -30,14 +33,32 @@ unique_ptr<FunctionData> ExternalFileCacheAccessBind(ClientContext &context, Tab
 	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
 	names.emplace_back("cache partial hit");
 
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("cache hit bytes");
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("cache miss bytes");
+
+	// Ratio of requested bytes served by cache, NULL if no bytes requested.
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+	names.emplace_back("cache byte hit ratio");
+
+	// Partial hits bucketed by coverage ratio.
+	for (idx_t idx = 0; idx < PARTIAL_HIT_COVERAGE_BUCKET_COUNT; ++idx) {
+		const auto lower_percent = idx * 100 / PARTIAL_HIT_COVERAGE_BUCKET_COUNT;
+		const auto upper_percent = (idx + 1) * 100 / PARTIAL_HIT_COVERAGE_BUCKET_COUNT;
+		return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+		names.emplace_back(StringUtil::Format("cache partial hit %d-%d%%", lower_percent, upper_percent));
+	}
+
 	return nullptr;
 }
 
 unique_ptr<GlobalTableFunctionState> ExternalFileCacheAccessInit(ClientContext &context,
                                                                  TableFunctionInitInput &input) {
 	auto result = make_uniq<CacheAccessData>();
-	auto &external_file_cache_stats_recorder = GetExternalFileCacheStatsRecorder();
-	result->cache_access_record = external_file_cache_stats_recorder.GetCacheAccessRecord();
+	auto &instance_state = GetInstanceStateOrThrow(*context.db);
+	result->cache_access_record = instance_state.external_file_cache_stats_recorder->GetCacheAccessRecord();
 	return std::move(result);
 }
 
@@ -51,11 +72,174 @@ void ExternalFileCacheAccessFunc(ClientContext &context, TableFunctionInput &dat
 	data.emitted = true;
 
 	// Start filling in the result buffer.
-	output.SetValue(/*col_idx=*/0, /*index=*/0, Value::UBIGINT(data.cache_access_record.hit_count));
-	output.SetValue(/*col_idx=*/1, /*index=*/0, Value::UBIGINT(data.cache_access_record.miss_count));
-	output.SetValue(/*col_idx=*/2, /*index=*/0, Value::UBIGINT(data.cache_access_record.partial_hit_count));
+	const auto &cache_access_record = data.cache_access_record;
+	output.SetValue(/*col_idx=*/0, /*index=*/0, Value::UBIGINT(cache_access_record.hit_count));
+	output.SetValue(/*col_idx=*/1, /*index=*/0, Value::UBIGINT(cache_access_record.miss_count));
+	output.SetValue(/*col_idx=*/2, /*index=*/0, Value::UBIGINT(cache_access_record.partial_hit_count));
+	output.SetValue(/*col_idx=*/3, /*index=*/0, Value::UBIGINT(cache_access_record.hit_bytes));
+	output.SetValue(/*col_idx=*/4, /*index=*/0, Value::UBIGINT(cache_access_record.miss_bytes));
+	const auto requested_bytes = cache_access_record.hit_bytes + cache_access_record.miss_bytes;
+	if (requested_bytes == 0) {
+		output.SetValue(/*col_idx=*/5, /*index=*/0, Value(LogicalType {LogicalTypeId::DOUBLE}));
+	} else {
+		const auto byte_hit_ratio =
+		    static_cast<double>(cache_access_record.hit_bytes) / static_cast<double>(requested_bytes);
+		output.SetValue(/*col_idx=*/5, /*index=*/0, Value::DOUBLE(byte_hit_ratio));
+	}
+	for (idx_t idx = 0; idx < PARTIAL_HIT_COVERAGE_BUCKET_COUNT; ++idx) {
+		output.SetValue(/*col_idx=*/6 + idx, /*index=*/0,
+		                Value::UBIGINT(cache_access_record.partial_hit_coverage_counts[idx]));
+	}
 	output.SetCardinality(/*count=*/1);
 }
+struct CacheAccessBreakdownRow {
+	// Either "bucket" or "path".
+	string scope;
+	// Bucket name or file path.
+	string name;
+	CacheAccessRecord record;
+	// Exact for buckets, estimated for paths.
+	uint64_t access_count = 0;
+	uint64_t access_count_error = 0;
+};
+
+struct CacheAccessBreakdownBindData : public TableFunctionData {
+	// Number of most accessed paths to return.
+	idx_t k = 0;
+};
+
+struct CacheAccessBreakdownData : public GlobalTableFunctionState {
+	vector<CacheAccessBreakdownRow> rows;
+
+	// Used to record the progress of emission.
+	uint64_t offset = 0;
+};
+
+unique_ptr<FunctionData> ExternalFileCacheBreakdownBind(ClientContext &context, TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+
+	const auto k = input.inputs[0].GetValue<int64_t>();
+	if (k <= 0) {
+		throw InvalidInputException("Number of top paths should be positive, but got %d", k);
+	}
+	auto bind_data = make_uniq<CacheAccessBreakdownBindData>();
+	bind_data->k = static_cast<idx_t>(k);
+
+	return_types.reserve(10);
+	names.reserve(10);
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("scope");
+
+	// Bucket name or file path.
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("name");
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("cache hit count");
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("cache miss count");
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("cache partial hit");
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("cache hit bytes");
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("cache miss bytes");
+
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+	names.emplace_back("cache byte hit ratio");
+
+	// Number of accesses, which is estimated for paths and never underestimated; cache records of a path only cover
+	// accesses since it's tracked.
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("access count");
+
+	// Max overestimation of access count, always 0 for buckets.
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("access count error");
+
+	return std::move(bind_data);
+}
+
+unique_ptr<GlobalTableFunctionState> ExternalFileCacheBreakdownInit(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	const auto &bind_data = input.bind_data->Cast<CacheAccessBreakdownBindData>();
+	auto result = make_uniq<CacheAccessBreakdownData>();
+	auto &instance_state = GetInstanceStateOrThrow(*context.db);
+	auto breakdown = instance_state.external_file_cache_stats_recorder->GetCacheAccessBreakdown(bind_data.k);
+	result->rows.reserve(breakdown.bucket_records.size() + breakdown.path_records.size());
+	for (auto &cur_bucket_record : breakdown.bucket_records) {
+		CacheAccessBreakdownRow row;
+		row.scope = "bucket";
+		row.name = std::move(cur_bucket_record.name);
+		row.record = cur_bucket_record.record;
+		row.access_count = cur_bucket_record.record.GetAccessCount();
+		result->rows.emplace_back(std::move(row));
+	}
+	for (auto &cur_path_record : breakdown.path_records) {
+		CacheAccessBreakdownRow row;
+		row.scope = "path";
+		row.name = std::move(cur_path_record.path);
+		row.record = cur_path_record.record;
+		row.access_count = cur_path_record.request_count;
+		row.access_count_error = cur_path_record.request_count_error;
+		result->rows.emplace_back(std::move(row));
+	}
+	return std::move(result);
+}
+
+void ExternalFileCacheBreakdownFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<CacheAccessBreakdownData>();
+
+	// All entries have been emitted.
+	if (data.offset >= data.rows.size()) {
+		return;
+	}
+
+	// Start filling in the result buffer, values are written into vectors directly.
+	auto &scope_vec = output.data[0];
+	auto &name_vec = output.data[1];
+	auto &byte_hit_ratio_vec = output.data[7];
+	auto *scope_data = FlatVector::GetData<string_t>(scope_vec);
+	auto *name_data = FlatVector::GetData<string_t>(name_vec);
+	auto *hit_count_data = FlatVector::GetData<uint64_t>(output.data[2]);
+	auto *miss_count_data = FlatVector::GetData<uint64_t>(output.data[3]);
+	auto *partial_hit_count_data = FlatVector::GetData<uint64_t>(output.data[4]);
+	auto *hit_bytes_data = FlatVector::GetData<uint64_t>(output.data[5]);
+	auto *miss_bytes_data = FlatVector::GetData<uint64_t>(output.data[6]);
+	auto *byte_hit_ratio_data = FlatVector::GetData<double>(byte_hit_ratio_vec);
+	auto *access_count_data = FlatVector::GetData<uint64_t>(output.data[8]);
+	auto *access_count_error_data = FlatVector::GetData<uint64_t>(output.data[9]);
+
+	idx_t count = 0;
+	while (data.offset < data.rows.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &row = data.rows[data.offset++];
+		const auto &record = row.record;
+		scope_data[count] = StringVector::AddString(scope_vec, row.scope);
+		name_data[count] = StringVector::AddString(name_vec, row.name);
+		hit_count_data[count] = record.hit_count;
+		miss_count_data[count] = record.miss_count;
+		partial_hit_count_data[count] = record.partial_hit_count;
+		hit_bytes_data[count] = record.hit_bytes;
+		miss_bytes_data[count] = record.miss_bytes;
+		const auto requested_bytes = record.hit_bytes + record.miss_bytes;
+		if (requested_bytes == 0) {
+			FlatVector::SetNull(byte_hit_ratio_vec, count, true);
+		} else {
+			byte_hit_ratio_data[count] = static_cast<double>(record.hit_bytes) / static_cast<double>(requested_bytes);
+		}
+		access_count_data[count] = row.access_count;
+		access_count_error_data[count] = row.access_count_error;
+		count++;
+	}
+	output.SetCardinality(count);
+}
 } // namespace
 
 TableFunction ExternalFileCacheAccessQueryFunc() {
@@ -67,4 +251,13 @@ TableFunction ExternalFileCacheAccessQueryFunc() {
 	return external_file_cache_access_query_func;
 }
 
+TableFunction ExternalFileCacheBreakdownQueryFunc() {
+	TableFunction external_file_cache_breakdown_query_func {/*name=*/"observefs_external_file_cache_breakdown",
+	                                                        /*arguments=*/ {LogicalTypeId::BIGINT},
+	                                                        /*function=*/ExternalFileCacheBreakdownFunc,
+	                                                        /*bind=*/ExternalFileCacheBreakdownBind,
+	                                                        /*init_global=*/ExternalFileCacheBreakdownInit};
+	return external_file_cache_breakdown_query_func;
+}
+
 } // namespace duckdb
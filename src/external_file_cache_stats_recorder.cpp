@@ -1,141 +1,165 @@
 #include "external_file_cache_stats_recorder.hpp"
 
 #include <algorithm>
+#include <utility>
 
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/storage/external_file_cache.hpp"
+#include "time_utils.hpp"
 
 namespace duckdb {
 
-namespace {
-// Record cache access stats information, we need to know the cache block information from external file cache.
-// It's not cheap to load such information, so amotize the cost and only load at intervals.
-//
-// If current cache entry size is larger than [`CACHE_LOAD_THRESHOLD`], load cache information at intervals
-// [`LARGE_LOAD_CACHE_INTERVAL`]. Otherwise load cache information at smaller intervals [`SMALL_LOAD_CACHE_INTERVAL`].
-constexpr idx_t CACHE_LOAD_THRESHOLD = 64;
-constexpr idx_t SMALL_LOAD_CACHE_INTERVAL = 4;
-constexpr idx_t LARGE_LOAD_CACHE_INTERVAL = 32;
-
-// Global stats recorder.
-unique_ptr<ExternalFileCacheStatsRecorder> g_stats_recorder;
-
-} // namespace
+constexpr int64_t ExternalFileCacheStatsRecorder::SNAPSHOT_REFRESH_INTERVAL_MILLISEC;
 
 CacheAccessRecord ExternalFileCacheStatsRecorder::GetCacheAccessRecord() const {
-	std::lock_guard<std::mutex> lck(mu);
+	CacheAccessRecord cache_access_record;
+	cache_access_record.hit_count = hit_count.load(std::memory_order_relaxed);
+	cache_access_record.miss_count = miss_count.load(std::memory_order_relaxed);
+	cache_access_record.partial_hit_count = partial_hit_count.load(std::memory_order_relaxed);
+	cache_access_record.hit_bytes = hit_bytes.load(std::memory_order_relaxed);
+	cache_access_record.miss_bytes = miss_bytes.load(std::memory_order_relaxed);
+	for (idx_t idx = 0; idx < PARTIAL_HIT_COVERAGE_BUCKET_COUNT; ++idx) {
+		cache_access_record.partial_hit_coverage_counts[idx] =
+		    partial_hit_coverage_counts[idx].load(std::memory_order_relaxed);
+	}
 	return cache_access_record;
 }
 
+CacheAccessBreakdown ExternalFileCacheStatsRecorder::GetCacheAccessBreakdown(idx_t k) {
+	struct MergedPathRecord {
+		PathCacheAccessRecord path_record;
+		// Sum of min tracked access count for shards which track the path.
+		uint64_t tracking_shard_min_count = 0;
+	};
+	map<string, CacheAccessRecord> merged_bucket_records;
+	unordered_map<string, MergedPathRecord> merged_path_records;
+	// Sum of min tracked access count for all shards.
+	uint64_t total_shard_min_count = 0;
+	breakdown_shards.ForEachShard([&](const ExternalFileCacheBreakdown &cur_shard) {
+		for (const auto &cur_bucket_record : cur_shard.GetBucketRecords()) {
+			if (cur_bucket_record.record.GetAccessCount() > 0) {
+				merged_bucket_records[cur_bucket_record.name].Merge(cur_bucket_record.record);
+			}
+		}
+		const auto shard_min_count = cur_shard.GetMinPathAccessCount();
+		total_shard_min_count += shard_min_count;
+		for (const auto &cur_path_record : cur_shard.GetPathRecords()) {
+			if (cur_path_record->request_count == 0) {
+				continue;
+			}
+			auto iter = merged_path_records.find(cur_path_record->path);
+			if (iter == merged_path_records.end()) {
+				merged_path_records.emplace(cur_path_record->path,
+				                            MergedPathRecord {*cur_path_record, shard_min_count});
+				continue;
+			}
+			iter->second.path_record.Merge(*cur_path_record);
+			iter->second.tracking_shard_min_count += shard_min_count;
+		}
+	});
+
+	CacheAccessBreakdown breakdown;
+	breakdown.bucket_records.reserve(merged_bucket_records.size());
+	for (auto &cur_bucket_record : merged_bucket_records) {
+		breakdown.bucket_records.emplace_back(
+		    NamedCacheAccessRecord {cur_bucket_record.first, cur_bucket_record.second});
+	}
+	auto &path_records = breakdown.path_records;
+	path_records.reserve(merged_path_records.size());
+	for (auto &cur_path_record : merged_path_records) {
+		// Accesses on shards which don't track the path are bounded by their min tracked count.
+		const auto untracked_access_bound = total_shard_min_count - cur_path_record.second.tracking_shard_min_count;
+		cur_path_record.second.path_record.request_count += untracked_access_bound;
+		cur_path_record.second.path_record.request_count_error += untracked_access_bound;
+		path_records.emplace_back(std::move(cur_path_record.second.path_record));
+	}
+	// Ties are broken by path, so the result is deterministic.
+	const auto has_more_accesses = [](const PathCacheAccessRecord &lhs, const PathCacheAccessRecord &rhs) {
+		if (lhs.request_count != rhs.request_count) {
+			return lhs.request_count > rhs.request_count;
+		}
+		return lhs.path < rhs.path;
+	};
+	const auto top_count = std::min<idx_t>(k, path_records.size());
+	std::partial_sort(path_records.begin(), path_records.begin() + static_cast<int64_t>(top_count),
+	                  path_records.end(), has_more_accesses);
+	path_records.resize(top_count);
+	return breakdown;
+}
+
 void ExternalFileCacheStatsRecorder::Enable() {
-	std::lock_guard<std::mutex> lck(mu);
-	enabled = true;
+	enabled.store(true, std::memory_order_relaxed);
 }
 void ExternalFileCacheStatsRecorder::Disable() {
-	std::lock_guard<std::mutex> lck(mu);
-	enabled = false;
+	enabled.store(false, std::memory_order_relaxed);
 }
 void ExternalFileCacheStatsRecorder::AccessRead(const string &filepath, idx_t start_offset, idx_t bytes_to_read) {
-	CachedFileInformation cur_cache_file_info;
-	cur_cache_file_info.path = filepath;
-	cur_cache_file_info.nr_bytes = bytes_to_read;
-	cur_cache_file_info.location = start_offset;
-	cur_cache_file_info.loaded = false; // Fill in "false" for binary search.
-
-	std::lock_guard<std::mutex> lck(mu);
-	if (!enabled || !external_file_cache->IsEnabled()) {
+	if (!enabled.load(std::memory_order_relaxed) || !external_file_cache.IsEnabled()) {
 		return;
 	}
 
-	// Check current access.
-	UpdateCacheAccessRecordWithLock(cur_cache_file_info);
-
-	// Trigger cache information update if necessary.
-	++cur_load_iteration;
-	if (cache_blocks.size() <= CACHE_LOAD_THRESHOLD) {
-		if (cur_load_iteration % SMALL_LOAD_CACHE_INTERVAL == 0) {
-			UpdateExternalFileCacheWithLock();
-		}
-		return;
+	// Check current access against the latest snapshot, treated as a miss if no snapshot has been loaded.
+	const auto snapshot = std::atomic_load(&cached_ranges_snapshot);
+	const idx_t cached_bytes =
+	    snapshot == nullptr ? 0 : snapshot->GetCachedBytes(filepath, start_offset, bytes_to_read);
+	hit_bytes.fetch_add(cached_bytes, std::memory_order_relaxed);
+	miss_bytes.fetch_add(bytes_to_read - cached_bytes, std::memory_order_relaxed);
+	if (cached_bytes == 0) {
+		miss_count.fetch_add(1, std::memory_order_relaxed);
+	} else if (cached_bytes < bytes_to_read) {
+		partial_hit_count.fetch_add(1, std::memory_order_relaxed);
+		const auto bucket_idx = GetPartialHitCoverageBucket(bytes_to_read, cached_bytes);
+		partial_hit_coverage_counts[bucket_idx].fetch_add(1, std::memory_order_relaxed);
+	} else {
+		hit_count.fetch_add(1, std::memory_order_relaxed);
 	}
-
-	if (cur_load_iteration % LARGE_LOAD_CACHE_INTERVAL == 0) {
-		UpdateExternalFileCacheWithLock();
+	{
+		auto &shard = breakdown_shards.GetLocalShard();
+		std::lock_guard<std::mutex> lck(shard.mu);
+		shard.state.RecordAccess(filepath, bytes_to_read, cached_bytes);
 	}
-}
 
-void ExternalFileCacheStatsRecorder::UpdateCacheAccessRecordWithLock(const CachedFileInformation &cache_file_info) {
-	auto iter = std::lower_bound(cache_blocks.begin(), cache_blocks.end(), cache_file_info,
-	                             [](const auto &lhs, const auto &rhs) {
-		                             return std::tie(lhs.path, lhs.location, lhs.nr_bytes, lhs.loaded) <
-		                                    std::tie(rhs.path, rhs.location, rhs.nr_bytes, rhs.loaded);
-	                             });
+	MaybeRefreshSnapshot();
+}
 
-	if (iter == cache_blocks.end()) {
-		++cache_access_record.miss_count;
-		return;
-	}
-	if (iter->path != cache_file_info.path) {
-		++cache_access_record.miss_count;
-		return;
-	}
-	if (!iter->loaded) {
-		++cache_access_record.miss_count;
+void ExternalFileCacheStatsRecorder::MaybeRefreshSnapshot() {
+	const auto now_millisec = GetSteadyNowMilliSecSinceEpoch();
+	if (now_millisec < next_refresh_millisec.load(std::memory_order_relaxed)) {
 		return;
 	}
-
-	const auto cached_start_offset = iter->location;
-	const auto cached_end_offset = iter->location + iter->nr_bytes;
-	const auto request_start_offset = cache_file_info.location;
-	const auto request_end_offset = cache_file_info.location + cache_file_info.nr_bytes;
-	if (request_start_offset >= cached_end_offset) {
-		++cache_access_record.miss_count;
+	std::unique_lock<std::mutex> refresh_lck(refresh_mu, std::try_to_lock);
+	if (!refresh_lck.owns_lock()) {
 		return;
 	}
-	if (request_end_offset <= cached_start_offset) {
-		++cache_access_record.miss_count;
+	// Check again, in case another thread has just refreshed.
+	if (now_millisec < next_refresh_millisec.load(std::memory_order_relaxed)) {
 		return;
 	}
+	next_refresh_millisec.store(now_millisec + SNAPSHOT_REFRESH_INTERVAL_MILLISEC, std::memory_order_relaxed);
 
-	// Theere's overlap between cached content and requested one.
-	if (request_start_offset >= cached_start_offset && request_end_offset <= cached_end_offset) {
-		++cache_access_record.hit_count;
-		return;
+	auto new_snapshot = std::make_shared<CachedRangeIndex>();
+	for (const auto &cur_cache_file_info : external_file_cache.GetCachedFileInformation()) {
+		if (!cur_cache_file_info.loaded) {
+			continue;
+		}
+		new_snapshot->AddRange(cur_cache_file_info.path, cur_cache_file_info.location,
+		                       cur_cache_file_info.nr_bytes);
 	}
-
-	++cache_access_record.partial_hit_count;
-}
-
-void ExternalFileCacheStatsRecorder::UpdateExternalFileCacheWithLock() {
-	auto cache_file_information = external_file_cache->GetCachedFileInformation();
-	std::sort(cache_file_information.begin(), cache_file_information.end(), [](const auto &lhs, const auto &rhs) {
-		return std::tie(lhs.path, lhs.location, lhs.nr_bytes, lhs.loaded) <
-		       std::tie(rhs.path, rhs.location, rhs.nr_bytes, rhs.loaded);
-	});
+	new_snapshot->Finalize();
+	std::atomic_store(&cached_ranges_snapshot, std::shared_ptr<const CachedRangeIndex>(std::move(new_snapshot)));
 }
 
 void ExternalFileCacheStatsRecorder::ClearCacheAccessRecord() {
-	std::lock_guard<std::mutex> lck(mu);
-	cache_access_record.hit_count = 0;
-	cache_access_record.miss_count = 0;
-	cache_access_record.partial_hit_count = 0;
-}
-
-void ExternalFileCacheStatsRecorder::ResetExternalFileCache(ExternalFileCache &cache) {
-	std::lock_guard<std::mutex> lck(mu);
-	external_file_cache = &cache;
-}
-
-ExternalFileCacheStatsRecorder &GetExternalFileCacheStatsRecorder() {
-	D_ASSERT(g_stats_recorder != nullptr);
-	return *g_stats_recorder;
-}
-
-void InitOrResetExternalFileCache(ExternalFileCache &cache) {
-	if (g_stats_recorder == nullptr) {
-		g_stats_recorder = make_uniq<ExternalFileCacheStatsRecorder>(cache);
-	} else {
-		g_stats_recorder->ResetExternalFileCache(cache);
+	hit_count.store(0, std::memory_order_relaxed);
+	miss_count.store(0, std::memory_order_relaxed);
+	partial_hit_count.store(0, std::memory_order_relaxed);
+	hit_bytes.store(0, std::memory_order_relaxed);
+	miss_bytes.store(0, std::memory_order_relaxed);
+	for (auto &cur_count : partial_hit_coverage_counts) {
+		cur_count.store(0, std::memory_order_relaxed);
 	}
+	breakdown_shards.ForEachShard([](ExternalFileCacheBreakdown &cur_shard) { cur_shard.Reset(); });
 }
 
 } // namespace duckdb
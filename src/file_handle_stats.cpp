@@ -0,0 +1,103 @@
+#include "file_handle_stats.hpp"
+
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+namespace {
+constexpr double NANOS_PER_MICRO = 1000.0;
+} // namespace
+
+const std::array<const char *, kFileHandleMetricCount> FILE_HANDLE_METRIC_NAMES = {{
+    "reads",
+    "read_bytes",
+    "seeks",
+    "sequential_read_percent",
+    "open_duration",
+    "io_wait",
+}};
+
+const std::array<const char *, kFileHandleMetricCount> FILE_HANDLE_METRIC_UNITS = {{
+    "reads",
+    "bytes",
+    "seeks",
+    "%",
+    "microsec",
+    "microsec",
+}};
+
+FileHandleCounters::FileHandleCounters(int64_t open_timestamp_ns_p) : open_timestamp_ns(open_timestamp_ns_p) {
+}
+
+void FileHandleCounters::RecordRead(idx_t location, int64_t nr_bytes) {
+	read_count.fetch_add(1, std::memory_order_relaxed);
+	read_bytes.fetch_add(static_cast<uint64_t>(nr_bytes), std::memory_order_relaxed);
+	const auto prev_offset =
+	    next_sequential_offset.exchange(location + static_cast<idx_t>(nr_bytes), std::memory_order_relaxed);
+	if (prev_offset == location) {
+		sequential_read_count.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void FileHandleCounters::RecordSeek() {
+	seek_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::array<double, kFileHandleMetricCount> FileHandleCounters::GetMetrics(int64_t close_timestamp_ns) const {
+	std::array<double, kFileHandleMetricCount> metrics;
+	const auto cur_read_count = read_count.load(std::memory_order_relaxed);
+	metrics[static_cast<idx_t>(FileHandleMetric::kReadCount)] = static_cast<double>(cur_read_count);
+	metrics[static_cast<idx_t>(FileHandleMetric::kReadBytes)] =
+	    static_cast<double>(read_bytes.load(std::memory_order_relaxed));
+	metrics[static_cast<idx_t>(FileHandleMetric::kSeekCount)] =
+	    static_cast<double>(seek_count.load(std::memory_order_relaxed));
+	// Handles without any read are regarded as fully sequential.
+	metrics[static_cast<idx_t>(FileHandleMetric::kSequentialReadPercent)] =
+	    cur_read_count == 0 ? 100.0
+	                        : sequential_read_count.load(std::memory_order_relaxed) * 100.0 / cur_read_count;
+	metrics[static_cast<idx_t>(FileHandleMetric::kOpenDuration)] =
+	    static_cast<double>(close_timestamp_ns - open_timestamp_ns) / NANOS_PER_MICRO;
+	metrics[static_cast<idx_t>(FileHandleMetric::kIoWait)] =
+	    static_cast<double>(io_wait_ns.load(std::memory_order_relaxed)) / NANOS_PER_MICRO;
+	return metrics;
+}
+
+FileHandleStatsCollector::FileHandleStatsCollector() {
+	for (idx_t idx = 0; idx < kFileHandleMetricCount; ++idx) {
+		metric_histograms[idx] = make_uniq<Histogram>();
+		metric_histograms[idx]->SetStatsDistribution(FILE_HANDLE_METRIC_NAMES[idx], FILE_HANDLE_METRIC_UNITS[idx]);
+	}
+}
+
+void FileHandleStatsCollector::RecordHandleClose(const std::array<double, kFileHandleMetricCount> &metrics) {
+	for (idx_t idx = 0; idx < kFileHandleMetricCount; ++idx) {
+		metric_histograms[idx]->Add(metrics[idx]);
+	}
+}
+
+void FileHandleStatsCollector::Merge(const FileHandleStatsCollector &other) {
+	for (idx_t idx = 0; idx < kFileHandleMetricCount; ++idx) {
+		metric_histograms[idx]->Merge(*other.metric_histograms[idx]);
+	}
+}
+
+void FileHandleStatsCollector::Reset() {
+	for (auto &cur_histogram : metric_histograms) {
+		cur_histogram->Reset();
+	}
+}
+
+string FileHandleStatsCollector::GetHumanReadableStats() const {
+	string stats;
+	for (idx_t idx = 0; idx < kFileHandleMetricCount; ++idx) {
+		const auto &cur_histogram = *metric_histograms[idx];
+		if (cur_histogram.counts() == 0) {
+			continue;
+		}
+		stats += StringUtil::Format("\nPer-open %s histogram is %s", FILE_HANDLE_METRIC_NAMES[idx],
+		                            cur_histogram.FormatString());
+	}
+	return stats;
+}
+
+} // namespace duckdb
@@ -0,0 +1,102 @@
+#include "handle_stats_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "file_handle_stats.hpp"
+#include "metrics_collector.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct FileHandleStatsRow {
+	string filesystem;
+	FileHandleMetric metric = FileHandleMetric::kUnknown;
+	uint64_t count = 0;
+	double mean = 0.0;
+	double min = 0.0;
+	double max = 0.0;
+	double p50 = 0.0;
+	double p90 = 0.0;
+	double p99 = 0.0;
+};
+
+unique_ptr<FunctionData> ObservefsHandleStatsQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                           vector<LogicalType> &return_types, vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        {"metric", LogicalTypeId::VARCHAR},
+	        {"unit", LogicalTypeId::VARCHAR},
+	        // Number of closed handles.
+	        {"count", LogicalTypeId::UBIGINT},
+	        // Distribution of per-open values over closed handles.
+	        {"mean", LogicalTypeId::DOUBLE},
+	        {"min", LogicalTypeId::DOUBLE},
+	        {"max", LogicalTypeId::DOUBLE},
+	        {"p50", LogicalTypeId::DOUBLE},
+	        {"p90", LogicalTypeId::DOUBLE},
+	        {"p99", LogicalTypeId::DOUBLE},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsHandleStatsQueryFuncInit(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<FileHandleStatsRow>>();
+	const auto snapshots = GetAllMetricsSnapshots(context);
+	for (const auto &cur_snapshot : snapshots) {
+		for (idx_t idx = 0; idx < kFileHandleMetricCount; ++idx) {
+			const auto metric = static_cast<FileHandleMetric>(idx);
+			const auto &histogram = cur_snapshot.second.file_handle_stats.GetHistogram(metric);
+			if (histogram.counts() == 0) {
+				continue;
+			}
+			FileHandleStatsRow row;
+			row.filesystem = cur_snapshot.first;
+			row.metric = metric;
+			row.count = histogram.counts();
+			row.mean = histogram.mean();
+			row.min = histogram.min();
+			row.max = histogram.max();
+			row.p50 = histogram.Quantile(0.5);
+			row.p90 = histogram.Quantile(0.9);
+			row.p99 = histogram.Quantile(0.99);
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	return std::move(result);
+}
+
+void EmitFileHandleStatsRow(const FileHandleStatsRow &row, DataChunk &output, idx_t row_idx) {
+	const auto metric_idx = static_cast<idx_t>(row.metric);
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetStringColumnValue(output.data[1], row_idx, FILE_HANDLE_METRIC_NAMES[metric_idx]);
+	SetStringColumnValue(output.data[2], row_idx, FILE_HANDLE_METRIC_UNITS[metric_idx]);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, row.count);
+	SetColumnValue<double>(output.data[4], row_idx, row.mean);
+	SetColumnValue<double>(output.data[5], row_idx, row.min);
+	SetColumnValue<double>(output.data[6], row_idx, row.max);
+	SetColumnValue<double>(output.data[7], row_idx, row.p50);
+	SetColumnValue<double>(output.data[8], row_idx, row.p90);
+	SetColumnValue<double>(output.data[9], row_idx, row.p99);
+}
+
+} // namespace
+
+TableFunction ObservefsHandleStatsQueryFunc() {
+	TableFunction handle_stats_query_func {
+	    /*name=*/"observefs_handle_stats",
+	    /*arguments=*/ {},
+	    /*function=*/EmitMaterializedRows<FileHandleStatsRow, EmitFileHandleStatsRow>,
+	    /*bind=*/ObservefsHandleStatsQueryFuncBind,
+	    /*init_global=*/ObservefsHandleStatsQueryFuncInit};
+	return handle_stats_query_func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,344 @@
+#include "hedged_reader.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+namespace {
+// Max number of requests issued for one read, i.e., the original one and one duplicate.
+constexpr idx_t MAX_REQUEST_COUNT = 2;
+} // namespace
+
+constexpr double HedgedReadPolicy::HEDGE_LATENCY_QUANTILE;
+constexpr int64_t HedgedReadPolicy::LATENCY_WINDOW_SEC;
+constexpr uint64_t HedgedReadPolicy::MIN_RECORD_COUNT;
+constexpr int64_t HedgedReadPolicy::MIN_HEDGE_DELAY_NS;
+constexpr int64_t HedgedReadPolicy::THRESHOLD_REFRESH_INTERVAL_NS;
+constexpr idx_t HedgedReadPolicy::MAX_BUCKET_COUNT;
+constexpr idx_t HedgedReadPolicy::DEFAULT_BUDGET_PERCENT;
+constexpr idx_t HedgedReadExecutor::DEFAULT_MAX_THREAD_COUNT;
+constexpr idx_t HedgedReader::HANDLE_COUNT;
+
+void HedgedReadStats::Reset() {
+	request_count.store(0, std::memory_order_relaxed);
+	hedged_request_count.store(0, std::memory_order_relaxed);
+	hedge_win_count.store(0, std::memory_order_relaxed);
+	budget_exhausted_count.store(0, std::memory_order_relaxed);
+}
+
+int64_t HedgedReadPolicy::GetThresholdNs(const string &bucket, int64_t now_ns, const ComputeLatencyFunc &compute) {
+	{
+		std::lock_guard<std::mutex> lck(mu);
+		auto iter = thresholds.find(bucket);
+		if (iter != thresholds.end() && now_ns < iter->second.refresh_timestamp_ns) {
+			return iter->second.threshold_ns;
+		}
+		if (iter == thresholds.end() && thresholds.size() >= MAX_BUCKET_COUNT) {
+			thresholds.clear();
+		}
+		// Claim the refresh, so concurrent reads keep using the stale threshold instead of recomputing it.
+		thresholds[bucket].refresh_timestamp_ns = now_ns + THRESHOLD_REFRESH_INTERVAL_NS;
+	}
+
+	// Computing latency quantile merges stats from all threads, which is done without holding the lock.
+	const double latency_microsec = compute(bucket);
+	int64_t threshold_ns = -1;
+	if (latency_microsec >= 0 && static_cast<int64_t>(latency_microsec * 1000) >= MIN_HEDGE_DELAY_NS) {
+		threshold_ns = static_cast<int64_t>(latency_microsec * 1000);
+	}
+	std::lock_guard<std::mutex> lck(mu);
+	thresholds[bucket].threshold_ns = threshold_ns;
+	return threshold_ns;
+}
+
+bool HedgedReadPolicy::HasBudget(const HedgedReadStats &stats) const {
+	const idx_t max_percent = budget_percent.load(std::memory_order_relaxed);
+	const uint64_t request_count = stats.request_count.load(std::memory_order_relaxed);
+	const uint64_t hedged_request_count = stats.hedged_request_count.load(std::memory_order_relaxed);
+	return (hedged_request_count + 1) * 100 <= max_percent * request_count;
+}
+
+bool HedgedReadPolicy::TryAcquireBudget(HedgedReadStats &stats) const {
+	const idx_t max_percent = budget_percent.load(std::memory_order_relaxed);
+	const uint64_t request_count = stats.request_count.load(std::memory_order_relaxed);
+	uint64_t hedged_request_count = stats.hedged_request_count.load(std::memory_order_relaxed);
+	while ((hedged_request_count + 1) * 100 <= max_percent * request_count) {
+		if (stats.hedged_request_count.compare_exchange_weak(hedged_request_count, hedged_request_count + 1,
+		                                                     std::memory_order_relaxed)) {
+			return true;
+		}
+	}
+	stats.budget_exhausted_count.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+void HedgedReadPolicy::ReleaseBudget(HedgedReadStats &stats) const {
+	stats.hedged_request_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void HedgedReadPolicy::Reset() {
+	std::lock_guard<std::mutex> lck(mu);
+	thresholds.clear();
+}
+
+HedgedReadExecutor::HedgedReadExecutor(idx_t max_thread_count_p) : max_thread_count(max_thread_count_p) {
+}
+
+HedgedReadExecutor::~HedgedReadExecutor() {
+	{
+		std::lock_guard<std::mutex> lck(mu);
+		stopped = true;
+		cv.notify_all();
+	}
+	for (auto &cur_worker : workers) {
+		cur_worker.join();
+	}
+}
+
+void HedgedReadExecutor::RunWorker() {
+	// The thread is counted as idle when started.
+	std::unique_lock<std::mutex> lck(mu);
+	while (true) {
+		cv.wait(lck, [this]() { return stopped || !pending_tasks.empty(); });
+		if (pending_tasks.empty()) {
+			--idle_worker_count;
+			return;
+		}
+		auto task = std::move(pending_tasks.back());
+		pending_tasks.pop_back();
+		--idle_worker_count;
+		lck.unlock();
+		task();
+		lck.lock();
+		++idle_worker_count;
+	}
+}
+
+bool HedgedReadExecutor::TrySubmit(Task task) {
+	std::lock_guard<std::mutex> lck(mu);
+	if (pending_tasks.size() >= idle_worker_count) {
+		if (workers.size() >= max_thread_count) {
+			return false;
+		}
+		try {
+			workers.emplace_back([this]() { RunWorker(); });
+		} catch (...) {
+			return false;
+		}
+		++idle_worker_count;
+	}
+	pending_tasks.emplace_back(std::move(task));
+	cv.notify_one();
+	return true;
+}
+
+// State of one read shared by the caller and all requests issued for it, which outlives the caller if any request is
+// still running.
+struct HedgedReader::HedgedRequest {
+	HedgedRequest(idx_t nr_bytes_p, idx_t location_p) : nr_bytes(nr_bytes_p), location(location_p) {
+	}
+
+	// Whether the read has completed, either served by one request or failed by all.
+	bool IsDoneWithLock() const {
+		return winner_idx >= 0 || failed_count == issued_count;
+	}
+
+	const idx_t nr_bytes;
+	const idx_t location;
+
+	std::mutex mu;
+	std::condition_variable cv;
+	// Handle which the original and the duplicate request are issued on.
+	std::array<idx_t, MAX_REQUEST_COUNT> handle_indices {};
+	idx_t issued_count = 0;
+	idx_t failed_count = 0;
+	// Index of the first successful request, or -1 if none yet.
+	int64_t winner_idx = -1;
+	// Exception thrown by the first failed request.
+	std::exception_ptr error;
+};
+
+HedgedReader::~HedgedReader() {
+	std::unique_lock<std::mutex> lck(mu);
+	cv.wait(lck, [this]() { return !handle_held[0] && !handle_held[1]; });
+}
+
+idx_t HedgedReader::AcquireHandle() {
+	std::unique_lock<std::mutex> lck(mu);
+	cv.wait(lck, [this]() { return !handle_held[0] || !handle_held[1]; });
+	const idx_t handle_idx = handle_held[0] ? 1 : 0;
+	handle_held[handle_idx] = true;
+	return handle_idx;
+}
+
+bool HedgedReader::TryAcquireHandle(idx_t &handle_idx) {
+	std::lock_guard<std::mutex> lck(mu);
+	for (idx_t idx = 0; idx < HANDLE_COUNT; ++idx) {
+		if (!handle_held[idx]) {
+			handle_held[idx] = true;
+			handle_idx = idx;
+			return true;
+		}
+	}
+	return false;
+}
+
+void HedgedReader::ReleaseHandle(idx_t handle_idx) {
+	// Notify with lock held, since the reader could be destructed as soon as the lock is released.
+	std::lock_guard<std::mutex> lck(mu);
+	handle_held[handle_idx] = false;
+	cv.notify_all();
+}
+
+void HedgedReader::ReadOnCallerThread(idx_t handle_idx, char *buffer, idx_t nr_bytes, idx_t location,
+                                      const FetchFunc &fetch) {
+	try {
+		fetch(handle_idx, buffer, nr_bytes, location);
+	} catch (...) {
+		ReleaseHandle(handle_idx);
+		throw;
+	}
+	ReleaseHandle(handle_idx);
+}
+
+void HedgedReader::ReadWithoutHedging(char *buffer, idx_t nr_bytes, idx_t location, const FetchFunc &fetch) {
+	if (!HasIssuedRequest()) {
+		fetch(/*handle_idx=*/0, buffer, nr_bytes, location);
+		return;
+	}
+	ReadOnCallerThread(AcquireHandle(), buffer, nr_bytes, location, fetch);
+}
+
+void HedgedReader::RunOnPrimaryHandle(const std::function<void()> &func) {
+	if (!HasIssuedRequest()) {
+		func();
+		return;
+	}
+	{
+		std::unique_lock<std::mutex> lck(mu);
+		cv.wait(lck, [this]() { return !handle_held[0]; });
+		handle_held[0] = true;
+	}
+	try {
+		func();
+	} catch (...) {
+		ReleaseHandle(/*handle_idx=*/0);
+		throw;
+	}
+	ReleaseHandle(/*handle_idx=*/0);
+}
+
+bool HedgedReader::IssueRequest(const shared_ptr<HedgedRequest> &request, idx_t request_idx, idx_t handle_idx,
+                                const FetchFunc &fetch, HedgedReadExecutor &executor) {
+	has_issued_request.store(true, std::memory_order_relaxed);
+	auto &handle_buffer = handle_buffers[handle_idx];
+	if (handle_buffer.size() < request->nr_bytes) {
+		handle_buffer.resize(request->nr_bytes);
+	}
+	auto task = [this, request, request_idx, handle_idx, fetch]() {
+		std::exception_ptr error;
+		try {
+			fetch(handle_idx, handle_buffers[handle_idx].data(), request->nr_bytes, request->location);
+		} catch (...) {
+			error = std::current_exception();
+		}
+		bool is_winner = false;
+		{
+			std::lock_guard<std::mutex> request_lck(request->mu);
+			if (error == nullptr) {
+				if (request->winner_idx < 0) {
+					request->winner_idx = static_cast<int64_t>(request_idx);
+					is_winner = true;
+				}
+			} else {
+				++request->failed_count;
+				if (request->error == nullptr) {
+					request->error = error;
+				}
+			}
+			request->cv.notify_all();
+		}
+		// The winning handle is released by the caller after copying the response, which could have destructed the
+		// reader since then.
+		if (!is_winner) {
+			ReleaseHandle(handle_idx);
+		}
+	};
+	bool issued = false;
+	try {
+		issued = executor.TrySubmit(std::move(task));
+	} catch (...) {
+		issued = false;
+	}
+	if (!issued) {
+		ReleaseHandle(handle_idx);
+	}
+	return issued;
+}
+
+void HedgedReader::Read(char *buffer, idx_t nr_bytes, idx_t location, int64_t threshold_ns, const FetchFunc &fetch,
+                        const HedgedReadPolicy &policy, HedgedReadStats &stats, HedgedReadExecutor &executor) {
+	stats.request_count.fetch_add(1, std::memory_order_relaxed);
+	const idx_t primary_handle_idx = AcquireHandle();
+	// No duplicate request could be issued, so there's no need to wait with timeout.
+	if (!policy.HasBudget(stats)) {
+		const auto start = std::chrono::steady_clock::now();
+		ReadOnCallerThread(primary_handle_idx, buffer, nr_bytes, location, fetch);
+		if (std::chrono::steady_clock::now() - start > std::chrono::nanoseconds(threshold_ns)) {
+			stats.budget_exhausted_count.fetch_add(1, std::memory_order_relaxed);
+		}
+		return;
+	}
+
+	auto request = make_shared_ptr<HedgedRequest>(nr_bytes, location);
+	request->handle_indices[0] = primary_handle_idx;
+	request->issued_count = 1;
+	if (!IssueRequest(request, /*request_idx=*/0, primary_handle_idx, fetch, executor)) {
+		// Executor is saturated, fall back to a plain read, which holds the handle again.
+		ReadWithoutHedging(buffer, nr_bytes, location, fetch);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lck(request->mu);
+	const auto is_done = [&request]() { return request->IsDoneWithLock(); };
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(threshold_ns);
+	if (!request->cv.wait_until(lck, deadline, is_done) && policy.TryAcquireBudget(stats)) {
+		// Budget is returned if the duplicate request can't be issued, and the read keeps waiting for the original one.
+		idx_t hedge_handle_idx = 0;
+		bool issued = false;
+		if (TryAcquireHandle(hedge_handle_idx)) {
+			request->handle_indices[1] = hedge_handle_idx;
+			++request->issued_count;
+			issued = IssueRequest(request, /*request_idx=*/1, hedge_handle_idx, fetch, executor);
+			if (!issued) {
+				--request->issued_count;
+			}
+		}
+		if (!issued) {
+			policy.ReleaseBudget(stats);
+		}
+	}
+	request->cv.wait(lck, is_done);
+	if (request->winner_idx < 0) {
+		std::rethrow_exception(request->error);
+	}
+	const auto winner_idx = static_cast<idx_t>(request->winner_idx);
+	const auto winner_handle_idx = request->handle_indices[winner_idx];
+	lck.unlock();
+
+	// The winning handle is still held, so its buffer isn't written again until released.
+	if (winner_idx != 0) {
+		stats.hedge_win_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	std::memcpy(buffer, handle_buffers[winner_handle_idx].data(), nr_bytes);
+	ReleaseHandle(winner_handle_idx);
+}
+
+} // namespace duckdb
@@ -0,0 +1,83 @@
+#include "hedged_reads_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct HedgedReadsRow {
+	string filesystem;
+	uint64_t request_count = 0;
+	uint64_t hedged_request_count = 0;
+	uint64_t hedge_win_count = 0;
+	uint64_t budget_exhausted_count = 0;
+};
+
+unique_ptr<FunctionData> ObservefsHedgedReadsQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                           vector<LogicalType> &return_types, vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        // Number of reads eligible for hedging, i.e. on buckets whose recent tail latency is known.
+	        {"requests", LogicalTypeId::UBIGINT},
+	        // Number of duplicate requests issued, and its ratio to eligible reads.
+	        {"hedged_requests", LogicalTypeId::UBIGINT},
+	        {"hedge_rate", LogicalTypeId::DOUBLE},
+	        // Number of reads served by the duplicate request.
+	        {"hedge_wins", LogicalTypeId::UBIGINT},
+	        // Number of slow reads not hedged since the budget is exhausted.
+	        {"budget_exhausted", LogicalTypeId::UBIGINT},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsHedgedReadsQueryFuncInit(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<HedgedReadsRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto &stats = cur_filesystem->GetHedgedReadStats();
+		HedgedReadsRow row;
+		row.request_count = stats.request_count.load(std::memory_order_relaxed);
+		// Skip filesystems without any read eligible for hedging.
+		if (row.request_count == 0) {
+			continue;
+		}
+		row.filesystem = cur_filesystem->GetName();
+		row.hedged_request_count = stats.hedged_request_count.load(std::memory_order_relaxed);
+		row.hedge_win_count = stats.hedge_win_count.load(std::memory_order_relaxed);
+		row.budget_exhausted_count = stats.budget_exhausted_count.load(std::memory_order_relaxed);
+		result->rows.emplace_back(std::move(row));
+	}
+	return std::move(result);
+}
+
+void EmitHedgedReadsRow(const HedgedReadsRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetColumnValue<uint64_t>(output.data[1], row_idx, row.request_count);
+	SetColumnValue<uint64_t>(output.data[2], row_idx, row.hedged_request_count);
+	SetColumnValue<double>(output.data[3], row_idx,
+	                       static_cast<double>(row.hedged_request_count) / static_cast<double>(row.request_count));
+	SetColumnValue<uint64_t>(output.data[4], row_idx, row.hedge_win_count);
+	SetColumnValue<uint64_t>(output.data[5], row_idx, row.budget_exhausted_count);
+}
+
+} // namespace
+
+TableFunction ObservefsHedgedReadsQueryFunc() {
+	TableFunction hedged_reads_query_func {/*name=*/"observefs_hedged_reads",
+	                                       /*arguments=*/ {},
+	                                       /*function=*/EmitMaterializedRows<HedgedReadsRow, EmitHedgedReadsRow>,
+	                                       /*bind=*/ObservefsHedgedReadsQueryFuncBind,
+	                                       /*init_global=*/ObservefsHedgedReadsQueryFuncInit};
+	return hedged_reads_query_func;
+}
+
+} // namespace duckdb
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "duckdb/common/assert.hpp"
 #include "duckdb/common/helper.hpp"
@@ -10,10 +11,13 @@
 
 namespace duckdb {
 
-Histogram::Histogram(double min_val, double max_val, int num_bkt)
-    : min_val_(min_val), max_val_(max_val), num_bkt_(num_bkt) {
-	D_ASSERT(min_val_ < max_val_);
-	D_ASSERT(num_bkt > 0);
+constexpr idx_t Histogram::DEFAULT_SUB_BUCKET_BITS;
+constexpr int Histogram::MIN_EXPONENT;
+constexpr int Histogram::MAX_EXPONENT;
+
+Histogram::Histogram(idx_t sub_bucket_bits)
+    : sub_bucket_bits_(sub_bucket_bits), sub_bucket_count_(static_cast<idx_t>(1) << sub_bucket_bits),
+      hist_(1 + static_cast<idx_t>(MAX_EXPONENT - MIN_EXPONENT) * sub_bucket_count_, 0) {
 	Reset();
 }
 
@@ -23,30 +27,50 @@ void Histogram::SetStatsDistribution(string name, string unit) {
 }
 
 void Histogram::Reset() {
-	min_encountered_ = max_val_;
-	max_encountered_ = min_val_;
+	min_encountered_ = std::numeric_limits<double>::max();
+	max_encountered_ = std::numeric_limits<double>::lowest();
 	total_counts_ = 0;
 	sum_ = 0;
-	hist_ = std::vector<size_t>(num_bkt_, 0);
-	outliers_.clear();
+	std::fill(hist_.begin(), hist_.end(), 0);
 }
 
-size_t Histogram::Bucket(double val) const {
-	D_ASSERT(val >= min_val_);
-	D_ASSERT(val < max_val_);
+idx_t Histogram::Bucket(double val) const {
+	// The first bucket holds all values below the smallest power-of-two range, including zero.
+	if (!(val >= std::ldexp(1.0, MIN_EXPONENT))) {
+		return 0;
+	}
 
-	if (val == max_val_) {
-		return hist_.size() - 1;
+	// [val] = mantissa * 2^exponent, where mantissa is within [0.5, 1).
+	int exponent = 0;
+	const double mantissa = std::frexp(val, &exponent);
+	const int power = exponent - 1;
+	if (power >= MAX_EXPONENT) {
+		return 1 + static_cast<idx_t>(MAX_EXPONENT - MIN_EXPONENT) * sub_bucket_count_ - 1;
 	}
-	const double idx = (val - min_val_) / (max_val_ - min_val_);
-	return static_cast<size_t>(std::floor(idx * hist_.size()));
+	const auto sub_bucket = static_cast<idx_t>((mantissa * 2.0 - 1.0) * sub_bucket_count_);
+	return 1 + static_cast<idx_t>(power - MIN_EXPONENT) * sub_bucket_count_ + sub_bucket;
 }
 
-void Histogram::Add(double val) {
-	if (val < min_val_ || val >= max_val_) {
-		outliers_.emplace_back(val);
-		return;
+double Histogram::BucketLowerBound(idx_t bucket_idx) const {
+	if (bucket_idx == 0) {
+		return 0.0;
 	}
+	const int power = static_cast<int>((bucket_idx - 1) >> sub_bucket_bits_) + MIN_EXPONENT;
+	const idx_t sub_bucket = (bucket_idx - 1) & (sub_bucket_count_ - 1);
+	return std::ldexp(1.0 + static_cast<double>(sub_bucket) / sub_bucket_count_, power);
+}
+
+double Histogram::BucketUpperBound(idx_t bucket_idx) const {
+	if (bucket_idx == 0) {
+		return std::ldexp(1.0, MIN_EXPONENT);
+	}
+	const int power = static_cast<int>((bucket_idx - 1) >> sub_bucket_bits_) + MIN_EXPONENT;
+	const idx_t sub_bucket = (bucket_idx - 1) & (sub_bucket_count_ - 1);
+	return std::ldexp(1.0 + static_cast<double>(sub_bucket + 1) / sub_bucket_count_, power);
+}
+
+void Histogram::Add(double val) {
+	val = std::max(val, 0.0);
 	++hist_[Bucket(val)];
 	min_encountered_ = std::min(min_encountered_, val);
 	max_encountered_ = std::max(max_encountered_, val);
@@ -54,6 +78,41 @@ void Histogram::Add(double val) {
 	sum_ += val;
 }
 
+void Histogram::Merge(const Histogram &other) {
+	D_ASSERT(sub_bucket_bits_ == other.sub_bucket_bits_);
+	if (other.total_counts_ == 0) {
+		return;
+	}
+	for (idx_t idx = 0; idx < hist_.size(); ++idx) {
+		hist_[idx] += other.hist_[idx];
+	}
+	min_encountered_ = std::min(min_encountered_, other.min_encountered_);
+	max_encountered_ = std::max(max_encountered_, other.max_encountered_);
+	total_counts_ += other.total_counts_;
+	sum_ += other.sum_;
+}
+
+void Histogram::Subtract(const Histogram &earlier) {
+	D_ASSERT(sub_bucket_bits_ == earlier.sub_bucket_bits_);
+	D_ASSERT(earlier.total_counts_ <= total_counts_);
+	for (idx_t idx = 0; idx < hist_.size(); ++idx) {
+		D_ASSERT(earlier.hist_[idx] <= hist_[idx]);
+		hist_[idx] -= earlier.hist_[idx];
+	}
+	total_counts_ -= earlier.total_counts_;
+	sum_ -= earlier.sum_;
+
+	min_encountered_ = std::numeric_limits<double>::max();
+	max_encountered_ = std::numeric_limits<double>::lowest();
+	for (idx_t idx = 0; idx < hist_.size(); ++idx) {
+		if (hist_[idx] == 0) {
+			continue;
+		}
+		min_encountered_ = std::min(min_encountered_, BucketLowerBound(idx));
+		max_encountered_ = std::max(max_encountered_, BucketUpperBound(idx));
+	}
+}
+
 double Histogram::mean() const {
 	if (total_counts_ == 0) {
 		return 0.0;
@@ -61,17 +120,36 @@ double Histogram::mean() const {
 	return sum_ / total_counts_;
 }
 
-string Histogram::FormatString() const {
-	string res;
+double Histogram::Quantile(double q) const {
+	D_ASSERT(total_counts_ > 0);
+	if (q <= 0.0) {
+		return min_encountered_;
+	}
+	if (q >= 1.0) {
+		return max_encountered_;
+	}
+	const double target_rank = q * (total_counts_ - 1);
 
-	// Format outliers.
-	if (!outliers_.empty()) {
-		auto double_to_string = [](double v) -> string {
-			return StringUtil::Format("%lf", v);
-		};
-		res = StringUtil::Format("Outliers %s with unit %s: %s\n", distribution_name_, distribution_unit_,
-		                         StringUtil::Join(outliers_, outliers_.size(), ", ", double_to_string));
+	double cumulative_count = 0;
+	for (idx_t idx = 0; idx < hist_.size(); ++idx) {
+		if (hist_[idx] == 0) {
+			continue;
+		}
+		if (cumulative_count + hist_[idx] > target_rank) {
+			// Interpolate linearly inside of the bucket, and clamp to values actually encountered.
+			const double fraction = (target_rank - cumulative_count + 0.5) / hist_[idx];
+			const double lower_bound = BucketLowerBound(idx);
+			const double upper_bound = BucketUpperBound(idx);
+			const double estimate = lower_bound + (upper_bound - lower_bound) * fraction;
+			return std::min(std::max(estimate, min_encountered_), max_encountered_);
+		}
+		cumulative_count += hist_[idx];
 	}
+	return max_encountered_;
+}
+
+string Histogram::FormatString() const {
+	string res;
 
 	// Format aggregated stats.
 	res += StringUtil::Format("Max %s = %lf %s\n", distribution_name_, max(), distribution_unit_);
@@ -80,17 +158,14 @@ string Histogram::FormatString() const {
 	res += StringUtil::Format("Count = %d\n", counts());
 
 	// Format stats distribution.
-	const double interval = (max_val_ - min_val_) / num_bkt_;
-	for (size_t idx = 0; idx < hist_.size(); ++idx) {
+	for (idx_t idx = 0; idx < hist_.size(); ++idx) {
 		// Skip empty bucket.
 		if (hist_[idx] == 0) {
 			continue;
 		}
-		const double cur_min_val = min_val_ + interval * idx;
-		const double cur_max_val = MinValue<double>(cur_min_val + interval, max_val_);
 		const double percentage = hist_[idx] * 1.0 / total_counts_ * 100;
-		res += StringUtil::Format("Distribution %s [%lf, %lf) %s: %lf %%\n", distribution_name_, cur_min_val,
-		                          cur_max_val, distribution_unit_, percentage);
+		res += StringUtil::Format("Distribution %s [%lf, %lf) %s: %lf %%\n", distribution_name_,
+		                          BucketLowerBound(idx), BucketUpperBound(idx), distribution_unit_, percentage);
 	}
 
 	return res;
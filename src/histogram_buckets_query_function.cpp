@@ -0,0 +1,118 @@
+#include "histogram_buckets_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "io_operation.hpp"
+#include "metrics_collector.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Histogram metrics names.
+constexpr const char *LATENCY_METRIC = "latency";
+constexpr const char *REQUEST_SIZE_METRIC = "request_size";
+
+struct HistogramBucketRow {
+	string filesystem;
+	// Empty for overall stats of the filesystem.
+	string bucket;
+	IoOperation io_oper = IoOperation::kUnknown;
+	const char *metric = nullptr;
+	double lower_bound = 0.0;
+	double upper_bound = 0.0;
+	uint64_t count = 0;
+};
+
+// Append one row for each non-empty bucket of the given histogram.
+void AppendHistogramBucketRows(const string &filesystem, const string &bucket, IoOperation io_oper,
+                               const char *metric, const Histogram &histogram, vector<HistogramBucketRow> &rows) {
+	for (idx_t bucket_idx = 0; bucket_idx < histogram.BucketCount(); ++bucket_idx) {
+		const auto bucket_count = histogram.BucketRecordCount(bucket_idx);
+		if (bucket_count == 0) {
+			continue;
+		}
+		HistogramBucketRow row;
+		row.filesystem = filesystem;
+		row.bucket = bucket;
+		row.io_oper = io_oper;
+		row.metric = metric;
+		row.lower_bound = histogram.BucketLowerBound(bucket_idx);
+		row.upper_bound = histogram.BucketUpperBound(bucket_idx);
+		row.count = bucket_count;
+		rows.emplace_back(std::move(row));
+	}
+}
+
+void AppendHistogramBucketRows(const string &filesystem, const string &bucket, const OperationStats &stats,
+                               vector<HistogramBucketRow> &rows) {
+	for (idx_t cur_oper_idx = 0; cur_oper_idx < kIoOperationCount; ++cur_oper_idx) {
+		const auto io_oper = static_cast<IoOperation>(cur_oper_idx);
+		AppendHistogramBucketRows(filesystem, bucket, io_oper, LATENCY_METRIC,
+		                          stats.latency_collector->GetHistogram(io_oper), rows);
+		AppendHistogramBucketRows(filesystem, bucket, io_oper, REQUEST_SIZE_METRIC,
+		                          stats.size_collector->GetHistogram(io_oper), rows);
+	}
+}
+
+unique_ptr<FunctionData> ObservefsHistogramBucketsQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                                vector<LogicalType> &return_types,
+                                                                vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        // NULL for overall stats of the filesystem.
+	        {"bucket", LogicalTypeId::VARCHAR},
+	        {"operation", LogicalTypeId::VARCHAR},
+	        // Either "latency" in microseconds, or "request_size" in bytes.
+	        {"metric", LogicalTypeId::VARCHAR},
+	        // Inclusive lower bound and exclusive upper bound of the histogram bucket.
+	        {"lower_bound", LogicalTypeId::DOUBLE},
+	        {"upper_bound", LogicalTypeId::DOUBLE},
+	        {"count", LogicalTypeId::UBIGINT},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsHistogramBucketsQueryFuncInit(ClientContext &context,
+                                                                            TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<HistogramBucketRow>>();
+	const auto snapshots = GetAllMetricsSnapshots(context);
+	for (const auto &cur_snapshot : snapshots) {
+		const auto &filesystem = cur_snapshot.first;
+		AppendHistogramBucketRows(filesystem, /*bucket=*/"", cur_snapshot.second.overall_stats, result->rows);
+		for (const auto &bucket_and_stats : cur_snapshot.second.bucket_stats) {
+			AppendHistogramBucketRows(filesystem, bucket_and_stats.first, *bucket_and_stats.second, result->rows);
+		}
+	}
+	return std::move(result);
+}
+
+void EmitHistogramBucketRow(const HistogramBucketRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetStringColumnValueOrNull(output.data[1], row_idx, row.bucket);
+	SetStringColumnValue(output.data[2], row_idx, OPER_NAMES[static_cast<idx_t>(row.io_oper)]);
+	SetStringColumnValue(output.data[3], row_idx, row.metric);
+	SetColumnValue<double>(output.data[4], row_idx, row.lower_bound);
+	SetColumnValue<double>(output.data[5], row_idx, row.upper_bound);
+	SetColumnValue<uint64_t>(output.data[6], row_idx, row.count);
+}
+
+} // namespace
+
+TableFunction ObservefsHistogramBucketsQueryFunc() {
+	TableFunction histogram_buckets_query_func {
+	    /*name=*/"observefs_histogram_buckets",
+	    /*arguments=*/ {},
+	    /*function=*/EmitMaterializedRows<HistogramBucketRow, EmitHistogramBucketRow>,
+	    /*bind=*/ObservefsHistogramBucketsQueryFuncBind,
+	    /*init_global=*/ObservefsHistogramBucketsQueryFuncInit};
+	return histogram_buckets_query_func;
+}
+
+} // namespace duckdb
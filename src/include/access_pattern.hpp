@@ -0,0 +1,129 @@
+// Access pattern detection for reads on file handles, which classifies read streams as sequential, strided or random,
+// and estimates how much readahead would have reduced the number of requests.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "histogram.hpp"
+
+namespace duckdb {
+
+// Kinds of transition between two consecutive reads.
+enum class AccessPattern {
+	// The read starts where the previous read ends.
+	kSequential = 0,
+	// The read skips the same non-zero gap as the previous transition, e.g. reading one column chunk per row group.
+	kStrided = 1,
+	kRandom = 2,
+	kUnknown = 3,
+};
+
+constexpr size_t kAccessPatternCount = static_cast<size_t>(AccessPattern::kUnknown);
+
+// Access pattern names, indexed by access pattern enums.
+extern const std::array<const char *, kAccessPatternCount> ACCESS_PATTERN_NAMES;
+
+// Get name for the given access pattern, including [`kUnknown`].
+const char *GetAccessPatternName(AccessPattern access_pattern);
+
+// Tracks transitions between consecutive reads on one file handle.
+//
+// It's thread-safe, although the pattern is only meaningful when reads are issued in order.
+class AccessPatternTracker {
+public:
+	AccessPatternTracker();
+
+	// Record a read of [nr_bytes] starting at [location].
+	void RecordRead(idx_t location, int64_t nr_bytes);
+
+	// Get the most common kind of transition, or [`kUnknown`] if there're less than two reads.
+	AccessPattern Classify() const;
+
+private:
+	friend class AccessPatternStats;
+
+	mutable std::mutex mu;
+	uint64_t read_count = 0;
+	// Offset where the previous read ends.
+	idx_t prev_end_offset = 0;
+	// Gap in bytes skipped by the previous transition, negative for backward seeks.
+	int64_t prev_gap = 0;
+	std::array<uint64_t, kAccessPatternCount> transition_counts {};
+	// Absolute gaps in bytes for non-sequential transitions.
+	Histogram gap_histogram;
+	// For forward transitions, distance in bytes from the previous read's end to the current read's end, which is the
+	// readahead size needed to serve the current read from the previous request.
+	Histogram readahead_distance_histogram;
+};
+
+// Aggregated access pattern stats over closed file handles.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+class AccessPatternStats {
+public:
+	AccessPatternStats();
+
+	// Record stats of a closed file handle.
+	void RecordHandleClose(const AccessPatternTracker &tracker);
+	// Merge all records from [other] into the current stats.
+	void Merge(const AccessPatternStats &other);
+
+	// Get the most common kind of transition over all handles, or [`kUnknown`] if there's no transition.
+	AccessPattern Classify() const;
+	// Get the ratio of the given kind of transition, within [0, 1].
+	double GetTransitionRatio(AccessPattern access_pattern) const;
+	// Get the suggested readahead size in bytes, which is a power of two covering 90% of forward transitions.
+	// Return 0 if less than half of transitions are forward, where readahead doesn't help.
+	uint64_t GetSuggestedReadaheadBytes() const;
+	// Get the number of requests which would have been served by the previous request, with [readahead_bytes] read
+	// ahead.
+	uint64_t GetAvoidableRequestCount(uint64_t readahead_bytes) const;
+
+	const Histogram &GetGapHistogram() const {
+		return *gap_histogram;
+	}
+
+	uint64_t handle_count = 0;
+	uint64_t read_count = 0;
+
+private:
+	uint64_t GetTransitionCount() const;
+
+	std::array<uint64_t, kAccessPatternCount> transition_counts {};
+	unique_ptr<Histogram> gap_histogram;
+	unique_ptr<Histogram> readahead_distance_histogram;
+};
+
+// Access pattern stats grouped by object storage bucket and file type.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+class AccessPatternCollector {
+public:
+	// Maps from (bucket, file type) to access pattern stats, either of which could be empty if unknown.
+	using StatsMap = map<std::pair<string, string>, unique_ptr<AccessPatternStats>>;
+
+	// Record stats of a closed file handle on [filepath].
+	void RecordHandleClose(const string &filepath, const AccessPatternTracker &tracker);
+	// Merge all records from [other] into the current collector.
+	void Merge(const AccessPatternCollector &other);
+	// Reset all records.
+	void Reset();
+
+	const StatsMap &GetAllStats() const {
+		return stats;
+	}
+
+private:
+	StatsMap stats;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get read access patterns and readahead suggestions, one row per filesystem, bucket and file type.
+TableFunction ObservefsAccessPatternsQueryFunc();
+
+} // namespace duckdb
@@ -0,0 +1,44 @@
+// BucketInterner assigns a dense id to each distinct bucket name, so IO path could index per-bucket states by id
+// instead of hashing and copying the name on each operation.
+//
+// It's NOT thread-safe.
+
+#pragma once
+
+#include <cstdint>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "string_utils.hpp"
+
+namespace duckdb {
+
+class BucketInterner {
+public:
+	BucketInterner() = default;
+	~BucketInterner() = default;
+
+	// Get the id for [bucket], which is interned at first sight.
+	// Heap allocation only happens when a bucket is interned for the first time.
+	idx_t GetOrIntern(const StringSlice &bucket);
+
+	// Get bucket name for the given [id].
+	const string &GetBucket(idx_t id) const {
+		return buckets[id];
+	}
+
+	// Get number of interned buckets, ids are within [0, size).
+	idx_t Size() const {
+		return buckets.size();
+	}
+
+private:
+	// Interned bucket names, indexed by id.
+	vector<string> buckets;
+	// Maps from bucket name hash to ids of all buckets with the hash value.
+	unordered_map<uint64_t, vector<idx_t>> hash_to_ids;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get predicted block cache hit ratios over recorded reads, one row per filesystem and simulated cache size.
+TableFunction ObservefsCacheMrcQueryFunc();
+
+} // namespace duckdb
@@ -0,0 +1,109 @@
+// Simulates LRU block caches of various sizes over the recorded read stream, which produces a miss ratio curve, i.e.,
+// predicted hit ratio for each cache size.
+//
+// Reuse distances are estimated with SHARDS (spatially hashed sampling): a block is only tracked if the hash of its
+// identity falls below a threshold, so each block is either always or never sampled, and distances between sampled
+// references are scaled by the sample rate. The number of tracked blocks is bounded; when exceeded, the block with the
+// largest hash is evicted and the threshold is lowered to its hash, which adapts sample rate to the working set.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Predicted hit ratio of an LRU cache with the given size.
+struct CacheMissRatioPoint {
+	uint64_t cache_size_bytes = 0;
+	double hit_ratio = 0.0;
+};
+
+struct CacheMissRatioCurve {
+	uint64_t block_size = 0;
+	// Number of block references sampled.
+	uint64_t sampled_access_count = 0;
+	// Current fraction of blocks sampled, within (0, 1].
+	double sample_rate = 1.0;
+	// Ordered by cache size ascendingly.
+	vector<CacheMissRatioPoint> points;
+};
+
+// It's thread-safe.
+class CacheMrcSimulator {
+public:
+	// Max number of blocks tracked, which bounds memory footprint.
+	static constexpr idx_t MAX_SAMPLED_BLOCK_COUNT = 16 * 1024;
+	static constexpr idx_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+	// Simulated cache sizes are 64MiB, 256MiB, 1GiB, ..., 64GiB.
+	static constexpr idx_t CACHE_SIZE_COUNT = 6;
+	static constexpr uint64_t MIN_CACHE_SIZE = 64ULL * 1024 * 1024;
+	static constexpr uint64_t CACHE_SIZE_GROWTH_FACTOR = 4;
+
+	CacheMrcSimulator();
+
+	CacheMrcSimulator(const CacheMrcSimulator &) = delete;
+	CacheMrcSimulator &operator=(const CacheMrcSimulator &) = delete;
+
+	// Enable or disable simulation, which is disabled by default.
+	void SetEnabled(bool enabled_p) {
+		enabled.store(enabled_p, std::memory_order_relaxed);
+	}
+	bool IsEnabled() const {
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	// Set cache block size, which resets all recorded references if changed.
+	// Precondition: [block_size_p] is positive.
+	void SetBlockSize(idx_t block_size_p);
+
+	// Record a read of [nr_bytes] starting at [location], which references every block it overlaps with.
+	void RecordRead(const string &path, idx_t location, idx_t nr_bytes);
+
+	CacheMissRatioCurve GetMissRatioCurve();
+
+	// Reset all recorded references.
+	void Reset();
+
+private:
+	// Capacity of the logical clock, after which timestamps are compacted.
+	static constexpr idx_t TIMESTAMP_CAPACITY = 4 * MAX_SAMPLED_BLOCK_COUNT;
+
+	// Reset all recorded references.
+	// Precondition: [mu] is held.
+	void ResetWithLock();
+	// Record a reference to the block with the given hash.
+	// Precondition: [mu] is held.
+	void RecordBlockWithLock(uint64_t block_hash);
+	// Renumber timestamps of tracked blocks from 0, keeping their order.
+	// Precondition: [mu] is held.
+	void CompactTimestampsWithLock();
+
+	// Fenwick tree over logical timestamps, where a timestamp is set iff it's the last access of a tracked block.
+	void UpdateTimestamp(idx_t timestamp, int32_t delta);
+	// Number of set timestamps within [0, timestamp).
+	idx_t CountTimestampsBefore(idx_t timestamp) const;
+
+	std::atomic<bool> enabled {false};
+
+	std::mutex mu;
+	idx_t block_size = DEFAULT_BLOCK_SIZE;
+	// Blocks are sampled iff their hash is less than the threshold.
+	uint64_t sample_threshold = UINT64_MAX;
+	// Maps from block hash to its last access timestamp, ordered by hash so the largest is evicted first.
+	map<uint64_t, idx_t> block_timestamps;
+	vector<int32_t> timestamp_tree;
+	idx_t next_timestamp = 0;
+	uint64_t sampled_access_count = 0;
+	// Number of sampled references which hit for each simulated cache size.
+	std::array<uint64_t, CACHE_SIZE_COUNT> hit_counts;
+};
+
+} // namespace duckdb
@@ -0,0 +1,36 @@
+// Index over byte ranges cached by external file cache, which answers how many bytes of a read are cached.
+
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Cached ranges are kept sorted and merged per path, so a lookup is a binary search within the file's ranges.
+//
+// It's immutable after [`Finalize`], thus safe to be shared by multiple readers without synchronization.
+class CachedRangeIndex {
+public:
+	// Add a cached range of [nr_bytes] starting at [location] for [path].
+	// Precondition: [`Finalize`] hasn't been called.
+	void AddRange(const string &path, idx_t location, idx_t nr_bytes);
+
+	// Sort and merge overlapping or adjacent ranges, after which the index is ready for lookup.
+	void Finalize();
+
+	// Get number of bytes cached within the requested range, which could be covered by multiple cached ranges.
+	idx_t GetCachedBytes(const string &path, idx_t location, idx_t nr_bytes) const;
+
+private:
+	struct CachedRange {
+		idx_t start = 0;
+		idx_t end = 0;
+	};
+
+	unordered_map<string, vector<CachedRange>> path_to_ranges;
+};
+
+} // namespace duckdb
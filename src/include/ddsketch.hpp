@@ -0,0 +1,73 @@
+// DDSketch is a quantile sketch with relative-error guarantee, see https://arxiv.org/abs/1908.10693
+//
+// Positive values are mapped into logarithmic buckets, so any quantile could be answered with a relative error of at
+// most [`relative_accuracy`], and two sketches with the same accuracy merge losslessly by adding up bucket counts.
+// Bucket counts are stored in a dense array which grows lazily towards both ends; when the number of buckets exceeds
+// [`MAX_BUCKET_COUNT`], the lowest buckets are collapsed, which only affects the accuracy of the lowest quantiles.
+//
+// It's NOT thread-safe.
+
+#pragma once
+
+#include <cstdint>
+
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+class DDSketch {
+public:
+	// Default relative accuracy for quantile estimation.
+	static constexpr double DEFAULT_RELATIVE_ACCURACY = 0.01;
+	// Max number of buckets stored, which bounds memory footprint.
+	static constexpr idx_t MAX_BUCKET_COUNT = 2048;
+
+	explicit DDSketch(double relative_accuracy = DEFAULT_RELATIVE_ACCURACY);
+
+	// Add [val] into the sketch, non-positive values are recorded as zero.
+	void Add(double val);
+
+	// Merge all records from [other] into the current sketch.
+	// Precondition: both sketches have the same relative accuracy.
+	void Merge(const DDSketch &other);
+
+	// Get the estimated value at quantile [q], which is within [0, 1].
+	// Return 0 if there's no value inserted.
+	double Quantile(double q) const;
+
+	uint64_t Count() const {
+		return total_count;
+	}
+
+	// Clear all records, bucket storage is kept to avoid re-allocation.
+	void Reset();
+
+private:
+	// Get the bucket key for the given positive value.
+	int32_t Key(double val) const;
+	// Get the representative value for the given bucket key.
+	double Value(int32_t key) const;
+	// Make sure the bucket array covers the given key, and return its index.
+	idx_t GetOrExtendBucket(int32_t key);
+
+	const double relative_accuracy;
+	// gamma = (1 + relative_accuracy) / (1 - relative_accuracy).
+	const double gamma;
+	const double log_gamma;
+	// Values smaller than this are recorded as zero.
+	const double min_indexable_value;
+
+	// Number of values recorded as zero.
+	uint64_t zero_count = 0;
+	// Bucket counts, where buckets[idx] holds values for key [`key_offset`] + idx.
+	vector<uint64_t> buckets;
+	int32_t key_offset = 0;
+	// Total number of values.
+	uint64_t total_count = 0;
+	// Max and min value encountered.
+	double min_value = 0.0;
+	double max_value = 0.0;
+};
+
+} // namespace duckdb
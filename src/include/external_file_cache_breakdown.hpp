@@ -0,0 +1,108 @@
+// Breakdown of external file cache access by object storage bucket and by file path.
+
+#pragma once
+
+#include <array>
+
+#include "bucket_interner.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "space_saving_sketch.hpp"
+
+namespace duckdb {
+
+// Number of buckets for partial hit coverage distribution, each covers an equal share of coverage ratio, i.e., (0%,
+// 25%], (25%, 50%], (50%, 75%] and (75%, 100%).
+constexpr idx_t PARTIAL_HIT_COVERAGE_BUCKET_COUNT = 4;
+
+// Get the coverage bucket for a partial hit, where [cached_bytes] of [requested_bytes] are covered by cache.
+// Precondition: 0 < [cached_bytes] < [requested_bytes].
+inline idx_t GetPartialHitCoverageBucket(idx_t requested_bytes, idx_t cached_bytes) {
+	return (cached_bytes * PARTIAL_HIT_COVERAGE_BUCKET_COUNT - 1) / requested_bytes;
+}
+
+struct CacheAccessRecord {
+	// Record an access of [requested_bytes], of which [cached_bytes] are covered by cache.
+	void RecordAccess(idx_t requested_bytes, idx_t cached_bytes);
+	// Merge all records from [other] into the current record.
+	void Merge(const CacheAccessRecord &other);
+	// Get number of all accesses, including hits, misses and partial hits.
+	idx_t GetAccessCount() const {
+		return hit_count + miss_count + partial_hit_count;
+	}
+
+	// Number of complete cache hits.
+	idx_t hit_count = 0;
+	// Number of complete cache misses.
+	idx_t miss_count = 0;
+	// Number of partial cache hits.
+	idx_t partial_hit_count = 0;
+	// Number of requested bytes covered by cached ranges, including those of partial hits.
+	idx_t hit_bytes = 0;
+	// Number of requested bytes not covered by any cached range.
+	idx_t miss_bytes = 0;
+	// Number of partial cache hits, bucketed by the ratio of requested bytes covered.
+	std::array<idx_t, PARTIAL_HIT_COVERAGE_BUCKET_COUNT> partial_hit_coverage_counts {};
+};
+
+// Cache access record for one bucket or file path.
+struct NamedCacheAccessRecord {
+	string name;
+	CacheAccessRecord record;
+};
+
+// Cache access record for one file path tracked by [`SpaceSavingSketch`].
+struct PathCacheAccessRecord {
+	// Record an access of [requested_bytes], of which [cached_bytes] are covered by cache.
+	void RecordAccess(idx_t requested_bytes, idx_t cached_bytes);
+	// Merge all records from [other] into the current record, which belong to the same path.
+	void Merge(const PathCacheAccessRecord &other);
+	// Clear the record, which is only accumulated since the path is tracked.
+	void ResetTrackedStats();
+
+	string path;
+	// Estimated access count, which never underestimates the actual count.
+	uint64_t request_count = 0;
+	// Max overestimation of [request_count], inherited from the evicted path.
+	uint64_t request_count_error = 0;
+	CacheAccessRecord record;
+};
+
+// Cache access records for each object storage bucket, and a space-saving sketch of most accessed paths, so paths
+// accessed frequently stay tracked while a long tail of paths doesn't grow memory.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+class ExternalFileCacheBreakdown {
+public:
+	// Max number of paths tracked.
+	static constexpr idx_t PATH_CAPACITY = SpaceSavingSketch<PathCacheAccessRecord>::CAPACITY;
+
+	// Record an access of [requested_bytes] on [filepath], of which [cached_bytes] are covered by cache.
+	void RecordAccess(const string &filepath, idx_t requested_bytes, idx_t cached_bytes);
+
+	// Get records for all accessed buckets, entries without any access should be skipped.
+	vector<NamedCacheAccessRecord> GetBucketRecords() const;
+
+	// Get records for all tracked paths, entries without any access should be skipped.
+	const vector<unique_ptr<PathCacheAccessRecord>> &GetPathRecords() const {
+		return path_sketch.GetAllEntries();
+	}
+
+	// Get the max access count of any untracked path, see [`SpaceSavingSketch::GetMinRequestCount`].
+	uint64_t GetMinPathAccessCount() const {
+		return path_sketch.GetMinRequestCount();
+	}
+
+	// Reset all records in place.
+	void Reset();
+
+private:
+	BucketInterner bucket_interner;
+	// Indexed by interned bucket id.
+	vector<CacheAccessRecord> bucket_records;
+	SpaceSavingSketch<PathCacheAccessRecord> path_sketch;
+};
+
+} // namespace duckdb
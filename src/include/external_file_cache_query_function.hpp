@@ -7,4 +7,7 @@ namespace duckdb {
 // Table function to get external file cache access records.
 TableFunction ExternalFileCacheAccessQueryFunc();
 
+// Table function to get external file cache access records for each bucket and the k most accessed paths.
+TableFunction ExternalFileCacheBreakdownQueryFunc();
+
 } // namespace duckdb
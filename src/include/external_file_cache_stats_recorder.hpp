@@ -4,31 +4,44 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 
+#include "cached_range_index.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/typedefs.hpp"
 #include "duckdb/common/vector.hpp"
-#include "duckdb/storage/buffer/temporary_file_information.hpp"
+#include "external_file_cache_breakdown.hpp"
+#include "thread_sharded_state.hpp"
 
 namespace duckdb {
 
 // Forward declaration.
 class ExternalFileCache;
 
-struct CacheAccessRecord {
-	// Number of complete cache hits.
-	idx_t hit_count = 0;
-	// Number of complete cache misses.
-	idx_t miss_count = 0;
-	// Number of partial cache hits.
-	idx_t partial_hit_count = 0;
+// Cache access breakdown merged from all shards.
+struct CacheAccessBreakdown {
+	// Ordered by bucket name.
+	vector<NamedCacheAccessRecord> bucket_records;
+	// Most accessed paths, ordered by estimated access count descendingly; cache access records only cover accesses
+	// since each path is tracked.
+	vector<PathCacheAccessRecord> path_records;
 };
 
+// One recorder is owned by each database instance, since each instance has its own external file cache.
+//
+// Reads are classified against an immutable snapshot of cached ranges, which is loaded and swapped atomically, so the
+// read path never blocks on, or pays for, snapshot refresh. Snapshot refresh is piggybacked on the read path at a
+// bounded interval, and skipped if another thread is refreshing.
 class ExternalFileCacheStatsRecorder {
 public:
+	// Min interval between two snapshot refreshes.
+	static constexpr int64_t SNAPSHOT_REFRESH_INTERVAL_MILLISEC = 100;
+
 	explicit ExternalFileCacheStatsRecorder(ExternalFileCache &external_file_cache_p)
-	    : external_file_cache(&external_file_cache_p) {
+	    : external_file_cache(external_file_cache_p) {
 	}
 
 	// Enable and disable stats record.
@@ -41,37 +54,35 @@ public:
 	// Get cache access records.
 	CacheAccessRecord GetCacheAccessRecord() const;
 
+	// Get cache access records for each bucket and the [k] most accessed paths.
+	CacheAccessBreakdown GetCacheAccessBreakdown(idx_t k);
+
 	// Clear cache access record.
 	void ClearCacheAccessRecord();
 
-	// Set external file cache, used to invoke at extension reload where database instance has changed.
-	// TODO(hjiang): Current approach only assumes single external file cache and only supports one dataabase instance.
-	void ResetExternalFileCache(ExternalFileCache &cache);
-
 private:
-	// Update cache access.
-	void UpdateCacheAccessRecordWithLock(const CachedFileInformation &cache_file_info);
-
-	// Load cache information from external file cache.
-	void UpdateExternalFileCacheWithLock();
-
-	ExternalFileCache *external_file_cache = nullptr;
-	// Currently cached blocks in external file cache.
-	vector<CachedFileInformation> cache_blocks;
-	// Used to decide whether stats recorder should load fresh cache information.
-	idx_t last_load_iteration = 0;
-	idx_t cur_load_iteration = 0;
+	// Reload cached ranges from external file cache if the refresh interval has elapsed.
+	void MaybeRefreshSnapshot();
+
+	// External file cache of the owning database instance.
+	ExternalFileCache &external_file_cache;
+	// Snapshot of cached ranges, only accessed via atomic load and store.
+	std::shared_ptr<const CachedRangeIndex> cached_ranges_snapshot;
+	// Timestamp in steady clock, before which snapshot is not refreshed.
+	std::atomic<int64_t> next_refresh_millisec {0};
+	// Held while refreshing snapshot, so only one thread copies cache information at a time.
+	std::mutex refresh_mu;
 	// Cache access record.
-	CacheAccessRecord cache_access_record;
+	std::atomic<idx_t> hit_count {0};
+	std::atomic<idx_t> miss_count {0};
+	std::atomic<idx_t> partial_hit_count {0};
+	std::atomic<idx_t> hit_bytes {0};
+	std::atomic<idx_t> miss_bytes {0};
+	std::array<std::atomic<idx_t>, PARTIAL_HIT_COVERAGE_BUCKET_COUNT> partial_hit_coverage_counts {};
+	// Per-bucket and per-path records, sharded by recording thread to avoid a global lock on the read path.
+	ThreadShardedState<ExternalFileCacheBreakdown> breakdown_shards;
 	// Whether stats record is enabled.
-	bool enabled = true;
-	mutable std::mutex mu;
+	std::atomic<bool> enabled {true};
 };
 
-// Get global stats recorder.
-ExternalFileCacheStatsRecorder &GetExternalFileCacheStatsRecorder();
-
-// Initialize or set stats recorder.
-void InitOrResetExternalFileCache(ExternalFileCache &cache);
-
 } // namespace duckdb
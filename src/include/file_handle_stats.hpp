@@ -0,0 +1,98 @@
+// Lifetime stats for file handles, which show how each opened file is used, e.g. whether a file is opened once and
+// streamed, or opened repeatedly for a few small reads.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "histogram.hpp"
+
+namespace duckdb {
+
+// Per-open metrics of a file handle.
+enum class FileHandleMetric {
+	kReadCount = 0,
+	kReadBytes = 1,
+	kSeekCount = 2,
+	// Percentage of reads which start where the previous read ends, or at file start for the first read.
+	kSequentialReadPercent = 3,
+	kOpenDuration = 4,
+	// Time spent blocked in IO operations issued on the handle.
+	kIoWait = 5,
+	kUnknown = 6,
+};
+
+constexpr size_t kFileHandleMetricCount = static_cast<size_t>(FileHandleMetric::kUnknown);
+
+// Metric names and units, indexed by metric enums.
+extern const std::array<const char *, kFileHandleMetricCount> FILE_HANDLE_METRIC_NAMES;
+extern const std::array<const char *, kFileHandleMetricCount> FILE_HANDLE_METRIC_UNITS;
+
+// Usage counters kept inline in one file handle.
+//
+// Counters are updated without locking, since a handle could be accessed by multiple threads; sequential read
+// detection is approximate under concurrent reads.
+class FileHandleCounters {
+public:
+	// [`open_timestamp_ns`] is measured by the configured latency clock, see [`GetLatencyClockNowNanoSec`].
+	explicit FileHandleCounters(int64_t open_timestamp_ns_p);
+
+	// Record a read of [nr_bytes] starting at [location].
+	void RecordRead(idx_t location, int64_t nr_bytes);
+	// Record an explicit seek.
+	void RecordSeek();
+	// Get the counter to accumulate IO wait time in nanoseconds into.
+	std::atomic<int64_t> &GetIoWaitCounter() {
+		return io_wait_ns;
+	}
+
+	// Get per-open metric values as of [close_timestamp_ns], indexed by metric enums.
+	std::array<double, kFileHandleMetricCount> GetMetrics(int64_t close_timestamp_ns) const;
+
+private:
+	const int64_t open_timestamp_ns;
+	std::atomic<uint64_t> read_count {0};
+	std::atomic<uint64_t> read_bytes {0};
+	std::atomic<uint64_t> sequential_read_count {0};
+	std::atomic<uint64_t> seek_count {0};
+	std::atomic<int64_t> io_wait_ns {0};
+	// Offset where the previous read ends, a read starting here is sequential.
+	std::atomic<idx_t> next_sequential_offset {0};
+};
+
+// Distributions of per-open metrics over all closed file handles.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+class FileHandleStatsCollector {
+public:
+	FileHandleStatsCollector();
+
+	// Record per-open metric values of a closed handle, indexed by metric enums.
+	void RecordHandleClose(const std::array<double, kFileHandleMetricCount> &metrics);
+
+	// Merge all records from [other] into the current collector.
+	void Merge(const FileHandleStatsCollector &other);
+
+	// Reset all records.
+	void Reset();
+
+	// Get the distribution for the given metric.
+	const Histogram &GetHistogram(FileHandleMetric metric) const {
+		return *metric_histograms[static_cast<idx_t>(metric)];
+	}
+
+	// Represent stats in human-readable format.
+	// Return empty string if no handle has been closed.
+	string GetHumanReadableStats() const;
+
+private:
+	std::array<unique_ptr<Histogram>, kFileHandleMetricCount> metric_histograms;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get distributions of per-open file handle stats, one row per filesystem and metric.
+TableFunction ObservefsHandleStatsQueryFunc();
+
+} // namespace duckdb
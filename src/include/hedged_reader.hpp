@@ -0,0 +1,208 @@
+// Hedged reader cuts tail latency of positional reads: when a read doesn't complete within the recent tail latency
+// (p95 by default) of its bucket, a duplicate request is issued, and whichever response arrives first wins. Duplicate
+// requests are capped by a budget, so a slow backend isn't flooded with extra load.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Hedged read stats for one filesystem, which are updated by all its handles.
+struct HedgedReadStats {
+	// Reset all stats.
+	void Reset();
+
+	// Number of reads eligible for hedging, i.e., reads on buckets whose tail latency is known.
+	std::atomic<uint64_t> request_count {0};
+	// Number of duplicate requests issued.
+	std::atomic<uint64_t> hedged_request_count {0};
+	// Number of reads served by the duplicate request, which completes before the original one.
+	std::atomic<uint64_t> hedge_win_count {0};
+	// Number of reads exceeding the latency threshold, but not hedged since the budget is exhausted.
+	std::atomic<uint64_t> budget_exhausted_count {0};
+};
+
+// Decides when a read is hedged and whether budget allows it, shared by all handles of one filesystem.
+//
+// It's thread-safe.
+class HedgedReadPolicy {
+public:
+	// Latency quantile of recent reads, after which a duplicate request is issued.
+	static constexpr double HEDGE_LATENCY_QUANTILE = 0.95;
+	// Window of recent reads to compute latency quantile over.
+	static constexpr int64_t LATENCY_WINDOW_SEC = 60;
+	// Min number of recent reads for the latency quantile to be trusted.
+	static constexpr uint64_t MIN_RECORD_COUNT = 100;
+	// Reads faster than it are never hedged, e.g. local files or cached objects, where duplicating costs more than it
+	// could save.
+	static constexpr int64_t MIN_HEDGE_DELAY_NS = 1000LL * 1000;
+	// Interval to recompute latency threshold for a bucket.
+	static constexpr int64_t THRESHOLD_REFRESH_INTERVAL_NS = 1000LL * 1000 * 1000;
+	// Max number of buckets to keep threshold for, all are dropped once exceeded.
+	static constexpr idx_t MAX_BUCKET_COUNT = 1024;
+	// Default max number of duplicate requests, in percentage of eligible reads.
+	static constexpr idx_t DEFAULT_BUDGET_PERCENT = 5;
+
+	// Compute the latency quantile in microseconds for [bucket], or return negative if there're not enough records.
+	using ComputeLatencyFunc = std::function<double(const string &bucket)>;
+
+	// Get latency threshold in nanoseconds for reads on [bucket], after which a duplicate request is issued; return
+	// negative if reads on the bucket shouldn't be hedged. Threshold is recomputed with [compute] at most once per
+	// refresh interval, while other threads keep using the stale one.
+	int64_t GetThresholdNs(const string &bucket, int64_t now_ns, const ComputeLatencyFunc &compute);
+
+	// Whether budget allows one more duplicate request, without taking it.
+	bool HasBudget(const HedgedReadStats &stats) const;
+	// Try to take budget for one duplicate request, which is counted into [stats] if granted.
+	bool TryAcquireBudget(HedgedReadStats &stats) const;
+	// Return budget taken for a duplicate request which can't be issued.
+	void ReleaseBudget(HedgedReadStats &stats) const;
+
+	// Set max number of duplicate requests, in percentage of eligible reads.
+	// Precondition: [percent] is within [0, 100].
+	void SetBudgetPercent(idx_t percent) {
+		budget_percent.store(percent, std::memory_order_relaxed);
+	}
+
+	// Drop all latency thresholds.
+	void Reset();
+
+private:
+	struct Threshold {
+		// Negative if reads shouldn't be hedged.
+		int64_t threshold_ns = -1;
+		int64_t refresh_timestamp_ns = 0;
+	};
+
+	std::atomic<idx_t> budget_percent {DEFAULT_BUDGET_PERCENT};
+	std::mutex mu;
+	// Maps from bucket name to its latency threshold, empty bucket for non object storage paths.
+	unordered_map<string, Threshold> thresholds;
+};
+
+// Runs hedged read requests on a bounded number of threads, which are started on demand and reused afterwards.
+//
+// Tasks are never queued: a task is only accepted if a thread is idle or one more could be started, so a saturated
+// executor never delays a read, and the caller runs the read by itself instead.
+//
+// It's thread-safe.
+class HedgedReadExecutor {
+public:
+	// Default max number of threads.
+	static constexpr idx_t DEFAULT_MAX_THREAD_COUNT = 16;
+
+	using Task = std::function<void()>;
+
+	explicit HedgedReadExecutor(idx_t max_thread_count_p = DEFAULT_MAX_THREAD_COUNT);
+	~HedgedReadExecutor();
+
+	HedgedReadExecutor(const HedgedReadExecutor &) = delete;
+	HedgedReadExecutor &operator=(const HedgedReadExecutor &) = delete;
+
+	// Run [task] on an idle thread, return false if all threads are busy and no more could be started.
+	// [task] should not throw.
+	bool TrySubmit(Task task);
+
+private:
+	void RunWorker();
+
+	const idx_t max_thread_count;
+	std::mutex mu;
+	std::condition_variable cv;
+	vector<std::thread> workers;
+	// Tasks accepted but not yet picked up, which never exceeds the number of idle threads.
+	vector<Task> pending_tasks;
+	idx_t idle_worker_count = 0;
+	bool stopped = false;
+};
+
+// Issues duplicate requests for slow reads on one file handle.
+//
+// Each request runs exclusively on one internal handle: the primary one, or a second one which is opened along with it,
+// so the two requests of a read never share a handle. The original and duplicate request are issued on
+// [`HedgedReadExecutor`] into the buffer of their handle, so the caller could return as soon as either completes, and
+// the response is copied to the caller's buffer. A blocking upstream read can't be interrupted, so a request run by
+// the caller thread itself couldn't be overtaken by its duplicate. Handle buffers are reused across reads, so a read
+// doesn't allocate once they grow to the read size. The losing request can't be cancelled and keeps running in
+// background with its handle held, so later reads go to the other handle, and aren't hedged if both are held.
+// Destructing the reader waits for all requests, so whatever they reference has to outlive the reader.
+//
+// Reads which can't be hedged, i.e. budget is exhausted or the executor is saturated, are issued by the caller thread
+// directly into its buffer.
+//
+// It's thread-safe.
+class HedgedReader {
+public:
+	// Number of internal handles, i.e. the primary one and the one for hedging.
+	static constexpr idx_t HANDLE_COUNT = 2;
+
+	// Read [nr_bytes] at [location] from upstream into [buffer] with the [handle_idx]-th internal handle.
+	using FetchFunc = std::function<void(idx_t handle_idx, char *buffer, idx_t nr_bytes, idx_t location)>;
+
+	HedgedReader() = default;
+	~HedgedReader();
+
+	HedgedReader(const HedgedReader &) = delete;
+	HedgedReader &operator=(const HedgedReader &) = delete;
+
+	// Read [nr_bytes] starting at [location] into [buffer] with [fetch]. If it doesn't complete within [threshold_ns]
+	// and [policy] grants budget, a duplicate request is issued on another handle, and the first successful response
+	// wins. Exception is rethrown only if all issued requests fail.
+	// Precondition: [threshold_ns] is non-negative.
+	void Read(char *buffer, idx_t nr_bytes, idx_t location, int64_t threshold_ns, const FetchFunc &fetch,
+	          const HedgedReadPolicy &policy, HedgedReadStats &stats, HedgedReadExecutor &executor);
+
+	// Read on the caller thread without hedging, with a handle not held by any request still running.
+	void ReadWithoutHedging(char *buffer, idx_t nr_bytes, idx_t location, const FetchFunc &fetch);
+
+	// Invoke [func] on the caller thread once no request is running on the primary handle, e.g. for reads which
+	// depend on file position.
+	void RunOnPrimaryHandle(const std::function<void()> &func);
+
+	// Whether any request has been issued on executor. If not, no request could be running in background, and the
+	// caller could use the primary handle directly.
+	bool HasIssuedRequest() const {
+		return has_issued_request.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct HedgedRequest;
+
+	// Wait until any handle is free and hold it, the primary handle is preferred.
+	idx_t AcquireHandle();
+	// Hold a free handle if any, return whether succeeds.
+	bool TryAcquireHandle(idx_t &handle_idx);
+	void ReleaseHandle(idx_t handle_idx);
+
+	// Read on the caller thread with the held [handle_idx]-th handle, which is released afterwards.
+	void ReadOnCallerThread(idx_t handle_idx, char *buffer, idx_t nr_bytes, idx_t location, const FetchFunc &fetch);
+
+	// Issue the [request_idx]-th request of [request] on [executor] with the held [handle_idx]-th handle into the
+	// handle's buffer. The handle is released when the request fails or loses, and kept held for the caller to copy
+	// the response if it wins. Return false if it can't be issued, in which case the handle is released.
+	bool IssueRequest(const shared_ptr<HedgedRequest> &request, idx_t request_idx, idx_t handle_idx,
+	                  const FetchFunc &fetch, HedgedReadExecutor &executor);
+
+	std::mutex mu;
+	std::condition_variable cv;
+	// Whether each handle is held, either by a running request or the caller thread.
+	std::array<bool, HANDLE_COUNT> handle_held {};
+	// Response buffer for each handle, only accessed by whoever holds the handle.
+	std::array<vector<char>, HANDLE_COUNT> handle_buffers;
+	std::atomic<bool> has_issued_request {false};
+};
+
+} // namespace duckdb
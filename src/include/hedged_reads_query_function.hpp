@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get hedged read stats, one row per filesystem with reads eligible for hedging.
+TableFunction ObservefsHedgedReadsQueryFunc();
+
+} // namespace duckdb
@@ -1,21 +1,35 @@
+// Log-linear (HDR-style) histogram, which provides bounded relative error with bounded memory.
+//
+// Each power-of-two range [2^k, 2^(k+1)) is split into 2^sub_bucket_bits linear sub-buckets, so the width of a bucket
+// is at most 1/2^sub_bucket_bits of its lower bound. Values below 2^MIN_EXPONENT share the first bucket, and values
+// above 2^MAX_EXPONENT are clamped into the last bucket; for latency in microseconds it covers nanoseconds through
+// years, and for request size it covers bytes through terabytes.
+//
+// Bucket counts for the whole range are allocated at construction, so recording a value never allocates. Count, sum,
+// min and max are tracked exactly.
+//
+// It's NOT thread-safe.
+
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 #include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
 #include "duckdb/common/vector.hpp"
 
 namespace duckdb {
 
-// Historgram supports two types of records
-// - For values within the given range, all the stats functions (i.e. min and max) only considers in-range values;
-// - For values out of range, we provide extra functions to retrieve.
-//
-// The reason why outliers are not considered as statistic is they disturb statistical value a lot.
 class Histogram {
 public:
-	// [min_val] is inclusive, and [max_val] is exclusive.
-	Histogram(double min_val, double max_val, int num_bkt);
+	// Default number of sub-bucket bits, which bounds relative error to 1/16.
+	static constexpr idx_t DEFAULT_SUB_BUCKET_BITS = 4;
+	// Exponent range of tracked values.
+	static constexpr int MIN_EXPONENT = -10;
+	static constexpr int MAX_EXPONENT = 48;
+
+	explicit Histogram(idx_t sub_bucket_bits = DEFAULT_SUB_BUCKET_BITS);
 
 	Histogram(const Histogram &) = delete;
 	Histogram &operator=(const Histogram &) = delete;
@@ -25,12 +39,32 @@ public:
 	// Set the distribution stats name and unit, used for formatting purpose.
 	void SetStatsDistribution(string name, string unit);
 
-	// Add [val] into the histogram.
-	// Return whether [val] is valid.
+	// Add [val] into the histogram, negative values are recorded as zero.
 	void Add(double val);
 
+	// Merge all records from [other] into the current histogram.
+	// Precondition: both histograms have the same number of sub-bucket bits.
+	void Merge(const Histogram &other);
+
+	// Remove all records of [earlier] from the current histogram, where [earlier] is a prior state of it.
+	// Exact min and max of remaining records are unknown, so they're approximated by bucket bounds.
+	// Precondition: both histograms have the same number of sub-bucket bits.
+	void Subtract(const Histogram &earlier);
+
 	// Get bucket index for the given [val].
-	size_t Bucket(double val) const;
+	idx_t Bucket(double val) const;
+	// Get the inclusive lower bound and exclusive upper bound for the given bucket.
+	double BucketLowerBound(idx_t bucket_idx) const;
+	double BucketUpperBound(idx_t bucket_idx) const;
+
+	// Get number of buckets, which covers the whole tracked range.
+	idx_t BucketCount() const {
+		return hist_.size();
+	}
+	// Get record count for the given bucket.
+	uint64_t BucketRecordCount(idx_t bucket_idx) const {
+		return bucket_idx < hist_.size() ? hist_[bucket_idx] : 0;
+	}
 
 	// Stats data.
 	size_t counts() const {
@@ -48,21 +82,19 @@ public:
 		return max_encountered_;
 	}
 
-	// Get outliers for stat records.
-	const std::vector<double> outliers() const {
-		return outliers_;
-	}
+	// Get the estimated value at quantile [q], which is within [0, 1].
+	// Precondition: there's at least one value inserted.
+	double Quantile(double q) const;
 
 	// Display histogram into string format.
 	string FormatString() const;
 
-	// Reset histogram.
+	// Reset histogram, bucket storage is kept to avoid re-allocation.
 	void Reset();
 
 private:
-	const double min_val_;
-	const double max_val_;
-	const int num_bkt_;
+	const idx_t sub_bucket_bits_;
+	const idx_t sub_bucket_count_;
 	// Max and min value encountered.
 	double min_encountered_;
 	double max_encountered_;
@@ -71,9 +103,7 @@ private:
 	// Accumulated sum.
 	double sum_ = 0.0;
 	// List of bucket counts.
-	std::vector<size_t> hist_;
-	// List of outliers.
-	std::vector<double> outliers_;
+	vector<uint64_t> hist_;
 	// Item name and unit for stats distribution.
 	string distribution_name_;
 	string distribution_unit_;
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get all non-empty latency and request size histogram buckets, one row per filesystem, bucket, IO operation and
+// histogram bucket.
+TableFunction ObservefsHistogramBucketsQueryFunc();
+
+} // namespace duckdb
@@ -1,12 +1,13 @@
 // Necessary changes to add a new IO operation:
 // 1. Add new IO operations to [`IoOperation`] enum class
-// 2. Add estimated latency to [`kLatencyHeuristics`]
+// 2. Add operation name to [`OPER_NAMES`]
 
 #pragma once
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace duckdb {
 
@@ -22,7 +23,10 @@ enum class IoOperation {
 	kStats = 5,
 	kFileSync = 6,
 	kRemoveFile = 7,
-	kUnknown = 8,
+	// Extended open and list, which carry metadata returned by listing, e.g. file size and last modification time.
+	kOpenExtended = 8,
+	kListExtended = 9,
+	kUnknown = 10,
 };
 
 constexpr size_t kIoOperationCount = static_cast<size_t>(IoOperation::kUnknown);
@@ -30,4 +34,7 @@ constexpr size_t kIoOperationCount = static_cast<size_t>(IoOperation::kUnknown);
 // Operation names, indexed by operation enums.
 extern const std::array<const char *, kIoOperationCount> OPER_NAMES;
 
+// Get IO operation by its name in [`OPER_NAMES`], return [`kUnknown`] if not found.
+IoOperation GetIoOperation(const std::string &oper_name);
+
 } // namespace duckdb
@@ -0,0 +1,159 @@
+// Listing cache keeps results of glob and list calls for a bounded time, since listing deep hive-partitioned prefixes
+// on object storage is commonly the slowest step of query planning.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+
+#include "duckdb/common/open_file_info.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "metadata_cache.hpp"
+
+namespace duckdb {
+
+// One entry listed by `ListFiles`.
+struct ListedFile {
+	string name;
+	bool is_directory = false;
+};
+
+// Listing cache stats, for glob and list calls respectively.
+struct ListingCacheStats {
+	MetadataCacheStats glob_stats;
+	MetadataCacheStats list_stats;
+};
+
+// Glob results are keyed by pattern, and plain and extended list results by directory. Each entry covers a prefix, i.e.
+// the pattern up to its first wildcard or the directory; modifying a file under the prefix through the filesystem drops
+// the entry.
+//
+// Memory is bounded: results with too many files are not cached, and when the cache is full, entries are evicted in the
+// order they're stored, after expired ones.
+//
+// A result is discarded if any path is modified while it's fetched, since the listing might miss the modification.
+//
+// Listing calls are orders of magnitude slower than a map lookup, so a single mutex is used. It's thread-safe.
+class ListingCache {
+public:
+	static constexpr idx_t MAX_ENTRY_COUNT = 256;
+	static constexpr idx_t MAX_FILE_COUNT_PER_ENTRY = 64 * 1024;
+	static constexpr int64_t DEFAULT_TTL_SEC = 60;
+
+	ListingCache() = default;
+
+	ListingCache(const ListingCache &) = delete;
+	ListingCache &operator=(const ListingCache &) = delete;
+
+	// Look up glob result for [pattern] at [now_ns], which is measured by steady clock. Return whether it's cached and
+	// not expired, in which case [files] is filled.
+	bool LookupGlob(const string &pattern, int64_t now_ns, vector<OpenFileInfo> &files);
+	// Store glob result for [pattern] fetched at [now_ns], [generation] is taken by [`GetGeneration`] before the fetch.
+	void UpdateGlob(const string &pattern, int64_t now_ns, uint64_t generation, const vector<OpenFileInfo> &files);
+
+	// Look up list result for [directory] at [now_ns]. Return whether it's cached and not expired, in which case
+	// [files] and the return value of the list call [listed] are filled.
+	bool LookupList(const string &directory, int64_t now_ns, vector<ListedFile> &files, bool &listed);
+	// Store list result for [directory] fetched at [now_ns], [generation] is taken by [`GetGeneration`] before the
+	// fetch.
+	void UpdateList(const string &directory, int64_t now_ns, uint64_t generation, const vector<ListedFile> &files,
+	                bool listed);
+
+	// Same as [`LookupList`] and [`UpdateList`], but for extended list results, which carry metadata returned by
+	// listing. They're cached apart from plain list results, and share stats with them.
+	bool LookupListExtended(const string &directory, int64_t now_ns, vector<OpenFileInfo> &files, bool &listed);
+	void UpdateListExtended(const string &directory, int64_t now_ns, uint64_t generation,
+	                        const vector<OpenFileInfo> &files, bool listed);
+
+	// Get the current generation, which is bumped on every invalidation; results fetched across a bump are not stored.
+	uint64_t GetGeneration();
+
+	// Drop all entries whose prefix covers [path], which is modified through the filesystem.
+	void Invalidate(const string &path);
+
+	// Enable or disable the cache, which is disabled by default; cached entries are dropped when disabled.
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const {
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	// Set the TTL for cached entries.
+	// Precondition: [ttl_sec] is positive.
+	void SetTtlSec(int64_t ttl_sec);
+	int64_t GetTtlSec() const {
+		return ttl_ns.load(std::memory_order_relaxed) / NANOS_PER_SEC;
+	}
+
+	ListingCacheStats GetStats();
+
+	// Drop all cached entries and reset stats.
+	void Reset();
+
+	// Get the prefix covered by glob [pattern], which is the part before its first wildcard.
+	static string GetGlobPrefix(const string &pattern);
+
+private:
+	static constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+
+	struct Entry;
+	using EntryMap = unordered_map<string, Entry>;
+
+	// Locates an entry in one of the entry maps.
+	struct EntryRef {
+		EntryMap *entries = nullptr;
+		string key;
+	};
+
+	struct Entry {
+		// Paths starting with the prefix could be in the result.
+		string prefix;
+		int64_t fetch_ns = 0;
+		// Glob or extended list result, only used for glob and extended list entries.
+		vector<OpenFileInfo> file_infos;
+		// List result, only used for list entries.
+		vector<ListedFile> list_files;
+		bool listed = false;
+		// Position in [`stored_entries`].
+		std::list<EntryRef>::iterator stored_iter;
+	};
+
+	struct Counters {
+		uint64_t hit_count = 0;
+		uint64_t miss_count = 0;
+		// Number of entries dropped because a file under their prefix is modified.
+		uint64_t invalidated_entry_count = 0;
+	};
+
+	// Get the fresh entry for [key] in [entries], return nullptr if not cached or expired.
+	Entry *GetFreshEntryWithLock(EntryMap &entries, const string &key, int64_t now_ns);
+	// Get the entry for [key] to update, which makes room if the cache is full; return nullptr if [generation] is
+	// outdated. The entry is moved to the back of the store order.
+	Entry *GetOrCreateEntryWithLock(EntryMap &entries, const string &key, int64_t now_ns, uint64_t generation);
+	// Erase the entry pointed by [iter] from [entries].
+	void EraseEntryWithLock(EntryMap &entries, EntryMap::iterator iter);
+	// Drop entries in [entries] whose prefix covers [path], return the number of dropped entries.
+	uint64_t DropCoveringEntriesWithLock(EntryMap &entries, const string &path);
+	// Drop all entries, and discard in-flight fetches.
+	void ClearWithLock();
+
+	std::atomic<bool> enabled {false};
+	std::atomic<int64_t> ttl_ns {DEFAULT_TTL_SEC * NANOS_PER_SEC};
+
+	std::mutex mu;
+	// Glob entries keyed by pattern, and list entries keyed by directory.
+	EntryMap glob_entries;
+	EntryMap list_entries;
+	EntryMap extended_list_entries;
+	// Entries of all kinds in the order they're stored, from the earliest to the latest.
+	std::list<EntryRef> stored_entries;
+	uint64_t generation = 0;
+	Counters glob_counters;
+	Counters list_counters;
+};
+
+} // namespace duckdb
@@ -0,0 +1,139 @@
+// Metadata cache keeps results of metadata calls (stats, file size, last modification time, version tag, file type and
+// existence) for a bounded time, so repeated queries over the same files don't re-issue a HEAD request per file.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+namespace duckdb {
+
+// Metadata calls whose results are cached.
+enum class MetadataField : uint8_t {
+	kStats = 0,
+	kFileSize = 1,
+	kLastModifiedTime = 2,
+	kVersionTag = 3,
+	kFileType = 4,
+	kFileExists = 5,
+};
+
+constexpr idx_t kMetadataFieldCount = 6;
+
+// Cached metadata for one path, only fields which have been fetched are valid.
+struct CachedFileMetadata {
+	FileMetadata stats;
+	int64_t file_size = 0;
+	timestamp_t last_modified_time;
+	string version_tag;
+	FileType file_type = FileType::FILE_TYPE_INVALID;
+	bool file_exists = false;
+};
+
+// Metadata cache stats.
+struct MetadataCacheStats {
+	uint64_t hit_count = 0;
+	uint64_t miss_count = 0;
+	// Number of paths currently cached.
+	uint64_t entry_count = 0;
+	// Number of entries dropped because the file is modified through the filesystem.
+	uint64_t invalidated_entry_count = 0;
+};
+
+// Each field expires [ttl] after it's fetched, independently of other fields of the same path; changing the TTL
+// applies to cached fields as well. Memory is bounded: when a stripe is full, expired entries are dropped, and if none
+// has expired, the entry fetched the earliest is evicted.
+//
+// Paths are partitioned into stripes by path hash, each protected by its own mutex. It's thread-safe.
+// Generations are tracked per stripe, so a modification also drops concurrent fetches for other paths of the stripe,
+// which only costs a later cache miss.
+class MetadataCache {
+public:
+	static constexpr idx_t STRIPE_COUNT = 16;
+	static constexpr idx_t MAX_ENTRY_COUNT_PER_STRIPE = 1024;
+	static constexpr int64_t DEFAULT_TTL_SEC = 60;
+
+	using ReadFunc = std::function<void(const CachedFileMetadata &metadata)>;
+	using UpdateFunc = std::function<void(CachedFileMetadata &metadata)>;
+
+	MetadataCache() = default;
+
+	MetadataCache(const MetadataCache &) = delete;
+	MetadataCache &operator=(const MetadataCache &) = delete;
+
+	// Look up [field] of [path] at [now_ns], which is measured by steady clock. If it's cached and not expired, invoke
+	// [read_func] on the cached metadata with lock held and return true; otherwise return false.
+	bool Lookup(const string &path, MetadataField field, int64_t now_ns, const ReadFunc &read_func);
+
+	// Get the generation of [path], which is expected to be taken before fetching metadata and passed to [`Update`].
+	uint64_t GetGeneration(const string &path);
+
+	// Store [field] of [path] fetched at [now_ns], [update_func] is expected to update the field with lock held.
+	// The field is discarded if [path] has been invalidated since [generation] was taken, since the fetch might have
+	// raced with a modification and returned stale metadata.
+	void Update(const string &path, MetadataField field, int64_t now_ns, uint64_t generation,
+	            const UpdateFunc &update_func);
+
+	// Drop all cached fields of [path], which is called when the file is modified through the filesystem.
+	void Invalidate(const string &path);
+
+	// Enable or disable the cache, which is disabled by default; cached entries are dropped when disabled.
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const {
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	// Set the TTL for cached fields.
+	// Precondition: [ttl_sec] is positive.
+	void SetTtlSec(int64_t ttl_sec);
+	int64_t GetTtlSec() const {
+		return ttl_ns.load(std::memory_order_relaxed) / NANOS_PER_SEC;
+	}
+
+	MetadataCacheStats GetStats();
+
+	// Drop all cached entries and reset stats.
+	void Reset();
+
+private:
+	static constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+
+	struct Entry {
+		CachedFileMetadata metadata;
+		// Fetch timestamp for each field, indexed by [`MetadataField`]; zero means not cached.
+		std::array<int64_t, kMetadataFieldCount> fetch_ns {};
+		// Earliest fetch timestamp among cached fields, used to pick eviction victim.
+		int64_t first_fetch_ns = 0;
+	};
+
+	struct Stripe {
+		std::mutex mu;
+		unordered_map<string, Entry> entries;
+		// Bumped whenever any path in the stripe is invalidated or the stripe is cleared.
+		uint64_t generation = 0;
+	};
+
+	Stripe &GetStripe(const string &path) {
+		return stripes[std::hash<string> {}(path) % STRIPE_COUNT];
+	}
+
+	// Make room for a new entry in [stripe] if it's full.
+	void EvictIfNecessaryWithLock(Stripe &stripe, int64_t now_ns) const;
+
+	std::atomic<bool> enabled {false};
+	std::atomic<int64_t> ttl_ns {DEFAULT_TTL_SEC * NANOS_PER_SEC};
+	std::atomic<uint64_t> hit_count {0};
+	std::atomic<uint64_t> miss_count {0};
+	std::atomic<uint64_t> invalidated_entry_count {0};
+	std::array<Stripe, STRIPE_COUNT> stripes;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get metadata and listing cache stats, one row per filesystem and cached operation.
+TableFunction ObservefsMetadataCacheQueryFunc();
+
+} // namespace duckdb
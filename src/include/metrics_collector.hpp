@@ -1,63 +1,224 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 
+#include "duckdb/common/map.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector.hpp"
+#include "access_pattern.hpp"
+#include "bucket_interner.hpp"
+#include "cache_mrc_simulator.hpp"
+#include "file_handle_stats.hpp"
 #include "histogram.hpp"
 #include "operation_latency_collector.hpp"
 #include "operation_size_collector.hpp"
+#include "query_stats_collector.hpp"
+#include "redundant_read_detector.hpp"
+#include "thread_sharded_state.hpp"
+#include "time_utils.hpp"
+#include "timeseries_sampler.hpp"
+#include "top_files_sketch.hpp"
 
 namespace duckdb {
 
-// A RAII wrapper, which manages one or more latency guards.
-class LatencyGuardWrapper {
-public:
-	LatencyGuardWrapper() = default;
-	~LatencyGuardWrapper() = default;
-
-	LatencyGuardWrapper(const LatencyGuardWrapper &) = delete;
-	LatencyGuardWrapper &operator=(const LatencyGuardWrapper &) = delete;
+// Latency and request size stats for one scope, i.e., the whole filesystem or one object storage bucket.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+struct OperationStats {
+	OperationStats();
 
-	LatencyGuardWrapper(LatencyGuardWrapper &&) = default;
-	LatencyGuardWrapper &operator=(LatencyGuardWrapper &&) = default;
+	// Merge all records from [other] into the current stats.
+	void Merge(const OperationStats &other);
+	// Reset all records in place.
+	void Reset();
 
-	// Take the ownership of the given [`latency_guard`].
-	void TakeGuard(LatencyGuard latency_guard);
+	unique_ptr<OperationLatencyCollector> latency_collector;
+	unique_ptr<OperationSizeCollector> size_collector;
+};
 
-private:
-	vector<LatencyGuard> latency_guards;
+// A consistent copy of all metrics for one filesystem, which could be inspected without blocking IO operations.
+struct MetricsSnapshot {
+	// Stats for all IO operations.
+	OperationStats overall_stats;
+	// Stats for each object storage bucket, ordered by bucket name.
+	map<string, unique_ptr<OperationStats>> bucket_stats;
+	// Per-open stats for closed file handles.
+	FileHandleStatsCollector file_handle_stats;
+	// Access pattern stats for closed file handles.
+	AccessPatternCollector access_pattern_stats;
 };
 
+// Metrics collector for one filesystem instance.
+//
+// Metrics are recorded into the calling thread's shard, so concurrent IO operations don't contend on a shared lock;
+// shards are only merged when stats are requested.
 class MetricsCollector {
 public:
 	MetricsCollector();
 	~MetricsCollector() = default;
 
 	// Record operation start without size.
-	LatencyGuardWrapper RecordOperationStart(IoOperation io_oper, const string &filepath);
+	LatencyGuard RecordOperationStart(IoOperation io_oper, const string &filepath);
 	// Record operation size with size.
-	LatencyGuardWrapper RecordOperationStart(IoOperation io_oper, const string &filepath, int64_t bytes_to_read);
+	LatencyGuard RecordOperationStart(IoOperation io_oper, const string &filepath, int64_t bytes_to_read);
+	// Record operation start without size, which is attributed to the query if [query_tag] is valid.
+	LatencyGuard RecordOperationStart(IoOperation io_oper, const string &filepath, const QueryTag &query_tag);
+	// Record operation start with size, which is attributed to the query if [query_tag] is valid.
+	LatencyGuard RecordOperationStart(IoOperation io_oper, const string &filepath, int64_t bytes_to_read,
+	                                  const QueryTag &query_tag);
+
+	// Record per-open metric values and access pattern of a closed file handle on [filepath], see
+	// [`FileHandleCounters::GetMetrics`].
+	void RecordHandleClose(const string &filepath, const std::array<double, kFileHandleMetricCount> &metrics,
+	                       const AccessPatternTracker &access_pattern_tracker);
+
+	// Record the byte range of a read on [filepath] for redundant read detection and cache simulation, duplicated bytes
+	// are attributed to the query if [query_tag] is valid.
+	void RecordReadRange(const string &filepath, idx_t location, idx_t nr_bytes, const QueryTag &query_tag);
+
+	// Get stats for recently read files with redundant reads, ordered by duplicated bytes descendingly.
+	vector<RedundantReadStats> GetRedundantReads();
+
+	// Enable or disable redundant read detection, which is disabled by default.
+	void SetRedundantReadDetectionEnabled(bool enabled);
+
+	// Set the window within which reads on overlapping byte ranges are considered redundant.
+	// Precondition: [window_sec] is positive.
+	void SetRedundantReadWindow(int64_t window_sec);
+
+	// Get predicted cache hit ratios over recorded reads, see [`CacheMrcSimulator`].
+	CacheMissRatioCurve GetCacheMissRatioCurve();
+
+	// Enable or disable cache simulation, which is disabled by default.
+	void SetCacheMrcEnabled(bool enabled);
+
+	// Set block size for cache simulation, which resets simulated cache if changed.
+	// Precondition: [block_size] is positive.
+	void SetCacheMrcBlockSize(idx_t block_size);
 
 	// Represent stats in human-readable format.
 	// If no stats collected, an empty string will be returned.
 	string GetHumanReadableStats();
 
+	// Get latency histogram for [io_oper] within the last [window_sec] seconds on [bucket], or on all paths if [bucket]
+	// is empty.
+	// Precondition: [window_sec] is within (0, [`RollingHistogram::GetMaxWindowSec`]].
+	unique_ptr<Histogram> GetRecentLatencyHistogram(IoOperation io_oper, const string &bucket, int64_t window_sec);
+
+	// Get latency at [quantile] in microseconds for [io_oper] within the last [window_sec] seconds on [bucket], or on
+	// all paths if [bucket] is empty. Return negative if less than [min_record_count] operations are recorded.
+	// Precondition: [window_sec] is within (0, [`RollingHistogram::GetMaxWindowSec`]].
+	double GetRecentLatencyQuantile(IoOperation io_oper, const string &bucket, double quantile, int64_t window_sec,
+	                                uint64_t min_record_count);
+
+	// Get overall latency stats merged from all shards.
+	unique_ptr<OperationLatencyCollector> GetOverallLatencyStats();
+
+	// Get a snapshot for all metrics, merged from all shards.
+	MetricsSnapshot GetSnapshot();
+
+	// Get IO stats for recent queries merged from all shards, ordered by query id.
+	vector<QueryStats> GetQueryStats();
+
+	// Get the top [k] files merged from all shards, ordered by [order] descendingly.
+	//
+	// Each shard keeps its own sketch, so a file's requests on shards which don't track it are unknown; they're bounded
+	// by the shard's min tracked count, which is added to both request count and its error. The merged count hence
+	// never underestimates, its error is at most 1/[`TopFilesSketch::CAPACITY`] of all requests, and any file with more
+	// requests than that is reported, same as a single sketch. Bytes and latency are only lower bounds, since they
+	// aren't accumulated on shards while the file is untracked.
+	vector<FileAccessStats> GetTopFiles(idx_t k, TopFilesOrder order = TopFilesOrder::kRequests);
+
+	// Get per-second time series samples, ordered from oldest to newest.
+	vector<TimeSeriesTick> GetTimeSeries();
+
+	// Enable or disable time series sampling, which is disabled by default; disabling drops all samples.
+	void SetTimeSeriesEnabled(bool enabled);
+
+	// Set the clock source to measure latency, which is steady clock by default.
+	// Precondition: TSC is supported if requested, see [`IsTscClockSupported`].
+	void SetLatencyClockSource(LatencyClockSource clock_source) {
+		latency_clock_source.store(clock_source, std::memory_order_relaxed);
+	}
+	// Get current timestamp in nanoseconds with the configured clock source.
+	int64_t GetLatencyClockNowNs() const {
+		return GetLatencyClockNowNanoSec(latency_clock_source.load(std::memory_order_relaxed));
+	}
+
 	// Reset all recorded metrics.
 	void Reset();
 
 private:
-	LatencyGuardWrapper RecordOperationStartWithLock(IoOperation io_oper, const string &filepath);
-
-	// Overall latency histogram.
-	std::mutex mu;
-	unique_ptr<OperationLatencyCollector> overall_latency_collector;
-	// Bucket-wise latency histogram.
-	unordered_map<string, unique_ptr<OperationLatencyCollector>> bucket_latency_collector;
-	// Operation size collector.
-	unique_ptr<OperationSizeCollector> operation_size_collector;
+	// Metrics recorded by threads mapped to one shard.
+	struct MetricsShard {
+		// Initialize collectors if not yet, which are allocated lazily since most shards are never touched by IO.
+		void InitializeIfNecessary();
+		// Reset all recorded metrics.
+		void Reset();
+
+		// Overall stats.
+		unique_ptr<OperationStats> overall_stats;
+		// Interned buckets accessed by the shard.
+		BucketInterner bucket_interner;
+		// Bucket-wise stats, indexed by interned bucket id.
+		vector<unique_ptr<OperationStats>> bucket_stats;
+		// Bucket-wise latency windows shared by all shards, indexed by interned bucket id.
+		vector<OperationLatencyWindow *> bucket_latency_windows;
+		// Per-query stats for recent queries.
+		QueryStatsCollector query_stats_collector;
+		// Access stats for most frequently accessed files.
+		TopFilesSketch top_files_sketch;
+		// Per-open stats for file handles closed by threads mapped to the shard.
+		FileHandleStatsCollector file_handle_stats_collector;
+		// Access pattern stats for file handles closed by threads mapped to the shard.
+		AccessPatternCollector access_pattern_collector;
+	};
+
+	using Shard = ThreadShardedState<MetricsShard>::Shard;
+
+	// Get the shard-local id of the bucket which [`filepath`] belongs to, and allocate its stats on first access;
+	// return [`DConstants::INVALID_INDEX`] if it's not an object storage path.
+	idx_t GetBucketIdWithLock(Shard &shard, const string &filepath);
+
+	// Get latency window for [bucket], or for all paths if [bucket] is empty; return nullptr if [bucket] is never
+	// accessed.
+	OperationLatencyWindow *GetLatencyWindow(const string &bucket);
+
+	// Record operation start, where negative [bytes_to_read] means request size is not applicable.
+	LatencyGuard RecordOperationStartImpl(IoOperation io_oper, const string &filepath, int64_t bytes_to_read,
+	                                      const QueryTag &query_tag);
+
+	// Take a time series sample if sampling is enabled and the sample interval has elapsed since the last one.
+	// There's no background thread; sampling is piggybacked on the IO path, and skipped if another thread is sampling.
+	// It's only one relaxed load when disabled, which is the default, so the IO path pays nothing unless opted in.
+	// Precondition: no shard lock is held by the calling thread.
+	void MaybeSampleTimeSeries(int64_t now_ns);
+
+	ThreadShardedState<MetricsShard> shards;
+
+	// Latency windows are kept per scope rather than per shard, since each window holds many slot histograms.
+	OperationLatencyWindow overall_latency_window;
+	// Protects the bucket latency windows map, it's acquired after a shard lock if both are held. Windows are never
+	// removed, so they could be accessed after the lock is released.
+	std::mutex bucket_latency_windows_mu;
+	unordered_map<string, unique_ptr<OperationLatencyWindow>> bucket_latency_windows;
+
+	std::atomic<LatencyClockSource> latency_clock_source {LatencyClockSource::kSteadyClock};
+
+	std::atomic<bool> timeseries_sampling_enabled {false};
+	// Timestamp by latency clock, before which no new sample is taken.
+	std::atomic<int64_t> next_timeseries_sample_ns {0};
+	// Protects time series sampler; it's always acquired before any shard lock.
+	std::mutex timeseries_sampler_mu;
+	TimeSeriesSampler timeseries_sampler;
+
+	// Recently read byte ranges, shared by all threads since the same file is commonly read by multiple threads.
+	RedundantReadDetector redundant_read_detector;
+	// Simulated block caches over all reads on the filesystem.
+	CacheMrcSimulator cache_mrc_simulator;
 };
 
 } // namespace duckdb
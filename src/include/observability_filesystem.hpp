@@ -8,8 +8,17 @@
 #include "duckdb/common/shared_ptr.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/unique_ptr.hpp"
+#include "access_pattern.hpp"
+#include "external_file_cache_stats_recorder.hpp"
+#include "file_handle_stats.hpp"
+#include "hedged_reader.hpp"
+#include "listing_cache.hpp"
+#include "metadata_cache.hpp"
 #include "metrics_collector.hpp"
+#include "query_stats_collector.hpp"
+#include "read_coalescer.hpp"
 
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <tuple>
@@ -21,19 +30,57 @@ class ObservabilityFileSystem;
 
 class ObservabilityFileSystemHandle : public FileHandle {
 public:
-	ObservabilityFileSystemHandle(unique_ptr<FileHandle> internal_file_handle_p, ObservabilityFileSystem &fs);
-	~ObservabilityFileSystemHandle() = default;
+	// [hedge_file_handle_p] is nullptr if reads on the handle are never hedged.
+	ObservabilityFileSystemHandle(unique_ptr<FileHandle> internal_file_handle_p,
+	                              unique_ptr<FileHandle> hedge_file_handle_p, ObservabilityFileSystem &fs,
+	                              QueryTag query_tag_p);
+	~ObservabilityFileSystemHandle() override;
 
-	void Close() override {
-	}
+	// Lifetime stats are recorded when the handle is closed or destructed, whichever comes first.
+	void Close() override;
+
+	// Get the [handle_idx]-th internal handle used by [`hedged_reader`].
+	// Precondition: the handle is held by the caller, see [`HedgedReader`]; the second one is only used if
+	// [`hedge_file_handle`] is opened.
+	FileHandle &GetInternalFileHandle(idx_t handle_idx);
 
 	unique_ptr<FileHandle> internal_file_handle;
+	// Second internal handle for duplicate requests of hedged reads, so they never share a handle with the original
+	// request. It's opened along with the primary one on the caller thread, and nullptr if hedged reads are disabled at
+	// open time or the handle is opened for writing.
+	unique_ptr<FileHandle> hedge_file_handle;
+	// Latency threshold for hedged reads on the handle, which is refreshed at most once per
+	// [`HedgedReadPolicy::THRESHOLD_REFRESH_INTERVAL_NS`]; negative if reads aren't hedged.
+	std::atomic<int64_t> hedge_threshold_ns {-1};
+	std::atomic<int64_t> hedge_threshold_refresh_ns {0};
+	// The query which opens the file, all IO operations on the handle are attributed to it.
+	QueryTag query_tag;
+	// Usage counters since the handle is opened.
+	FileHandleCounters counters;
+	// Access pattern of reads on the handle.
+	AccessPatternTracker access_pattern_tracker;
+	// Merges positional reads queued on the handle, only used when read coalescing is enabled.
+	ReadCoalescer read_coalescer;
+	// Issues duplicate requests for slow positional reads, only used when hedged reads are enabled.
+	// Declared after internal handles, so requests still running in background complete before they're destructed.
+	HedgedReader hedged_reader;
+
+private:
+	// Record lifetime stats into the filesystem's metrics, if not recorded yet.
+	void RecordLifetimeStats();
+
+	ObservabilityFileSystem &observability_fs;
+	bool lifetime_stats_recorded = false;
 };
 
 class ObservabilityFileSystem : public FileSystem {
 public:
-	ObservabilityFileSystem(unique_ptr<FileSystem> internal_filesystem_p, FileSystem &vfs_p)
-	    : internal_filesystem(std::move(internal_filesystem_p)), vfs(vfs_p) {
+	// [external_file_cache_stats_recorder_p] is shared by all filesystems of the same database instance, external file
+	// cache access isn't recorded if it's nullptr.
+	ObservabilityFileSystem(unique_ptr<FileSystem> internal_filesystem_p, FileSystem &vfs_p,
+	                        shared_ptr<ExternalFileCacheStatsRecorder> external_file_cache_stats_recorder_p = nullptr)
+	    : internal_filesystem(std::move(internal_filesystem_p)), vfs(vfs_p),
+	      external_file_cache_stats_recorder(std::move(external_file_cache_stats_recorder_p)) {
 	}
 	~ObservabilityFileSystem() override {
 	}
@@ -48,6 +95,72 @@ public:
 	// Get human-readable metrics stats.
 	// If no stats collected, which means no interested IO operations for current filesystem.
 	string GetHumanReadableStats();
+	// Get overall latency stats for all IO operations.
+	unique_ptr<OperationLatencyCollector> GetOverallLatencyStats();
+	// Get latency histogram for [io_oper] within the last [window_sec] seconds.
+	// Precondition: [window_sec] is within (0, [`RollingHistogram::GetMaxWindowSec`]].
+	unique_ptr<Histogram> GetRecentLatencyHistogram(IoOperation io_oper, int64_t window_sec);
+	// Get a consistent snapshot for all metrics.
+	MetricsSnapshot GetMetricsSnapshot();
+	// Get per-second time series samples.
+	vector<TimeSeriesTick> GetTimeSeries();
+	// Enable or disable per-second time series sampling.
+	void SetTimeSeriesEnabled(bool enabled);
+	// Set the clock source to measure latency.
+	void SetLatencyClockSource(LatencyClockSource clock_source) {
+		metrics_collector.SetLatencyClockSource(clock_source);
+	}
+	// Get current timestamp in nanoseconds with the configured latency clock source.
+	int64_t GetLatencyClockNowNs() const {
+		return metrics_collector.GetLatencyClockNowNs();
+	}
+	// Get IO stats for recent queries.
+	vector<QueryStats> GetQueryStats();
+	// Get the top [k] files ordered by [order].
+	vector<FileAccessStats> GetTopFiles(idx_t k, TopFilesOrder order);
+	// Get stats for recently read files with redundant reads.
+	vector<RedundantReadStats> GetRedundantReads();
+	// Enable or disable redundant read detection.
+	void SetRedundantReadDetectionEnabled(bool enabled);
+	// Set the window within which reads on overlapping byte ranges are considered redundant.
+	void SetRedundantReadWindow(int64_t window_sec);
+	// Get predicted cache hit ratios over recorded reads.
+	CacheMissRatioCurve GetCacheMissRatioCurve();
+	// Enable or disable cache simulation over recorded reads.
+	void SetCacheMrcEnabled(bool enabled);
+	// Set block size for cache simulation.
+	void SetCacheMrcBlockSize(idx_t block_size);
+	// Enable or disable read coalescing, and set the max gap between reads to merge.
+	void SetReadCoalescing(bool enabled, idx_t max_gap_bytes) {
+		read_coalescing_max_gap_bytes.store(max_gap_bytes, std::memory_order_relaxed);
+		read_coalescing_enabled.store(enabled, std::memory_order_relaxed);
+	}
+	// Get read coalescing stats.
+	const ReadCoalescingStats &GetReadCoalescingStats() const {
+		return read_coalescing_stats;
+	}
+	// Enable or disable hedged reads, and set max number of duplicate requests in percentage of eligible reads.
+	void SetHedgedReads(bool enabled, idx_t budget_percent) {
+		hedged_read_policy.SetBudgetPercent(budget_percent);
+		hedged_read_enabled.store(enabled, std::memory_order_relaxed);
+	}
+	// Get hedged read stats.
+	const HedgedReadStats &GetHedgedReadStats() const {
+		return hedged_read_stats;
+	}
+	// Enable or disable metadata cache, and set TTL for cached metadata.
+	void SetMetadataCacheEnabled(bool enabled);
+	void SetMetadataCacheTtl(int64_t ttl_sec);
+	// Get metadata cache hit and miss stats.
+	MetadataCacheStats GetMetadataCacheStats();
+	// Enable or disable glob and list result cache, and set TTL for cached results.
+	void SetListingCacheEnabled(bool enabled);
+	void SetListingCacheTtl(int64_t ttl_sec);
+	// Get glob and list result cache stats.
+	ListingCacheStats GetListingCacheStats();
+	// Record per-open metric values and access pattern of a closed file handle.
+	void RecordHandleClose(const string &filepath, const std::array<double, kFileHandleMetricCount> &metrics,
+	                       const AccessPatternTracker &access_pattern_tracker);
 
 	// Doesn't update file offset (which acts as `PRead` semantics).
 	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
@@ -128,14 +241,21 @@ public:
 	}
 
 protected:
-	// Because extended version of open and list are all "protected" visibility, which cannot access with the
-	// [`internal_filesystem`] variable, so we explicitly disable the extended version and fallback to normal one.
-	bool SupportsOpenFileExtended() const override {
-		return false;
-	}
-	bool SupportsListFilesExtended() const override {
-		return false;
+	// Extended open and list are forwarded to the internal filesystem, so metadata returned by listing (e.g. file size
+	// and last modification time) reaches it, instead of being dropped and re-fetched with one HEAD per file.
+	// They're supported whenever the internal filesystem supports them.
+	unique_ptr<FileHandle> OpenFileExtended(const OpenFileInfo &file, FileOpenFlags flags,
+	                                        optional_ptr<FileOpener> opener) override;
+	bool SupportsOpenFileExtended() const override;
+	bool ListFilesExtended(const string &directory, const std::function<void(OpenFileInfo &info)> &callback,
+	                       optional_ptr<FileOpener> opener) override;
+	bool SupportsListFilesExtended() const override;
+	// Glob results are expanded lazily by the internal filesystem, which is forwarded without materializing.
+	bool SupportsGlobExtended() const override {
+		return true;
 	}
+	unique_ptr<MultiFileList> GlobFilesExtended(const string &path, const FileGlobInput &input,
+	                                            optional_ptr<FileOpener> opener) override;
 
 private:
 	// Check whether the internal filesystem has been disabled by the VFS configuration.
@@ -151,12 +271,41 @@ private:
 		}
 	}
 
+	// Open [path] with the internal filesystem via [open], along with a second handle for hedged reads if they're
+	// enabled, and wrap them; return nullptr if the file isn't opened.
+	unique_ptr<FileHandle> OpenAndWrapFileHandle(const string &path, FileOpenFlags flags,
+	                                             optional_ptr<FileOpener> opener,
+	                                             const std::function<unique_ptr<FileHandle>()> &open);
+
+	// Get latency threshold in nanoseconds for positional reads on [handle] to be hedged, which is the recent tail
+	// latency of reads on its bucket; return negative if the read shouldn't be hedged.
+	int64_t GetHedgeThresholdNs(ObservabilityFileSystemHandle &handle);
+
+	// Drop cached metadata and listing results covering [path], which is modified through the filesystem.
+	void InvalidateCachedMetadata(const string &path);
+
 	// Used to access remote files.
 	unique_ptr<FileSystem> internal_filesystem;
 	// VFS that owns this filesystem, used for checking disabled state.
 	FileSystem &vfs;
+	// Records external file cache access for the owning database instance.
+	shared_ptr<ExternalFileCacheStatsRecorder> external_file_cache_stats_recorder;
 	// Overall histogram.
 	MetricsCollector metrics_collector;
+	// Read coalescing is opt-in, since it serializes upstream reads on one handle.
+	std::atomic<bool> read_coalescing_enabled {false};
+	std::atomic<idx_t> read_coalescing_max_gap_bytes {0};
+	ReadCoalescingStats read_coalescing_stats;
+	// Hedged reads are opt-in, since eligible positional reads are issued on executor threads with an extra copy, and
+	// each handle opened for reading opens a second internal handle.
+	std::atomic<bool> hedged_read_enabled {false};
+	HedgedReadPolicy hedged_read_policy;
+	HedgedReadStats hedged_read_stats;
+	HedgedReadExecutor hedged_read_executor;
+	// Caches results of metadata calls, only used when metadata cache is enabled.
+	MetadataCache metadata_cache;
+	// Caches glob and list results, only used when listing cache is enabled.
+	ListingCache listing_cache;
 };
 
 } // namespace duckdb
@@ -0,0 +1,55 @@
+// A file list which forwards to the lazily expanded file list of the internal filesystem, so glob expansion stays
+// incremental: DuckDB could open the first file before the whole listing completes, and the wrapper never
+// materializes the file list.
+
+#pragma once
+
+#include <atomic>
+
+#include "duckdb/common/enums/file_glob_options.hpp"
+#include "duckdb/common/multi_file/multi_file_list.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "metrics_collector.hpp"
+#include "query_stats_collector.hpp"
+
+namespace duckdb {
+
+// Each expansion which blocks on the internal filesystem, i.e. fetching a listing page, is recorded as one glob
+// operation, so glob latency reflects per-page round trips instead of one opaque call over the whole listing.
+//
+// Thread-safety follows the internal file list.
+class ObservabilityMultiFileList : public MultiFileList {
+public:
+	// [metrics_collector] is owned by the filesystem, which outlives all file lists it returns.
+	ObservabilityMultiFileList(unique_ptr<MultiFileList> internal_file_list_p, const string &pattern_p,
+	                           const FileGlobInput &glob_input_p, MetricsCollector &metrics_collector_p,
+	                           QueryTag query_tag_p);
+	~ObservabilityMultiFileList() override = default;
+
+	vector<OpenFileInfo> GetAllFiles() override;
+	FileExpandResult GetExpandResult() override;
+	idx_t GetTotalFileCount() override;
+
+protected:
+	bool FileIsAvailable(idx_t i) override;
+	OpenFileInfo GetFile(idx_t i) override;
+
+private:
+	// Record latency of an expansion on the internal file list as one glob operation.
+	LatencyGuard RecordExpansionStart();
+	// Whether the internal file list has more files to fetch beyond the scanned ones.
+	bool RequiresExpansion();
+
+	unique_ptr<MultiFileList> internal_file_list;
+	// Glob pattern, used to attribute glob latency to its bucket.
+	const string pattern;
+	MetricsCollector &metrics_collector;
+	const QueryTag query_tag;
+	// Whether the internal file list has been fully expanded, after which no expansion is recorded.
+	std::atomic<bool> fully_expanded {false};
+	// Number of leading files requested, which have been expanded.
+	std::atomic<idx_t> scanned_file_count {0};
+};
+
+} // namespace duckdb
@@ -3,12 +3,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
+#include "cache_mrc_simulator.hpp"
 #include "duckdb/common/shared_ptr.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/storage/object_cache.hpp"
+#include "external_file_cache_stats_recorder.hpp"
 #include "filesystem_ref_registry.hpp"
+#include "hedged_reader.hpp"
+#include "listing_cache.hpp"
+#include "metadata_cache.hpp"
+#include "redundant_read_detector.hpp"
+#include "time_utils.hpp"
 
 namespace duckdb {
 
@@ -20,9 +28,36 @@ class ObservefsInstanceState : public ObjectCacheEntry {
 public:
 	static constexpr const char *OBJECT_TYPE = "ObservefsInstanceState";
 	static constexpr const char *CACHE_KEY = "observefs_instance_state";
+	static constexpr idx_t DEFAULT_READ_COALESCING_MAX_GAP_BYTES = 64 * 1024;
 
 	ObservabilityFsRefRegistry registry;
 
+	// Records access to the instance's external file cache, shared with all observability filesystems of the instance.
+	shared_ptr<ExternalFileCacheStatsRecorder> external_file_cache_stats_recorder;
+
+	// Clock source to measure latency, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<LatencyClockSource> latency_clock_source {LatencyClockSource::kSteadyClock};
+	// Whether to sample per-second time series, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<bool> timeseries_enabled {false};
+	// Redundant read detection settings, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<bool> redundant_read_detection_enabled {false};
+	std::atomic<int64_t> redundant_read_window_sec {RedundantReadDetector::DEFAULT_WINDOW_SEC};
+	// Cache simulation settings, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<bool> cache_mrc_enabled {false};
+	std::atomic<idx_t> cache_mrc_block_size {CacheMrcSimulator::DEFAULT_BLOCK_SIZE};
+	// Read coalescing settings, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<bool> read_coalescing_enabled {false};
+	std::atomic<idx_t> read_coalescing_max_gap_bytes {DEFAULT_READ_COALESCING_MAX_GAP_BYTES};
+	// Hedged read settings, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<bool> hedged_read_enabled {false};
+	std::atomic<idx_t> hedged_read_budget_percent {HedgedReadPolicy::DEFAULT_BUDGET_PERCENT};
+	// Metadata cache settings, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<bool> metadata_cache_enabled {false};
+	std::atomic<int64_t> metadata_cache_ttl_sec {MetadataCache::DEFAULT_TTL_SEC};
+	// Glob and list result cache settings, applied to all registered filesystems, including ones wrapped later.
+	std::atomic<bool> listing_cache_enabled {false};
+	std::atomic<int64_t> listing_cache_ttl_sec {ListingCache::DEFAULT_TTL_SEC};
+
 	ObservefsInstanceState() = default;
 
 	// ObjectCacheEntry interface
@@ -1,74 +1,151 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
 
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
 #include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector.hpp"
 #include "histogram.hpp"
 #include "io_operation.hpp"
 #include "quantile_estimator.hpp"
+#include "rolling_histogram.hpp"
+#include "time_utils.hpp"
 
 namespace duckdb {
 
 // Forward declaration.
 class OperationLatencyCollector;
+class OperationLatencyWindow;
+struct FileAccessStats;
+struct QueryStats;
 
-// Heuristic estimation of single IO request latency, out of which range are classified as outliers.
-struct LatencyHeuristic {
-	double min_latency_ms;
-	double max_latency_ms;
-	int num_buckets;
-};
-
-extern const std::array<LatencyHeuristic, static_cast<size_t>(IoOperation::kUnknown)> kLatencyHeuristics;
-
-// A RAII guard to measure latency for IO operations.
+// A RAII guard to measure latency for IO operations, which records into one or more latency collectors at destruction.
+//
+// Collectors are kept in fixed-capacity inline storage, so neither starting nor ending a measurement allocates.
 class LatencyGuard {
 public:
-	LatencyGuard(OperationLatencyCollector &latency_collector_p, IoOperation io_operation_p);
+	// Max number of collectors a guard could record into, i.e., overall and bucket-wise collector.
+	static constexpr idx_t MAX_COLLECTOR_COUNT = 2;
+
+	// [`latency_collector_mu`] is the mutex which protects all collectors added to the guard.
+	// [`start_timestamp_ns`] is measured by [`clock_source`], which also measures the end timestamp.
+	LatencyGuard(std::mutex &latency_collector_mu_p, IoOperation io_operation_p, LatencyClockSource clock_source_p,
+	             int64_t start_timestamp_ns_p);
 	~LatencyGuard();
 
 	LatencyGuard(const LatencyGuard &) = delete;
 	LatencyGuard &operator=(const LatencyGuard &) = delete;
-	LatencyGuard(LatencyGuard &&) = default;
+	// Moved-from guard no longer records latency at destruction.
+	LatencyGuard(LatencyGuard &&other) noexcept;
 	LatencyGuard &operator=(LatencyGuard &&) = delete;
 
+	// Add a latency collector to record into.
+	// Precondition: less than [`MAX_COLLECTOR_COUNT`] collectors have been added.
+	void AddCollector(OperationLatencyCollector &latency_collector);
+
+	// Add a latency window to record into, which is synchronized by itself rather than the guard's mutex.
+	// Precondition: less than [`MAX_COLLECTOR_COUNT`] windows have been added.
+	void AddWindow(OperationLatencyWindow &latency_window);
+
+	// Set the stats of the query which issues the IO operation, also protected by the guard's mutex.
+	void SetQueryStats(QueryStats &query_stats_p);
+
+	// Set the access stats of the file which the IO operation is issued on, also protected by the guard's mutex.
+	void SetFileAccessStats(FileAccessStats &file_access_stats_p);
+
+	// Set the counter to accumulate latency in nanoseconds into, which is updated without the guard's mutex.
+	void SetIoWaitCounter(std::atomic<int64_t> &io_wait_counter_p);
+
 private:
-	OperationLatencyCollector &latency_collector;
+	std::mutex *latency_collector_mu = nullptr;
+	std::array<OperationLatencyCollector *, MAX_COLLECTOR_COUNT> latency_collectors;
+	idx_t latency_collector_count = 0;
+	std::array<OperationLatencyWindow *, MAX_COLLECTOR_COUNT> latency_windows;
+	idx_t latency_window_count = 0;
+	QueryStats *query_stats = nullptr;
+	FileAccessStats *file_access_stats = nullptr;
+	std::atomic<int64_t> *io_wait_counter = nullptr;
 	IoOperation io_operation = IoOperation::kUnknown;
-	int64_t start_timestamp = 0;
+	LatencyClockSource clock_source = LatencyClockSource::kSteadyClock;
+	// Start timestamp in nanoseconds, measured by [`clock_source`].
+	int64_t start_timestamp_ns = 0;
 };
 
+// Latency collector for all IO operations.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
 class OperationLatencyCollector {
 public:
 	OperationLatencyCollector();
 	~OperationLatencyCollector() = default;
 
-	LatencyGuard RecordOperationStart(IoOperation io_oper);
+	// Mark the end of the a completed IO operation, disregard it's successful or not.
+	// Latency is recorded in microseconds, with sub-microsecond precision preserved as fraction.
+	void RecordOperationEnd(IoOperation io_oper, double latency_microsec);
+
+	// Merge all latency records from [other] into the current collector.
+	void Merge(const OperationLatencyCollector &other);
+
+	// Reset all latency records.
+	void Reset();
+
+	// Get the latency histogram for the given IO operation.
+	const Histogram &GetHistogram(IoOperation io_oper) const {
+		return *latency_collector[static_cast<idx_t>(io_oper)].histogram;
+	}
+
+	// Get the quantile estimator for the given IO operation.
+	const QuantileEstimator &GetQuantileEstimator(IoOperation io_oper) const {
+		return *latency_collector[static_cast<idx_t>(io_oper)].quantile_estimator;
+	}
 
 	// Represent stats in human-readable format.
 	// Return empty string if no stats.
-	string GetHumanReadableStats();
+	string GetHumanReadableStats() const;
 
 private:
-	friend class LatencyGuard;
-
 	struct LatencyStatsCollector {
 		unique_ptr<Histogram> histogram;
 		unique_ptr<QuantileEstimator> quantile_estimator;
 	};
 
-	// Mark the end of the a completed IO operation, disregard it's successful or not.
-	void RecordOperationEnd(IoOperation io_oper, int64_t latency_millisec);
-
 	// Only records finished operations, which maps from io operation to histogram.
-	std::mutex latency_collector_mu;
 	std::array<LatencyStatsCollector, kIoOperationCount> latency_collector;
 };
 
+// Recent latency records for all IO operations, used for time-windowed stats.
+//
+// A rolling histogram keeps one histogram per slot, so a window is shared by all shards of a scope rather than kept per
+// shard; it's thread-safe, and its lock is only held to add or merge records.
+class OperationLatencyWindow {
+public:
+	OperationLatencyWindow() = default;
+
+	OperationLatencyWindow(const OperationLatencyWindow &) = delete;
+	OperationLatencyWindow &operator=(const OperationLatencyWindow &) = delete;
+
+	// Record latency of a completed IO operation in microseconds, [end_timestamp_ns] is on the steady clock timeline,
+	// which decides the time window the record belongs to.
+	void RecordOperationEnd(IoOperation io_oper, double latency_microsec, int64_t end_timestamp_ns);
+
+	// Merge latency records for the given IO operation within the last [window_sec] seconds as of [now_ns] into
+	// [histogram].
+	// Precondition: [histogram] has [`RollingHistogram::SUB_BUCKET_BITS`] sub-bucket bits, [window_sec] is within
+	// (0, [`RollingHistogram::GetMaxWindowSec`]].
+	void MergeWindowInto(IoOperation io_oper, int64_t now_ns, int64_t window_sec, Histogram &histogram) const;
+
+	// Reset all latency records.
+	void Reset();
+
+private:
+	mutable std::mutex mu;
+	std::array<RollingHistogram, kIoOperationCount> rolling_histograms;
+};
+
 } // namespace duckdb
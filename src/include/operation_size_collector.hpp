@@ -1,7 +1,7 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
-#include <mutex>
 
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/string.hpp"
@@ -10,6 +10,9 @@
 
 namespace duckdb {
 
+// Request size collector for all IO operations.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
 class OperationSizeCollector {
 public:
 	OperationSizeCollector();
@@ -17,11 +20,21 @@ public:
 
 	void RecordOperationSize(IoOperation io_oper, int64_t request_size);
 
+	// Merge all request size records from [other] into the current collector.
+	void Merge(const OperationSizeCollector &other);
+
+	// Reset all request size records.
+	void Reset();
+
+	// Get request size histogram for the given IO operation.
+	const Histogram &GetHistogram(IoOperation io_oper) const {
+		return *request_size_histograms[static_cast<idx_t>(io_oper)];
+	}
+
 	// Collect human-readable stats for operation size.
-	string GetHumanReadableStats();
+	string GetHumanReadableStats() const;
 
 private:
-	std::mutex mu;
 	std::array<unique_ptr<Histogram>, kIoOperationCount> request_size_histograms;
 };
 
@@ -0,0 +1,43 @@
+// Accessors to protected members of DuckDB classes, which wrappers need to invoke on the object they forward to.
+//
+// A derived class could only call protected members on objects of its own type, not on another instance of the base
+// class. Taking the member pointer through a derived class names the base class member, so it could be invoked on any
+// base class object; since the member is virtual, the call still dispatches to the wrapped object's override.
+//
+// The accessors are never instantiated, and DuckDB headers can't be changed to befriend the wrappers, so all such
+// accesses are kept in this header to be reviewed together when DuckDB APIs change.
+
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/multi_file/multi_file_list.hpp"
+#include "duckdb/common/open_file_info.hpp"
+#include "duckdb/common/typedefs.hpp"
+
+namespace duckdb {
+
+// Accesses extended open and list support checks of [`FileSystem`].
+struct FileSystemAccessor : public FileSystem {
+	FileSystemAccessor() = delete;
+
+	static bool CallSupportsOpenFileExtended(const FileSystem &filesystem) {
+		return (filesystem.*&FileSystemAccessor::SupportsOpenFileExtended)();
+	}
+	static bool CallSupportsListFilesExtended(const FileSystem &filesystem) {
+		return (filesystem.*&FileSystemAccessor::SupportsListFilesExtended)();
+	}
+};
+
+// Accesses expansion functions of [`MultiFileList`].
+struct MultiFileListAccessor : public MultiFileList {
+	MultiFileListAccessor() = delete;
+
+	static bool CallFileIsAvailable(MultiFileList &file_list, idx_t i) {
+		return (file_list.*&MultiFileListAccessor::FileIsAvailable)(i);
+	}
+	static OpenFileInfo CallGetFile(MultiFileList &file_list, idx_t i) {
+		return (file_list.*&MultiFileListAccessor::GetFile)(i);
+	}
+};
+
+} // namespace duckdb
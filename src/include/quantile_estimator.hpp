@@ -1,16 +1,18 @@
 #pragma once
 
-#include <array>
-#include <mutex>
 #include <utility>
 
+#include "ddsketch.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/vector.hpp"
-#include "quantile.hpp"
 #include "quantilelite.hpp"
 
 namespace duckdb {
 
+// Estimates quantiles of recorded data points, which are exact for a small number of data points, and within bounded
+// relative error afterwards.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
 class QuantileEstimator {
 public:
 	QuantileEstimator(string name_p, string unit_p)
@@ -21,6 +23,16 @@ public:
 	// Add the given value to quantile calculator.
 	void Add(float x);
 
+	// Merge all data points recorded by [other] into the current estimator, which is lossless.
+	void Merge(const QuantileEstimator &other);
+
+	// Get the value at quantile [q], which is within [0, 1].
+	// Return 0 if no data points recorded.
+	float Quantile(double q) const;
+
+	// Get number of data points recorded.
+	uint64_t Count() const;
+
 	float p50() const;
 	float p75() const;
 	float p90() const;
@@ -31,20 +43,21 @@ public:
 	string FormatString() const;
 
 private:
-	// Initialize P2 quantile.
-	void InitializeP2QuantileWithLock();
+	// Whether all data points are still kept in memory.
+	bool IsExact() const {
+		return quantile_lite.GetNumCollected() == sketch.Count();
+	}
 
 	// Metrics name and unit.
 	string quantile_name;
 	string quantile_unit;
 
-	// Used to trigger large-scale data point ingestion.
+	// Max number of data points kept in memory for exact quantile.
 	static constexpr size_t LARGE_SCALE_DATA_POINT_THRESHOLD = 512;
-	mutable std::mutex mu;
-	// Used for small scale data points, where P² algorithm doesn't work well and memory footprint is acceptable.
+	// Used for small scale data points, where exact quantile is affordable; dropped when threshold is reached.
 	QuantileLite quantile_lite;
-	// Used for large scale data points, where P² algorithm generates precise-enough quantile result.
-	vector<P2Quantile> estimators;
+	// Records all data points, used for large scale data points with bounded relative error.
+	DDSketch sketch;
 };
 
 } // namespace duckdb
@@ -24,6 +24,11 @@ public:
 		return extracted;
 	}
 
+	// Get all data points already collected.
+	const vector<float> &GetSamples() const {
+		return samples;
+	}
+
 	// Get number of data points already collected.
 	size_t GetNumCollected() const {
 		return samples.size();
@@ -45,9 +50,11 @@ public:
 		return Quantile(0.99);
 	}
 
-private:
+	// Get the value at quantile [q], which is within [0, 1].
+	// Return 0 if no data points collected.
 	float Quantile(float q) const;
 
+private:
 	mutable vector<float> samples;
 };
 
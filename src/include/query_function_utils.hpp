@@ -0,0 +1,72 @@
+// Shared helpers for table functions which query metrics recorded by observability filesystems.
+//
+// All rows are materialized at init, so a scan never observes partially-recorded state, and emitted in chunks
+// afterwards.
+
+#pragma once
+
+#include <initializer_list>
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "metrics_collector.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ObservabilityFileSystem;
+
+// Output column of a table function.
+struct QueryFunctionColumn {
+	const char *name;
+	LogicalTypeId type;
+};
+
+// Declare output [columns] in order at bind.
+void BindQueryFunctionColumns(std::initializer_list<QueryFunctionColumn> columns, vector<LogicalType> &return_types,
+                              vector<string> &names);
+
+// Rows materialized at init.
+template <typename Row>
+struct MaterializedRowsData : public GlobalTableFunctionState {
+	vector<Row> rows;
+
+	// Used to record the progress of emission.
+	idx_t offset = 0;
+};
+
+// Table function which emits the next chunk of [`MaterializedRowsData<Row>`], where [EMIT_ROW] fills in one row at
+// [row_idx] of [output].
+template <typename Row, void (*EMIT_ROW)(const Row &row, DataChunk &output, idx_t row_idx)>
+void EmitMaterializedRows(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<MaterializedRowsData<Row>>();
+	idx_t count = 0;
+	while (data.offset < data.rows.size() && count < STANDARD_VECTOR_SIZE) {
+		EMIT_ROW(data.rows[data.offset++], output, count++);
+	}
+	output.SetCardinality(count);
+}
+
+// Set [value] at [row_idx] of a fixed-size column.
+template <typename T>
+void SetColumnValue(Vector &column, idx_t row_idx, T value) {
+	FlatVector::GetData<T>(column)[row_idx] = value;
+}
+
+// Set [value] at [row_idx] of a VARCHAR column.
+void SetStringColumnValue(Vector &column, idx_t row_idx, const string &value);
+
+// Set [value] at [row_idx] of a VARCHAR column, or NULL if it's empty.
+void SetStringColumnValueOrNull(Vector &column, idx_t row_idx, const string &value);
+
+// Get all observability filesystems of the database.
+vector<ObservabilityFileSystem *> GetAllObservabilityFs(ClientContext &context);
+
+// Get metrics snapshots for all observability filesystems, along with their names.
+vector<std::pair<string, MetricsSnapshot>> GetAllMetricsSnapshots(ClientContext &context);
+
+} // namespace duckdb
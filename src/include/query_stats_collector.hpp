@@ -0,0 +1,84 @@
+// Per-query IO stats, which attribute IO operations to the queries issuing them.
+
+#pragma once
+
+#include <cstdint>
+
+#include "ddsketch.hpp"
+#include "duckdb/common/constants.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Identifies the connection and query which issue an IO operation.
+struct QueryTag {
+	idx_t connection_id = DConstants::INVALID_INDEX;
+	idx_t query_id = DConstants::INVALID_INDEX;
+
+	// Whether the IO operation is issued within a known query.
+	bool IsValid() const {
+		return query_id != DConstants::INVALID_INDEX;
+	}
+};
+
+// IO stats for one query.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+struct QueryStats {
+	// Record the start of an IO operation, with [bytes] being request size, or 0 if unknown.
+	void RecordOperationStart(int64_t bytes);
+	// Record the end of an IO operation.
+	void RecordOperationEnd(double latency_microsec);
+	// Record a read which fetches [duplicated_bytes_p] bytes already read within the redundant read window.
+	void RecordDuplicatedRead(uint64_t duplicated_bytes_p);
+	// Merge all records from [other] into the current stats, which belong to the same query.
+	void Merge(const QueryStats &other);
+	// Reset stats for a new query.
+	void Reset(const QueryTag &query_tag_p);
+
+	QueryTag query_tag;
+	uint64_t request_count = 0;
+	uint64_t bytes = 0;
+	// Accumulated latency for all IO operations, which is the time spent blocked in IO.
+	double io_wait_microsec = 0.0;
+	// Number of reads and bytes which re-fetch byte ranges already read within the redundant read window.
+	uint64_t duplicated_request_count = 0;
+	uint64_t duplicated_bytes = 0;
+	DDSketch latency_sketch;
+};
+
+// Stats for a bounded number of most recent queries.
+//
+// All entries are allocated at construction, so attributing an IO operation to a query never allocates. Entries are
+// recycled in place rather than destroyed, since in-flight latency guards still reference them; a recycled entry could
+// at worst attribute an in-flight operation to a newer query.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+class QueryStatsCollector {
+public:
+	// Max number of queries tracked, when exceeded the oldest query is evicted.
+	static constexpr idx_t MAX_QUERY_COUNT = 64;
+
+	QueryStatsCollector();
+
+	// Get stats for the given query, which takes over a reset or the oldest entry if not tracked yet.
+	// Precondition: [query_tag] is valid.
+	QueryStats &GetOrCreate(const QueryTag &query_tag);
+
+	// Get stats for all entries, entries without any request should be skipped.
+	const vector<unique_ptr<QueryStats>> &GetAllQueryStats() const {
+		return query_stats;
+	}
+
+	// Reset stats for all queries.
+	void Reset();
+
+private:
+	vector<unique_ptr<QueryStats>> query_stats;
+	// Index of the last accessed entry, since consecutive IO operations mostly come from the same query.
+	idx_t last_accessed_idx = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get IO stats for recent queries, one row per filesystem and query.
+TableFunction ObservefsQueryStatsQueryFunc();
+
+} // namespace duckdb
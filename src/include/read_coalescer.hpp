@@ -0,0 +1,76 @@
+// Read coalescer merges positional reads queued on the same file handle into fewer, larger upstream requests, which
+// cuts request count and per-request overhead for many small nearby reads, e.g. column chunks of wide Parquet files.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Read coalescing stats for one filesystem, which are updated by all its handles.
+struct ReadCoalescingStats {
+	// Reset all stats.
+	void Reset();
+
+	// Number of reads requested by callers.
+	std::atomic<uint64_t> request_count {0};
+	// Number of requests issued to the internal filesystem.
+	std::atomic<uint64_t> upstream_request_count {0};
+	// Number of reads served by an upstream request issued for another read.
+	std::atomic<uint64_t> merged_request_count {0};
+	// Number of bytes fetched in gaps between merged reads, which are not requested by any caller.
+	std::atomic<uint64_t> extra_bytes {0};
+};
+
+// Reads arriving while an upstream request is in flight are queued; once the in-flight request completes, one of the
+// waiting threads takes all queued reads, groups reads whose gap doesn't exceed the threshold, issues one upstream
+// request per group and scatters the result back to callers. A read arriving on an idle handle is issued immediately.
+//
+// Notice, upstream requests on the same handle are serialized, which trades concurrency on one handle for fewer
+// requests.
+//
+// It's thread-safe.
+class ReadCoalescer {
+public:
+	// Max number of bytes for one upstream request, reads are not merged beyond it.
+	static constexpr idx_t MAX_COALESCED_BYTES = 16 * 1024 * 1024;
+
+	// Read [nr_bytes] at [location] from upstream into [buffer].
+	using FetchFunc = std::function<void(char *buffer, idx_t nr_bytes, idx_t location)>;
+
+	// Read [nr_bytes] starting at [location] into [buffer], possibly merged with other queued reads whose gap doesn't
+	// exceed [max_gap_bytes]. Exception thrown by [fetch] is rethrown to all callers whose reads are affected.
+	void Read(char *buffer, idx_t nr_bytes, idx_t location, idx_t max_gap_bytes, const FetchFunc &fetch,
+	          ReadCoalescingStats &stats);
+
+private:
+	struct PendingRead {
+		char *buffer = nullptr;
+		idx_t nr_bytes = 0;
+		idx_t location = 0;
+		bool done = false;
+		std::exception_ptr error;
+	};
+
+	// Issue upstream requests for [reads], merging nearby ones.
+	// Precondition: [mu] is not held.
+	static void FetchPendingReads(vector<PendingRead *> &reads, idx_t max_gap_bytes, const FetchFunc &fetch,
+	                              ReadCoalescingStats &stats);
+
+	std::mutex mu;
+	std::condition_variable cv;
+	// Reads waiting to be issued.
+	vector<PendingRead *> pending_reads;
+	// Whether any thread is issuing upstream requests.
+	bool fetching = false;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get read coalescing stats, one row per filesystem with coalesced reads.
+TableFunction ObservefsReadCoalescingQueryFunc();
+
+} // namespace duckdb
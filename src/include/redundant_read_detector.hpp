@@ -0,0 +1,102 @@
+// Detects byte ranges of the same file which are fetched more than once within a time window, which measures bytes
+// re-fetched from remote storage.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Redundant read stats for one file.
+struct RedundantReadStats {
+	string path;
+	uint64_t request_count = 0;
+	// Number of requests which overlap with any range read within the window.
+	uint64_t duplicated_request_count = 0;
+	// Number of bytes which have been read within the window.
+	uint64_t duplicated_bytes = 0;
+};
+
+// Recently read ranges are kept per file in bounded memory: both the number of files and the number of ranges per
+// file are bounded, with the least recently accessed file and the oldest ranges evicted first. Stats are only kept for
+// files still tracked.
+//
+// Files are partitioned into stripes by path hash, each protected by its own mutex, so reads on different files rarely
+// contend; reads on one hot file still serialize on its stripe, so detection is disabled by default. It's thread-safe.
+class RedundantReadDetector {
+public:
+	static constexpr idx_t STRIPE_COUNT = 16;
+	static constexpr idx_t MAX_FILE_COUNT_PER_STRIPE = 64;
+	static constexpr idx_t MAX_RANGE_COUNT_PER_FILE = 128;
+	static constexpr int64_t DEFAULT_WINDOW_SEC = 60;
+
+	RedundantReadDetector() = default;
+
+	RedundantReadDetector(const RedundantReadDetector &) = delete;
+	RedundantReadDetector &operator=(const RedundantReadDetector &) = delete;
+
+	// Enable or disable detection, which is disabled by default.
+	void SetEnabled(bool enabled_p) {
+		enabled.store(enabled_p, std::memory_order_relaxed);
+	}
+	bool IsEnabled() const {
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	// Record a read of [nr_bytes] starting at [location] at [now_ns], which is measured by the configured latency
+	// clock. Return the number of bytes which have been read within the window, or 0 if detection is disabled.
+	uint64_t RecordRead(const string &path, idx_t location, idx_t nr_bytes, int64_t now_ns);
+
+	// Set the window to detect redundant reads, which only applies to later reads.
+	// Precondition: [window_sec] is positive.
+	void SetWindowSec(int64_t window_sec);
+	int64_t GetWindowSec() const {
+		return window_ns.load(std::memory_order_relaxed) / NANOS_PER_SEC;
+	}
+
+	// Get stats for tracked files with any redundant read, ordered by duplicated bytes descendingly.
+	vector<RedundantReadStats> GetRedundantReadStats();
+
+	// Reset all recorded ranges and stats.
+	void Reset();
+
+private:
+	static constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+
+	struct ReadRange {
+		idx_t start = 0;
+		idx_t end = 0;
+		int64_t timestamp_ns = 0;
+	};
+
+	struct FileReadRanges {
+		RedundantReadStats stats;
+		// Ranges read within the window, ordered by read timestamp.
+		std::deque<ReadRange> ranges;
+		int64_t last_access_ns = 0;
+	};
+
+	struct Stripe {
+		std::mutex mu;
+		unordered_map<string, unique_ptr<FileReadRanges>> files;
+	};
+
+	// Get read ranges for [path], which evicts the least recently accessed file if the stripe is full.
+	static FileReadRanges &GetOrCreateFileWithLock(Stripe &stripe, const string &path);
+
+	std::atomic<bool> enabled {false};
+	std::atomic<int64_t> window_ns {DEFAULT_WINDOW_SEC * NANOS_PER_SEC};
+	std::array<Stripe, STRIPE_COUNT> stripes;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get recently read files with redundant reads, one row per filesystem and file.
+TableFunction ObservefsRedundantReadsQueryFunc();
+
+} // namespace duckdb
@@ -0,0 +1,67 @@
+// A ring of per-interval histograms, which answers distribution over a sliding window of recent time.
+//
+// Time is divided into fixed-length slots; a record goes into the slot for its timestamp, and a slot is recycled lazily
+// once time wraps around the ring. Memory is bounded by the number of slots, regardless of the record rate.
+//
+// It's NOT thread-safe.
+
+#pragma once
+
+#include <cstdint>
+
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "histogram.hpp"
+
+namespace duckdb {
+
+class RollingHistogram {
+public:
+	// Length of one slot.
+	static constexpr int64_t SLOT_INTERVAL_SEC = 10;
+	// Number of slots, which covers the last 15 minutes.
+	static constexpr idx_t SLOT_COUNT = 90;
+	// Sub-bucket bits for slot histograms, which trades precision for memory since there're many slots.
+	static constexpr idx_t SUB_BUCKET_BITS = 3;
+
+	RollingHistogram();
+
+	RollingHistogram(const RollingHistogram &) = delete;
+	RollingHistogram &operator=(const RollingHistogram &) = delete;
+
+	// Add [val] recorded at [timestamp_ns], which is on the steady clock timeline.
+	void Add(double val, int64_t timestamp_ns);
+
+	// Merge all records from [other] into the current rolling histogram, only slots which haven't expired are kept.
+	void Merge(const RollingHistogram &other);
+
+	// Merge records within the last [window_sec] seconds as of [now_ns] into [histogram].
+	// Window is rounded up to slot granularity, so records up to [`SLOT_INTERVAL_SEC`] older might be included.
+	// Precondition: [histogram] has [`SUB_BUCKET_BITS`] sub-bucket bits, [window_sec] doesn't exceed max window.
+	void MergeWindowInto(int64_t now_ns, int64_t window_sec, Histogram &histogram) const;
+
+	// Get the max window in seconds which could be queried.
+	static constexpr int64_t GetMaxWindowSec() {
+		return SLOT_INTERVAL_SEC * static_cast<int64_t>(SLOT_COUNT);
+	}
+
+	// Clear all records.
+	void Reset();
+
+private:
+	struct Slot {
+		// Interval index since steady clock epoch, -1 if the slot is unused.
+		int64_t interval = -1;
+		// Allocated on first use.
+		unique_ptr<Histogram> histogram;
+	};
+
+	// Get the slot for [interval], recycle it if it holds an expired interval.
+	Slot &GetOrRecycleSlot(int64_t interval);
+
+	// Allocated on first record, since most IO operations are never issued.
+	vector<Slot> slots;
+};
+
+} // namespace duckdb
@@ -0,0 +1,200 @@
+// A heavy-hitters sketch which tracks the most frequently requested paths in bounded memory.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Space-saving sketch keyed by path, ranked by request count.
+//
+// When a new path comes in and the sketch is full, the path with least requests is replaced, and the new path
+// inherits its request count as error bound. Any path with more than 1/[`CAPACITY`] of all requests is guaranteed to
+// be tracked.
+//
+// [Entry] is expected to have `path`, an estimated `request_count` which the owner increments on each request, its
+// max overestimation `request_count_error`, and `ResetTrackedStats()` which clears stats accumulated since the path is
+// tracked.
+//
+// All entries are allocated on first access with path storage reserved, since most shards never record; paths are
+// looked up through a fixed-size hash index, so a lookup only hashes the path and probes a few slots, and never
+// allocates unless a new path is longer than reserved. Only an untracked path coming into a full sketch scans for the
+// least requested entry. Entries are recycled in place rather than destroyed, since in-flight latency guards still
+// reference them.
+//
+// It's NOT thread-safe, the owner is expected to synchronize accesses.
+template <typename Entry>
+class SpaceSavingSketch {
+public:
+	// Max number of paths tracked.
+	static constexpr idx_t CAPACITY = 256;
+	// Path length reserved for each entry.
+	static constexpr idx_t RESERVED_PATH_LENGTH = 256;
+
+	SpaceSavingSketch() {
+		index_slots.fill(EMPTY_INDEX_SLOT);
+	}
+
+	SpaceSavingSketch(const SpaceSavingSketch &) = delete;
+	SpaceSavingSketch &operator=(const SpaceSavingSketch &) = delete;
+
+	// Get entry for the given path, which replaces the least requested path if the sketch is full.
+	Entry &GetOrCreate(const string &path);
+
+	// Get all entries, entries without any request should be skipped.
+	const vector<unique_ptr<Entry>> &GetAllEntries() const {
+		return entries;
+	}
+
+	// Get the min request count among tracked paths if the sketch is full, otherwise 0. Any untracked path has at most
+	// that many requests, which is also no more than 1/[`CAPACITY`] of all requests.
+	uint64_t GetMinRequestCount() const;
+
+	// Reset all entries in place.
+	void Reset();
+
+private:
+	// Number of hash index slots, which is a power of two and twice the capacity, so probe sequences stay short.
+	static constexpr idx_t INDEX_SLOT_COUNT = 2 * CAPACITY;
+	// Marks an empty hash index slot.
+	static constexpr uint16_t EMPTY_INDEX_SLOT = UINT16_MAX;
+
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity should be a power of two");
+	static_assert(CAPACITY < UINT16_MAX, "Entry index should fit into hash index slot");
+
+	// Get the hash index slot which holds the entry for [path], or the empty slot where it should be inserted.
+	idx_t FindIndexSlot(const string &path, uint64_t path_hash) const;
+	// Remove the entry at [entry_idx] from hash index, and shift later entries in its probe sequence backward.
+	void RemoveFromIndex(idx_t entry_idx);
+
+	vector<unique_ptr<Entry>> entries;
+	// Path hash for each entry, only the first [`tracked_count`] entries are valid.
+	vector<uint64_t> path_hashes;
+	// Open-addressing hash index with linear probing, which maps path hash to entry index.
+	std::array<uint16_t, INDEX_SLOT_COUNT> index_slots;
+	// Number of entries tracking a path, which are always the leading ones.
+	idx_t tracked_count = 0;
+	// Index of the last accessed entry, since consecutive requests mostly access the same path.
+	idx_t last_accessed_idx = 0;
+};
+
+template <typename Entry>
+constexpr idx_t SpaceSavingSketch<Entry>::CAPACITY;
+template <typename Entry>
+constexpr idx_t SpaceSavingSketch<Entry>::RESERVED_PATH_LENGTH;
+template <typename Entry>
+constexpr idx_t SpaceSavingSketch<Entry>::INDEX_SLOT_COUNT;
+template <typename Entry>
+constexpr uint16_t SpaceSavingSketch<Entry>::EMPTY_INDEX_SLOT;
+
+template <typename Entry>
+idx_t SpaceSavingSketch<Entry>::FindIndexSlot(const string &path, uint64_t path_hash) const {
+	idx_t slot = path_hash & (INDEX_SLOT_COUNT - 1);
+	while (index_slots[slot] != EMPTY_INDEX_SLOT) {
+		const idx_t entry_idx = index_slots[slot];
+		if (path_hashes[entry_idx] == path_hash && entries[entry_idx]->path == path) {
+			break;
+		}
+		slot = (slot + 1) & (INDEX_SLOT_COUNT - 1);
+	}
+	return slot;
+}
+
+template <typename Entry>
+void SpaceSavingSketch<Entry>::RemoveFromIndex(idx_t entry_idx) {
+	idx_t slot = FindIndexSlot(entries[entry_idx]->path, path_hashes[entry_idx]);
+	D_ASSERT(index_slots[slot] == entry_idx);
+	// Backward shift deletion, so no tombstone is left and probe sequences don't degrade over evictions.
+	for (idx_t next_slot = (slot + 1) & (INDEX_SLOT_COUNT - 1); index_slots[next_slot] != EMPTY_INDEX_SLOT;
+	     next_slot = (next_slot + 1) & (INDEX_SLOT_COUNT - 1)) {
+		const idx_t home_slot = path_hashes[index_slots[next_slot]] & (INDEX_SLOT_COUNT - 1);
+		// The entry could be moved only if the vacated slot is still within its probe sequence.
+		if (((next_slot - home_slot) & (INDEX_SLOT_COUNT - 1)) >= ((next_slot - slot) & (INDEX_SLOT_COUNT - 1))) {
+			index_slots[slot] = index_slots[next_slot];
+			slot = next_slot;
+		}
+	}
+	index_slots[slot] = EMPTY_INDEX_SLOT;
+}
+
+template <typename Entry>
+Entry &SpaceSavingSketch<Entry>::GetOrCreate(const string &path) {
+	if (entries.empty()) {
+		entries.reserve(CAPACITY);
+		for (idx_t idx = 0; idx < CAPACITY; ++idx) {
+			entries.emplace_back(make_uniq<Entry>());
+			entries.back()->path.reserve(RESERVED_PATH_LENGTH);
+		}
+		path_hashes.resize(CAPACITY);
+	}
+
+	const uint64_t path_hash = std::hash<string> {}(path);
+	if (last_accessed_idx < tracked_count && path_hashes[last_accessed_idx] == path_hash &&
+	    entries[last_accessed_idx]->path == path) {
+		return *entries[last_accessed_idx];
+	}
+	const auto slot = FindIndexSlot(path, path_hash);
+	if (index_slots[slot] != EMPTY_INDEX_SLOT) {
+		last_accessed_idx = index_slots[slot];
+		return *entries[last_accessed_idx];
+	}
+
+	idx_t replace_idx = 0;
+	if (tracked_count < CAPACITY) {
+		replace_idx = tracked_count++;
+	} else {
+		for (idx_t idx = 1; idx < CAPACITY; ++idx) {
+			if (entries[idx]->request_count < entries[replace_idx]->request_count) {
+				replace_idx = idx;
+			}
+		}
+		RemoveFromIndex(replace_idx);
+	}
+
+	auto &cur_entry = *entries[replace_idx];
+	cur_entry.path = path;
+	cur_entry.request_count_error = cur_entry.request_count;
+	cur_entry.ResetTrackedStats();
+	path_hashes[replace_idx] = path_hash;
+	// Removal might have shifted entries, so the slot is searched again.
+	index_slots[FindIndexSlot(path, path_hash)] = static_cast<uint16_t>(replace_idx);
+	last_accessed_idx = replace_idx;
+	return cur_entry;
+}
+
+template <typename Entry>
+uint64_t SpaceSavingSketch<Entry>::GetMinRequestCount() const {
+	if (tracked_count < CAPACITY) {
+		return 0;
+	}
+	uint64_t min_request_count = entries[0]->request_count;
+	for (idx_t idx = 1; idx < CAPACITY; ++idx) {
+		min_request_count = std::min(min_request_count, entries[idx]->request_count);
+	}
+	return min_request_count;
+}
+
+template <typename Entry>
+void SpaceSavingSketch<Entry>::Reset() {
+	tracked_count = 0;
+	last_accessed_idx = 0;
+	index_slots.fill(EMPTY_INDEX_SLOT);
+	for (auto &cur_entry : entries) {
+		cur_entry->path.clear();
+		cur_entry->request_count = 0;
+		cur_entry->request_count_error = 0;
+		cur_entry->ResetTrackedStats();
+	}
+}
+
+} // namespace duckdb
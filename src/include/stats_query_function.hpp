@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get latency and request size stats, one row per filesystem, bucket and IO operation.
+TableFunction ObservefsStatsQueryFunc();
+
+} // namespace duckdb
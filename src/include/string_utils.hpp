@@ -3,12 +3,35 @@
 #pragma once
 
 #include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
 
 namespace duckdb {
 
+// A non-owning view over a sub-range of a string, used where materializing a substring would allocate on hot path.
+struct StringSlice {
+	const char *data = nullptr;
+	idx_t size = 0;
+
+	bool empty() const {
+		return size == 0;
+	}
+	string ToString() const {
+		return string(data, size);
+	}
+};
+
+// Get object storage bucket name as a view into [filepath], so no allocation is involved.
+// If the given filepath is unknown, return an empty slice.
+StringSlice GetObjectStorageBucketSlice(const string &filepath);
+
 // Get object storage bucket name, currently only supports S3 and GCS.
 // If the given filepath is unknown, return empty string.
 // TODO(hjiang): std::opional is a more proper return type.
 string GetObjectStorageBucket(const string &filepath);
 
+// Get file type of [filepath], which is the lowercase extension of its last path component, with URL query and
+// fragment ignored, e.g. "parquet" for "s3://bucket/data.Parquet?versionId=1".
+// If the file has no extension, return empty string.
+string GetFileType(const string &filepath);
+
 } // namespace duckdb
@@ -0,0 +1,71 @@
+// A container which keeps one copy of state per thread shard, so recording threads don't contend with each other.
+//
+// Each thread is assigned a stable slot on first access, which maps to a shard. As long as the number of recording
+// threads doesn't exceed the shard count, every thread owns its shard exclusively: the per-shard mutex is only ever
+// contended by readers, which visit all shards and merge them on demand.
+
+#pragma once
+
+#include <mutex>
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Cache line size, used to avoid false sharing between shards.
+constexpr idx_t THREAD_SHARD_CACHELINE_SIZE = 64;
+
+// Get the shard slot for the calling thread, which is assigned on first invocation and stays unchanged afterwards.
+idx_t GetThreadShardSlot();
+
+// Get the number of shards to use, which is a power of two derived from hardware concurrency.
+idx_t GetThreadShardCount();
+
+template <typename T>
+class ThreadShardedState {
+public:
+	struct Shard {
+		// Paddings on both sides make sure the hot fields of two shards never share a cache line.
+		char leading_padding[THREAD_SHARD_CACHELINE_SIZE];
+		std::mutex mu;
+		T state;
+		char trailing_padding[THREAD_SHARD_CACHELINE_SIZE];
+	};
+
+	ThreadShardedState() : shard_mask(GetThreadShardCount() - 1) {
+		shards.reserve(shard_mask + 1);
+		for (idx_t idx = 0; idx <= shard_mask; ++idx) {
+			shards.emplace_back(make_uniq<Shard>());
+		}
+	}
+
+	ThreadShardedState(const ThreadShardedState &) = delete;
+	ThreadShardedState &operator=(const ThreadShardedState &) = delete;
+
+	// Get the shard owned by the calling thread.
+	Shard &GetLocalShard() {
+		return *shards[GetThreadShardSlot() & shard_mask];
+	}
+
+	// Invoke [`func`] on the state of each shard, with the shard lock held.
+	template <typename Func>
+	void ForEachShard(Func &&func) {
+		for (auto &cur_shard : shards) {
+			std::lock_guard<std::mutex> lck(cur_shard->mu);
+			func(cur_shard->state);
+		}
+	}
+
+	idx_t GetShardCount() const {
+		return shards.size();
+	}
+
+private:
+	const idx_t shard_mask;
+	vector<unique_ptr<Shard>> shards;
+};
+
+} // namespace duckdb
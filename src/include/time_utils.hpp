@@ -9,6 +9,14 @@
 
 namespace duckdb {
 
+// Clock sources to measure IO operation latency.
+enum class LatencyClockSource {
+	// `std::chrono::steady_clock`, which is portable and monotonic.
+	kSteadyClock = 0,
+	// Calibrated CPU timestamp counter, which is cheaper to read; only available on x86-64 with invariant TSC.
+	kTsc = 1,
+};
+
 // Get current timestamp in steady clock since epoch in nanoseconds.
 int64_t GetSteadyNowNanoSecSinceEpoch();
 
@@ -21,4 +29,20 @@ int64_t GetSystemNowNanoSecSinceEpoch();
 // Get current timestamp in steady clock since epoch in milliseconds.
 int64_t GetSystemNowMilliSecSinceEpoch();
 
+// Interval to recalibrate TSC against steady clock, see [`IsTscClockSupported`].
+constexpr int64_t TSC_RECALIBRATION_INTERVAL_NS = 1000LL * 1000 * 1000;
+
+// Whether TSC clock source is supported on the current platform, i.e. the CPU reports an invariant TSC, which hasn't
+// drifted away from steady clock. TSC is calibrated on the first call, which busy waits for a short while, so it's
+// expected to be called before TSC is used to measure latency.
+//
+// TSC is recalibrated against steady clock every [`TSC_RECALIBRATION_INTERVAL_NS`]; if it's found drifting or going
+// backwards, it's considered unstable and steady clock is used afterwards.
+bool IsTscClockSupported();
+
+// Get current timestamp in nanoseconds with [clock_source], which falls back to steady clock if TSC is not supported.
+// Timestamps from all clock sources are on the steady clock timeline, so measurements across a clock source switch
+// are still valid.
+int64_t GetLatencyClockNowNanoSec(LatencyClockSource clock_source);
+
 } // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get per-second time series samples, one row per filesystem, sample tick, bucket and IO operation.
+TableFunction ObservefsTimeSeriesQueryFunc();
+
+} // namespace duckdb
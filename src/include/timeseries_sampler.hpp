@@ -0,0 +1,77 @@
+// Time series sampler, which turns cumulative metrics into a bounded ring of per-interval rates and latency quantiles.
+//
+// Each tick takes cumulative stats for every bucket and IO operation, and diffs them against the previous tick. Only
+// the most recent [`MAX_TICK_COUNT`] ticks are kept, so memory is bounded regardless of uptime.
+//
+// It's NOT thread-safe.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "histogram.hpp"
+#include "io_operation.hpp"
+
+namespace duckdb {
+
+// Rates and latency quantiles for one bucket and IO operation within one tick.
+struct TimeSeriesPoint {
+	// Empty for overall stats of the filesystem.
+	string bucket;
+	IoOperation io_oper = IoOperation::kUnknown;
+	double ops_per_sec = 0.0;
+	double bytes_per_sec = 0.0;
+	double p50_latency_us = 0.0;
+	double p99_latency_us = 0.0;
+};
+
+struct TimeSeriesTick {
+	// Wall clock timestamp at the end of the tick, in milliseconds since epoch.
+	int64_t timestamp_ms = 0;
+	// Length of the tick, which could be longer than sample interval if no IO operation happened in between.
+	double interval_sec = 0.0;
+	// Only buckets and IO operations with records in the tick are included.
+	vector<TimeSeriesPoint> points;
+};
+
+class TimeSeriesSampler {
+public:
+	// Max number of ticks kept, which covers the last 5 minutes at one tick per second.
+	static constexpr idx_t MAX_TICK_COUNT = 300;
+
+	// Cumulative stats for one bucket and IO operation.
+	struct CumulativeStats {
+		CumulativeStats();
+
+		unique_ptr<Histogram> latency_histogram;
+		// Accumulated request size in bytes.
+		double bytes = 0.0;
+	};
+	// Maps from bucket (empty for overall) and IO operation to cumulative stats.
+	using CumulativeStatsMap = map<std::pair<string, IoOperation>, CumulativeStats>;
+
+	// Add a tick at [steady_timestamp_ns], with [current_stats] to diff against the previous tick.
+	// The first tick only serves as baseline.
+	void AddTick(int64_t steady_timestamp_ns, int64_t system_timestamp_ms, CumulativeStatsMap current_stats);
+
+	// Get all ticks kept, ordered from oldest to newest.
+	vector<TimeSeriesTick> GetTicks() const;
+
+	// Clear all ticks and baseline.
+	void Reset();
+
+private:
+	bool has_baseline = false;
+	int64_t last_steady_timestamp_ns = 0;
+	CumulativeStatsMap previous_stats;
+	std::deque<TimeSeriesTick> ticks;
+};
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Get the top accessed files, at most k rows per filesystem, ordered by requests, bytes or latency.
+TableFunction ObservefsTopFilesQueryFunc();
+
+} // namespace duckdb
@@ -0,0 +1,46 @@
+// A heavy-hitters sketch which tracks the most frequently accessed files in bounded memory.
+
+#pragma once
+
+#include <cstdint>
+
+#include "duckdb/common/string.hpp"
+#include "space_saving_sketch.hpp"
+
+namespace duckdb {
+
+// Access stats for one file.
+struct FileAccessStats {
+	// Record the start of an IO operation, with [bytes] being request size, or 0 if unknown.
+	void RecordOperationStart(int64_t bytes);
+	// Record the end of an IO operation.
+	void RecordOperationEnd(double latency_microsec);
+	// Merge all records from [other] into the current stats, which belong to the same file.
+	void Merge(const FileAccessStats &other);
+	// Clear bytes and latency, which are only accumulated since the file is tracked.
+	void ResetTrackedStats();
+
+	string path;
+	// Estimated request count, which never underestimates the actual count.
+	uint64_t request_count = 0;
+	// Max overestimation of [request_count], inherited from the evicted file.
+	uint64_t request_count_error = 0;
+	// Bytes and latency are only accumulated since the file is tracked.
+	uint64_t bytes = 0;
+	double total_latency_microsec = 0.0;
+};
+
+// Orders to rank top files by.
+enum class TopFilesOrder {
+	// Estimated request count.
+	kRequests = 0,
+	// Bytes accessed since the file is tracked.
+	kBytes = 1,
+	// Accumulated latency since the file is tracked.
+	kLatency = 2,
+};
+
+// Space-saving sketch of most frequently accessed files, ranked by request count.
+using TopFilesSketch = SpaceSavingSketch<FileAccessStats>;
+
+} // namespace duckdb
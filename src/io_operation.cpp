@@ -2,7 +2,17 @@
 
 namespace duckdb {
 
-const std::array<const char *, kIoOperationCount> OPER_NAMES = {"open", "read",          "write",     "list",
-                                                                "glob", "get_file_size", "file_sync", "remove_file"};
+const std::array<const char *, kIoOperationCount> OPER_NAMES = {
+    "open",      "read",        "write",         "list",         "glob", "get_file_size",
+    "file_sync", "remove_file", "open_extended", "list_extended"};
+
+IoOperation GetIoOperation(const std::string &oper_name) {
+	for (size_t idx = 0; idx < kIoOperationCount; ++idx) {
+		if (oper_name == OPER_NAMES[idx]) {
+			return static_cast<IoOperation>(idx);
+		}
+	}
+	return IoOperation::kUnknown;
+}
 
 } // namespace duckdb
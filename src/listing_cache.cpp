@@ -0,0 +1,220 @@
+#include "listing_cache.hpp"
+
+#include "duckdb/common/assert.hpp"
+
+namespace duckdb {
+
+constexpr idx_t ListingCache::MAX_ENTRY_COUNT;
+constexpr idx_t ListingCache::MAX_FILE_COUNT_PER_ENTRY;
+constexpr int64_t ListingCache::DEFAULT_TTL_SEC;
+constexpr int64_t ListingCache::NANOS_PER_SEC;
+
+string ListingCache::GetGlobPrefix(const string &pattern) {
+	const auto wildcard_pos = pattern.find_first_of("*?[{");
+	if (wildcard_pos == string::npos) {
+		return pattern;
+	}
+	return pattern.substr(0, wildcard_pos);
+}
+
+ListingCache::Entry *ListingCache::GetFreshEntryWithLock(EntryMap &entries, const string &key, int64_t now_ns) {
+	auto iter = entries.find(key);
+	if (iter == entries.end()) {
+		return nullptr;
+	}
+	if (iter->second.fetch_ns <= now_ns - ttl_ns.load(std::memory_order_relaxed)) {
+		EraseEntryWithLock(entries, iter);
+		return nullptr;
+	}
+	return &iter->second;
+}
+
+ListingCache::Entry *ListingCache::GetOrCreateEntryWithLock(EntryMap &entries, const string &key, int64_t now_ns,
+                                                            uint64_t generation_p) {
+	if (generation_p != generation) {
+		return nullptr;
+	}
+	auto iter = entries.find(key);
+	if (iter != entries.end()) {
+		stored_entries.splice(stored_entries.end(), stored_entries, iter->second.stored_iter);
+		return &iter->second;
+	}
+
+	// Expired entries are mostly stored the earliest, so they're dropped from the front before evicting a fresh one.
+	const int64_t expire_before_ns = now_ns - ttl_ns.load(std::memory_order_relaxed);
+	while (!stored_entries.empty()) {
+		auto &evict_entries = *stored_entries.front().entries;
+		auto evict_iter = evict_entries.find(stored_entries.front().key);
+		D_ASSERT(evict_iter != evict_entries.end());
+		if (stored_entries.size() < MAX_ENTRY_COUNT && evict_iter->second.fetch_ns > expire_before_ns) {
+			break;
+		}
+		EraseEntryWithLock(evict_entries, evict_iter);
+	}
+	auto &entry = entries[key];
+	entry.stored_iter = stored_entries.insert(stored_entries.end(), EntryRef {&entries, key});
+	return &entry;
+}
+
+void ListingCache::EraseEntryWithLock(EntryMap &entries, EntryMap::iterator iter) {
+	stored_entries.erase(iter->second.stored_iter);
+	entries.erase(iter);
+}
+
+uint64_t ListingCache::DropCoveringEntriesWithLock(EntryMap &entries, const string &path) {
+	uint64_t dropped_count = 0;
+	for (auto iter = entries.begin(); iter != entries.end();) {
+		const auto &prefix = iter->second.prefix;
+		if (path.compare(0, prefix.length(), prefix) == 0) {
+			stored_entries.erase(iter->second.stored_iter);
+			iter = entries.erase(iter);
+			++dropped_count;
+		} else {
+			++iter;
+		}
+	}
+	return dropped_count;
+}
+
+void ListingCache::ClearWithLock() {
+	glob_entries.clear();
+	list_entries.clear();
+	extended_list_entries.clear();
+	stored_entries.clear();
+	++generation;
+}
+
+bool ListingCache::LookupGlob(const string &pattern, int64_t now_ns, vector<OpenFileInfo> &files) {
+	std::lock_guard<std::mutex> lck(mu);
+	auto *entry = GetFreshEntryWithLock(glob_entries, pattern, now_ns);
+	if (entry == nullptr) {
+		++glob_counters.miss_count;
+		return false;
+	}
+	++glob_counters.hit_count;
+	files = entry->file_infos;
+	return true;
+}
+
+void ListingCache::UpdateGlob(const string &pattern, int64_t now_ns, uint64_t generation_p,
+                              const vector<OpenFileInfo> &files) {
+	if (files.size() > MAX_FILE_COUNT_PER_ENTRY) {
+		return;
+	}
+	std::lock_guard<std::mutex> lck(mu);
+	auto *entry = GetOrCreateEntryWithLock(glob_entries, pattern, now_ns, generation_p);
+	if (entry == nullptr) {
+		return;
+	}
+	entry->prefix = GetGlobPrefix(pattern);
+	entry->fetch_ns = now_ns;
+	entry->file_infos = files;
+}
+
+bool ListingCache::LookupList(const string &directory, int64_t now_ns, vector<ListedFile> &files, bool &listed) {
+	std::lock_guard<std::mutex> lck(mu);
+	auto *entry = GetFreshEntryWithLock(list_entries, directory, now_ns);
+	if (entry == nullptr) {
+		++list_counters.miss_count;
+		return false;
+	}
+	++list_counters.hit_count;
+	files = entry->list_files;
+	listed = entry->listed;
+	return true;
+}
+
+void ListingCache::UpdateList(const string &directory, int64_t now_ns, uint64_t generation_p,
+                              const vector<ListedFile> &files, bool listed) {
+	if (files.size() > MAX_FILE_COUNT_PER_ENTRY) {
+		return;
+	}
+	std::lock_guard<std::mutex> lck(mu);
+	auto *entry = GetOrCreateEntryWithLock(list_entries, directory, now_ns, generation_p);
+	if (entry == nullptr) {
+		return;
+	}
+	entry->prefix = directory;
+	entry->fetch_ns = now_ns;
+	entry->list_files = files;
+	entry->listed = listed;
+}
+
+bool ListingCache::LookupListExtended(const string &directory, int64_t now_ns, vector<OpenFileInfo> &files,
+                                      bool &listed) {
+	std::lock_guard<std::mutex> lck(mu);
+	auto *entry = GetFreshEntryWithLock(extended_list_entries, directory, now_ns);
+	if (entry == nullptr) {
+		++list_counters.miss_count;
+		return false;
+	}
+	++list_counters.hit_count;
+	files = entry->file_infos;
+	listed = entry->listed;
+	return true;
+}
+
+void ListingCache::UpdateListExtended(const string &directory, int64_t now_ns, uint64_t generation_p,
+                                      const vector<OpenFileInfo> &files, bool listed) {
+	if (files.size() > MAX_FILE_COUNT_PER_ENTRY) {
+		return;
+	}
+	std::lock_guard<std::mutex> lck(mu);
+	auto *entry = GetOrCreateEntryWithLock(extended_list_entries, directory, now_ns, generation_p);
+	if (entry == nullptr) {
+		return;
+	}
+	entry->prefix = directory;
+	entry->fetch_ns = now_ns;
+	entry->file_infos = files;
+	entry->listed = listed;
+}
+
+uint64_t ListingCache::GetGeneration() {
+	std::lock_guard<std::mutex> lck(mu);
+	return generation;
+}
+
+void ListingCache::Invalidate(const string &path) {
+	std::lock_guard<std::mutex> lck(mu);
+	++generation;
+	glob_counters.invalidated_entry_count += DropCoveringEntriesWithLock(glob_entries, path);
+	list_counters.invalidated_entry_count += DropCoveringEntriesWithLock(list_entries, path);
+	list_counters.invalidated_entry_count += DropCoveringEntriesWithLock(extended_list_entries, path);
+}
+
+void ListingCache::SetEnabled(bool enabled_p) {
+	const bool was_enabled = enabled.exchange(enabled_p, std::memory_order_relaxed);
+	if (was_enabled && !enabled_p) {
+		std::lock_guard<std::mutex> lck(mu);
+		ClearWithLock();
+	}
+}
+
+void ListingCache::SetTtlSec(int64_t ttl_sec) {
+	D_ASSERT(ttl_sec > 0);
+	ttl_ns.store(ttl_sec * NANOS_PER_SEC, std::memory_order_relaxed);
+}
+
+ListingCacheStats ListingCache::GetStats() {
+	ListingCacheStats stats;
+	std::lock_guard<std::mutex> lck(mu);
+	stats.glob_stats.hit_count = glob_counters.hit_count;
+	stats.glob_stats.miss_count = glob_counters.miss_count;
+	stats.glob_stats.entry_count = glob_entries.size();
+	stats.glob_stats.invalidated_entry_count = glob_counters.invalidated_entry_count;
+	stats.list_stats.hit_count = list_counters.hit_count;
+	stats.list_stats.miss_count = list_counters.miss_count;
+	stats.list_stats.entry_count = list_entries.size() + extended_list_entries.size();
+	stats.list_stats.invalidated_entry_count = list_counters.invalidated_entry_count;
+	return stats;
+}
+
+void ListingCache::Reset() {
+	std::lock_guard<std::mutex> lck(mu);
+	ClearWithLock();
+	glob_counters = Counters {};
+	list_counters = Counters {};
+}
+
+} // namespace duckdb
@@ -0,0 +1,134 @@
+#include "metadata_cache.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "duckdb/common/assert.hpp"
+
+namespace duckdb {
+
+constexpr idx_t MetadataCache::STRIPE_COUNT;
+constexpr idx_t MetadataCache::MAX_ENTRY_COUNT_PER_STRIPE;
+constexpr int64_t MetadataCache::DEFAULT_TTL_SEC;
+constexpr int64_t MetadataCache::NANOS_PER_SEC;
+
+bool MetadataCache::Lookup(const string &path, MetadataField field, int64_t now_ns, const ReadFunc &read_func) {
+	const int64_t expire_before_ns = now_ns - ttl_ns.load(std::memory_order_relaxed);
+	auto &stripe = GetStripe(path);
+	{
+		std::lock_guard<std::mutex> lck(stripe.mu);
+		auto iter = stripe.entries.find(path);
+		if (iter != stripe.entries.end()) {
+			const auto fetch_ns = iter->second.fetch_ns[static_cast<idx_t>(field)];
+			if (fetch_ns != 0 && fetch_ns > expire_before_ns) {
+				read_func(iter->second.metadata);
+				hit_count.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+	}
+	miss_count.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+void MetadataCache::EvictIfNecessaryWithLock(Stripe &stripe, int64_t now_ns) const {
+	if (stripe.entries.size() < MAX_ENTRY_COUNT_PER_STRIPE) {
+		return;
+	}
+
+	// Drop all expired entries first, which is amortized over the following insertions.
+	const int64_t expire_before_ns = now_ns - ttl_ns.load(std::memory_order_relaxed);
+	for (auto cur_iter = stripe.entries.begin(); cur_iter != stripe.entries.end();) {
+		const auto &fetch_ns = cur_iter->second.fetch_ns;
+		const int64_t last_fetch_ns = *std::max_element(fetch_ns.begin(), fetch_ns.end());
+		if (last_fetch_ns <= expire_before_ns) {
+			cur_iter = stripe.entries.erase(cur_iter);
+		} else {
+			++cur_iter;
+		}
+	}
+	if (stripe.entries.size() < MAX_ENTRY_COUNT_PER_STRIPE) {
+		return;
+	}
+
+	auto evict_iter = std::min_element(stripe.entries.begin(), stripe.entries.end(),
+	                                   [](const std::pair<const string, Entry> &lhs,
+	                                      const std::pair<const string, Entry> &rhs) {
+		                                   return lhs.second.first_fetch_ns < rhs.second.first_fetch_ns;
+	                                   });
+	stripe.entries.erase(evict_iter);
+}
+
+uint64_t MetadataCache::GetGeneration(const string &path) {
+	auto &stripe = GetStripe(path);
+	std::lock_guard<std::mutex> lck(stripe.mu);
+	return stripe.generation;
+}
+
+void MetadataCache::Update(const string &path, MetadataField field, int64_t now_ns, uint64_t generation,
+                           const UpdateFunc &update_func) {
+	auto &stripe = GetStripe(path);
+	std::lock_guard<std::mutex> lck(stripe.mu);
+	if (stripe.generation != generation) {
+		return;
+	}
+	auto iter = stripe.entries.find(path);
+	if (iter == stripe.entries.end()) {
+		EvictIfNecessaryWithLock(stripe, now_ns);
+		iter = stripe.entries.emplace(path, Entry {}).first;
+		iter->second.first_fetch_ns = now_ns;
+	}
+	auto &entry = iter->second;
+	update_func(entry.metadata);
+	entry.fetch_ns[static_cast<idx_t>(field)] = now_ns;
+}
+
+void MetadataCache::Invalidate(const string &path) {
+	auto &stripe = GetStripe(path);
+	std::lock_guard<std::mutex> lck(stripe.mu);
+	++stripe.generation;
+	if (stripe.entries.erase(path) > 0) {
+		invalidated_entry_count.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void MetadataCache::SetEnabled(bool enabled_p) {
+	const bool was_enabled = enabled.exchange(enabled_p, std::memory_order_relaxed);
+	if (was_enabled && !enabled_p) {
+		for (auto &cur_stripe : stripes) {
+			std::lock_guard<std::mutex> lck(cur_stripe.mu);
+			cur_stripe.entries.clear();
+			++cur_stripe.generation;
+		}
+	}
+}
+
+void MetadataCache::SetTtlSec(int64_t ttl_sec) {
+	D_ASSERT(ttl_sec > 0);
+	ttl_ns.store(ttl_sec * NANOS_PER_SEC, std::memory_order_relaxed);
+}
+
+MetadataCacheStats MetadataCache::GetStats() {
+	MetadataCacheStats stats;
+	stats.hit_count = hit_count.load(std::memory_order_relaxed);
+	stats.miss_count = miss_count.load(std::memory_order_relaxed);
+	stats.invalidated_entry_count = invalidated_entry_count.load(std::memory_order_relaxed);
+	for (auto &cur_stripe : stripes) {
+		std::lock_guard<std::mutex> lck(cur_stripe.mu);
+		stats.entry_count += cur_stripe.entries.size();
+	}
+	return stats;
+}
+
+void MetadataCache::Reset() {
+	for (auto &cur_stripe : stripes) {
+		std::lock_guard<std::mutex> lck(cur_stripe.mu);
+		cur_stripe.entries.clear();
+		++cur_stripe.generation;
+	}
+	hit_count.store(0, std::memory_order_relaxed);
+	miss_count.store(0, std::memory_order_relaxed);
+	invalidated_entry_count.store(0, std::memory_order_relaxed);
+}
+
+} // namespace duckdb
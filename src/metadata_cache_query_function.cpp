@@ -0,0 +1,93 @@
+#include "metadata_cache_query_function.hpp"
+
+#include <array>
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "io_operation.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct MetadataCacheRow {
+	string filesystem;
+	// Cached operation, i.e. stats for metadata calls, glob and list.
+	IoOperation io_oper = IoOperation::kUnknown;
+	MetadataCacheStats stats;
+};
+
+unique_ptr<FunctionData> ObservefsMetadataCacheQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                             vector<LogicalType> &return_types, vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        // Metadata calls are recorded under "get_file_size" operation, whose latency stats only include cache
+	        // misses; glob and list calls under their own operation, whether they're served by cache or not.
+	        {"operation", LogicalTypeId::VARCHAR},
+	        {"hits", LogicalTypeId::UBIGINT},
+	        {"misses", LogicalTypeId::UBIGINT},
+	        {"hit_ratio", LogicalTypeId::DOUBLE},
+	        // Number of paths, patterns or directories currently cached.
+	        {"entries", LogicalTypeId::UBIGINT},
+	        // Number of entries dropped because files are modified through the filesystem.
+	        {"invalidations", LogicalTypeId::UBIGINT},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsMetadataCacheQueryFuncInit(ClientContext &context,
+                                                                         TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<MetadataCacheRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto filesystem = cur_filesystem->GetName();
+		const auto listing_cache_stats = cur_filesystem->GetListingCacheStats();
+		const std::array<std::pair<IoOperation, MetadataCacheStats>, 3> oper_and_stats {{
+		    {IoOperation::kStats, cur_filesystem->GetMetadataCacheStats()},
+		    {IoOperation::kGlob, listing_cache_stats.glob_stats},
+		    {IoOperation::kList, listing_cache_stats.list_stats},
+		}};
+		for (const auto &cur_oper_and_stats : oper_and_stats) {
+			// Skip operations without any cached call.
+			if (cur_oper_and_stats.second.hit_count + cur_oper_and_stats.second.miss_count == 0) {
+				continue;
+			}
+			MetadataCacheRow row;
+			row.filesystem = filesystem;
+			row.io_oper = cur_oper_and_stats.first;
+			row.stats = cur_oper_and_stats.second;
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	return std::move(result);
+}
+
+void EmitMetadataCacheRow(const MetadataCacheRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetStringColumnValue(output.data[1], row_idx, OPER_NAMES[static_cast<idx_t>(row.io_oper)]);
+	SetColumnValue<uint64_t>(output.data[2], row_idx, row.stats.hit_count);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, row.stats.miss_count);
+	SetColumnValue<double>(output.data[4], row_idx,
+	                       static_cast<double>(row.stats.hit_count) /
+	                           static_cast<double>(row.stats.hit_count + row.stats.miss_count));
+	SetColumnValue<uint64_t>(output.data[5], row_idx, row.stats.entry_count);
+	SetColumnValue<uint64_t>(output.data[6], row_idx, row.stats.invalidated_entry_count);
+}
+
+} // namespace
+
+TableFunction ObservefsMetadataCacheQueryFunc() {
+	TableFunction metadata_cache_query_func {/*name=*/"observefs_metadata_cache",
+	                                         /*arguments=*/ {},
+	                                         /*function=*/EmitMaterializedRows<MetadataCacheRow, EmitMetadataCacheRow>,
+	                                         /*bind=*/ObservefsMetadataCacheQueryFuncBind,
+	                                         /*init_global=*/ObservefsMetadataCacheQueryFuncInit};
+	return metadata_cache_query_func;
+}
+
+} // namespace duckdb
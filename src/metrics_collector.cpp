@@ -1,83 +1,439 @@
 #include "metrics_collector.hpp"
 
+#include <algorithm>
 #include <utility>
 
 #include "string_utils.hpp"
+#include "time_utils.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/string_util.hpp"
 
 namespace duckdb {
 
-void LatencyGuardWrapper::TakeGuard(LatencyGuard latency_guard) {
-	latency_guards.emplace_back(std::move(latency_guard));
+namespace {
+// Interval between two time series samples.
+constexpr int64_t TIMESERIES_SAMPLE_INTERVAL_NS = 1000LL * 1000 * 1000;
+} // namespace
+
+OperationStats::OperationStats()
+    : latency_collector(make_uniq<OperationLatencyCollector>()), size_collector(make_uniq<OperationSizeCollector>()) {
+}
+
+void OperationStats::Merge(const OperationStats &other) {
+	latency_collector->Merge(*other.latency_collector);
+	size_collector->Merge(*other.size_collector);
 }
 
-MetricsCollector::MetricsCollector()
-    : overall_latency_collector(make_uniq<OperationLatencyCollector>()),
-      operation_size_collector(make_uniq<OperationSizeCollector>()) {
+void OperationStats::Reset() {
+	latency_collector->Reset();
+	size_collector->Reset();
 }
 
-LatencyGuardWrapper MetricsCollector::RecordOperationStart(IoOperation io_oper, const string &filepath) {
-	std::lock_guard<std::mutex> lck(mu);
-	return RecordOperationStartWithLock(std::move(io_oper), filepath);
+void MetricsCollector::MetricsShard::InitializeIfNecessary() {
+	if (overall_stats != nullptr) {
+		return;
+	}
+	overall_stats = make_uniq<OperationStats>();
 }
 
-LatencyGuardWrapper MetricsCollector::RecordOperationStart(IoOperation io_oper, const string &filepath,
-                                                           int64_t bytes_to_read) {
-	std::lock_guard<std::mutex> lck(mu);
-	operation_size_collector->RecordOperationSize(io_oper, bytes_to_read);
-	return RecordOperationStartWithLock(std::move(io_oper), filepath);
+void MetricsCollector::MetricsShard::Reset() {
+	// Collectors are reset in place rather than destroyed, since in-flight latency guards still reference them.
+	query_stats_collector.Reset();
+	top_files_sketch.Reset();
+	file_handle_stats_collector.Reset();
+	access_pattern_collector.Reset();
+	if (overall_stats == nullptr) {
+		return;
+	}
+	overall_stats->Reset();
+	for (auto &cur_bucket_stats : bucket_stats) {
+		cur_bucket_stats->Reset();
+	}
+}
+
+MetricsCollector::MetricsCollector() {
+}
+
+idx_t MetricsCollector::GetBucketIdWithLock(Shard &shard, const string &filepath) {
+	const auto bucket = GetObjectStorageBucketSlice(filepath);
+	if (bucket.empty()) {
+		return DConstants::INVALID_INDEX;
+	}
+	const auto bucket_id = shard.state.bucket_interner.GetOrIntern(bucket);
+	auto &bucket_stats = shard.state.bucket_stats;
+	if (bucket_id == bucket_stats.size()) {
+		bucket_stats.emplace_back(make_uniq<OperationStats>());
+		std::lock_guard<std::mutex> windows_lck(bucket_latency_windows_mu);
+		auto &latency_window = bucket_latency_windows[shard.state.bucket_interner.GetBucket(bucket_id)];
+		if (latency_window == nullptr) {
+			latency_window = make_uniq<OperationLatencyWindow>();
+		}
+		shard.state.bucket_latency_windows.emplace_back(latency_window.get());
+	}
+	return bucket_id;
 }
 
-LatencyGuardWrapper MetricsCollector::RecordOperationStartWithLock(IoOperation io_oper, const string &filepath) {
-	const auto bucket = GetObjectStorageBucket(filepath);
+OperationLatencyWindow *MetricsCollector::GetLatencyWindow(const string &bucket) {
+	if (bucket.empty()) {
+		return &overall_latency_window;
+	}
+	std::lock_guard<std::mutex> windows_lck(bucket_latency_windows_mu);
+	auto iter = bucket_latency_windows.find(bucket);
+	return iter == bucket_latency_windows.end() ? nullptr : iter->second.get();
+}
 
-	LatencyGuardWrapper guard_wrapper {};
-	auto overall_latency_guard = overall_latency_collector->RecordOperationStart(io_oper);
-	guard_wrapper.TakeGuard(std::move(overall_latency_guard));
+void MetricsCollector::MaybeSampleTimeSeries(int64_t now_ns) {
+	if (!timeseries_sampling_enabled.load(std::memory_order_relaxed) ||
+	    now_ns < next_timeseries_sample_ns.load(std::memory_order_relaxed)) {
+		return;
+	}
+	std::unique_lock<std::mutex> sampler_lck(timeseries_sampler_mu, std::try_to_lock);
+	if (!sampler_lck.owns_lock() || now_ns < next_timeseries_sample_ns.load(std::memory_order_relaxed)) {
+		return;
+	}
+	next_timeseries_sample_ns.store(now_ns + TIMESERIES_SAMPLE_INTERVAL_NS, std::memory_order_relaxed);
 
-	if (!bucket.empty()) {
-		auto &cur_bucket_hist = bucket_latency_collector[bucket];
-		if (cur_bucket_hist == nullptr) {
-			cur_bucket_hist = make_uniq<OperationLatencyCollector>();
+	// Only latency histograms and request size sums are collected, which is much cheaper than a full snapshot.
+	TimeSeriesSampler::CumulativeStatsMap cumulative_stats;
+	auto collect_stats = [&cumulative_stats](const string &bucket, const OperationStats &stats) {
+		for (idx_t cur_oper_idx = 0; cur_oper_idx < kIoOperationCount; ++cur_oper_idx) {
+			const auto io_oper = static_cast<IoOperation>(cur_oper_idx);
+			const auto &latency_histogram = stats.latency_collector->GetHistogram(io_oper);
+			if (latency_histogram.counts() == 0) {
+				continue;
+			}
+			auto &cur_stats = cumulative_stats[std::make_pair(bucket, io_oper)];
+			cur_stats.latency_histogram->Merge(latency_histogram);
+			cur_stats.bytes += stats.size_collector->GetHistogram(io_oper).sum();
 		}
-		auto bucket_latency_guard = cur_bucket_hist->RecordOperationStart(io_oper);
-		guard_wrapper.TakeGuard(std::move(bucket_latency_guard));
+	};
+	shards.ForEachShard([&collect_stats](const MetricsShard &cur_shard) {
+		if (cur_shard.overall_stats == nullptr) {
+			return;
+		}
+		collect_stats(/*bucket=*/"", *cur_shard.overall_stats);
+		for (idx_t bucket_id = 0; bucket_id < cur_shard.bucket_stats.size(); ++bucket_id) {
+			collect_stats(cur_shard.bucket_interner.GetBucket(bucket_id), *cur_shard.bucket_stats[bucket_id]);
+		}
+	});
+	timeseries_sampler.AddTick(now_ns, GetSystemNowMilliSecSinceEpoch(), std::move(cumulative_stats));
+}
+
+LatencyGuard MetricsCollector::RecordOperationStart(IoOperation io_oper, const string &filepath) {
+	return RecordOperationStartImpl(io_oper, filepath, /*bytes_to_read=*/-1, QueryTag {});
+}
+
+LatencyGuard MetricsCollector::RecordOperationStart(IoOperation io_oper, const string &filepath,
+                                                    int64_t bytes_to_read) {
+	return RecordOperationStartImpl(io_oper, filepath, bytes_to_read, QueryTag {});
+}
+
+LatencyGuard MetricsCollector::RecordOperationStart(IoOperation io_oper, const string &filepath,
+                                                    const QueryTag &query_tag) {
+	return RecordOperationStartImpl(io_oper, filepath, /*bytes_to_read=*/-1, query_tag);
+}
+
+LatencyGuard MetricsCollector::RecordOperationStart(IoOperation io_oper, const string &filepath,
+                                                    int64_t bytes_to_read, const QueryTag &query_tag) {
+	return RecordOperationStartImpl(io_oper, filepath, bytes_to_read, query_tag);
+}
+
+LatencyGuard MetricsCollector::RecordOperationStartImpl(IoOperation io_oper, const string &filepath,
+                                                        int64_t bytes_to_read, const QueryTag &query_tag) {
+	const auto clock_source = latency_clock_source.load(std::memory_order_relaxed);
+	const auto now_ns = GetLatencyClockNowNanoSec(clock_source);
+	MaybeSampleTimeSeries(now_ns);
+
+	auto &shard = shards.GetLocalShard();
+	std::lock_guard<std::mutex> lck(shard.mu);
+	shard.state.InitializeIfNecessary();
+
+	const bool has_size = bytes_to_read >= 0;
+	LatencyGuard latency_guard {shard.mu, io_oper, clock_source, now_ns};
+	if (has_size) {
+		shard.state.overall_stats->size_collector->RecordOperationSize(io_oper, bytes_to_read);
+	}
+	latency_guard.AddCollector(*shard.state.overall_stats->latency_collector);
+	latency_guard.AddWindow(overall_latency_window);
+	const auto bucket_id = GetBucketIdWithLock(shard, filepath);
+	if (bucket_id != DConstants::INVALID_INDEX) {
+		auto &bucket_stats = *shard.state.bucket_stats[bucket_id];
+		if (has_size) {
+			bucket_stats.size_collector->RecordOperationSize(io_oper, bytes_to_read);
+		}
+		latency_guard.AddCollector(*bucket_stats.latency_collector);
+		latency_guard.AddWindow(*shard.state.bucket_latency_windows[bucket_id]);
+	}
+	if (query_tag.IsValid()) {
+		auto &query_stats = shard.state.query_stats_collector.GetOrCreate(query_tag);
+		query_stats.RecordOperationStart(has_size ? bytes_to_read : 0);
+		latency_guard.SetQueryStats(query_stats);
+	}
+	// Directory listing and glob don't access any file.
+	if (io_oper != IoOperation::kList && io_oper != IoOperation::kGlob) {
+		auto &file_access_stats = shard.state.top_files_sketch.GetOrCreate(filepath);
+		file_access_stats.RecordOperationStart(has_size ? bytes_to_read : 0);
+		latency_guard.SetFileAccessStats(file_access_stats);
+	}
+	return latency_guard;
+}
+
+void MetricsCollector::RecordHandleClose(const string &filepath,
+                                         const std::array<double, kFileHandleMetricCount> &metrics,
+                                         const AccessPatternTracker &access_pattern_tracker) {
+	auto &shard = shards.GetLocalShard();
+	std::lock_guard<std::mutex> lck(shard.mu);
+	shard.state.file_handle_stats_collector.RecordHandleClose(metrics);
+	shard.state.access_pattern_collector.RecordHandleClose(filepath, access_pattern_tracker);
+}
+
+MetricsSnapshot MetricsCollector::GetSnapshot() {
+	MetricsSnapshot snapshot;
+	shards.ForEachShard([&snapshot](const MetricsShard &cur_shard) {
+		// Handles could be closed by threads which never issue any IO operation.
+		snapshot.file_handle_stats.Merge(cur_shard.file_handle_stats_collector);
+		snapshot.access_pattern_stats.Merge(cur_shard.access_pattern_collector);
+		if (cur_shard.overall_stats == nullptr) {
+			return;
+		}
+		snapshot.overall_stats.Merge(*cur_shard.overall_stats);
+		for (idx_t bucket_id = 0; bucket_id < cur_shard.bucket_stats.size(); ++bucket_id) {
+			const auto &bucket = cur_shard.bucket_interner.GetBucket(bucket_id);
+			auto &merged_bucket_stats = snapshot.bucket_stats[bucket];
+			if (merged_bucket_stats == nullptr) {
+				merged_bucket_stats = make_uniq<OperationStats>();
+			}
+			merged_bucket_stats->Merge(*cur_shard.bucket_stats[bucket_id]);
+		}
+	});
+	return snapshot;
+}
+
+unique_ptr<Histogram> MetricsCollector::GetRecentLatencyHistogram(IoOperation io_oper, const string &bucket,
+                                                                  int64_t window_sec) {
+	auto window_histogram = make_uniq<Histogram>(RollingHistogram::SUB_BUCKET_BITS);
+	const auto *latency_window = GetLatencyWindow(bucket);
+	if (latency_window != nullptr) {
+		latency_window->MergeWindowInto(io_oper, GetLatencyClockNowNs(), window_sec, *window_histogram);
+	}
+	return window_histogram;
+}
+
+double MetricsCollector::GetRecentLatencyQuantile(IoOperation io_oper, const string &bucket, double quantile,
+                                                  int64_t window_sec, uint64_t min_record_count) {
+	const auto window_histogram = GetRecentLatencyHistogram(io_oper, bucket, window_sec);
+	if (window_histogram->counts() < min_record_count) {
+		return -1.0;
 	}
+	return window_histogram->Quantile(quantile);
+}
 
-	return guard_wrapper;
+unique_ptr<OperationLatencyCollector> MetricsCollector::GetOverallLatencyStats() {
+	auto overall_latency_collector = make_uniq<OperationLatencyCollector>();
+	shards.ForEachShard([&overall_latency_collector](const MetricsShard &cur_shard) {
+		if (cur_shard.overall_stats == nullptr) {
+			return;
+		}
+		overall_latency_collector->Merge(*cur_shard.overall_stats->latency_collector);
+	});
+	return overall_latency_collector;
 }
 
 string MetricsCollector::GetHumanReadableStats() {
-	std::lock_guard<std::mutex> lck(mu);
+	// Stats are formatted on the snapshot, so no shard lock is held while formatting.
+	const auto snapshot = GetSnapshot();
 
 	string human_readable_stats;
 
 	// Collect latency stats.
-	const string overall_latency_stats_str = overall_latency_collector->GetHumanReadableStats();
+	const string overall_latency_stats_str = snapshot.overall_stats.latency_collector->GetHumanReadableStats();
 	if (!overall_latency_stats_str.empty()) {
 		human_readable_stats += StringUtil::Format("Overall latency: \n%s\n", overall_latency_stats_str);
 	}
 
-	for (const auto &bucket_and_histogram : bucket_latency_collector) {
-		human_readable_stats += StringUtil::Format("  Bucket: %s\n", bucket_and_histogram.first);
-		human_readable_stats +=
-		    StringUtil::Format("  Latency: %s\n", bucket_and_histogram.second->GetHumanReadableStats());
+	for (const auto &bucket_and_stats : snapshot.bucket_stats) {
+		const auto bucket_latency_stats_str = bucket_and_stats.second->latency_collector->GetHumanReadableStats();
+		// Bucket has been reset since it was first accessed.
+		if (bucket_latency_stats_str.empty()) {
+			continue;
+		}
+		human_readable_stats += StringUtil::Format("  Bucket: %s\n", bucket_and_stats.first);
+		human_readable_stats += StringUtil::Format("  Latency: %s\n", bucket_latency_stats_str);
 	}
 
 	// Collect request size stats.
-	const auto size_stats = operation_size_collector->GetHumanReadableStats();
+	const auto size_stats = snapshot.overall_stats.size_collector->GetHumanReadableStats();
 	if (!size_stats.empty()) {
 		human_readable_stats += StringUtil::Format("\nRequest size: %s\n", size_stats);
 	}
 
+	// Collect per-open file handle stats.
+	const auto file_handle_stats = snapshot.file_handle_stats.GetHumanReadableStats();
+	if (!file_handle_stats.empty()) {
+		human_readable_stats += StringUtil::Format("\nFile handle: %s\n", file_handle_stats);
+	}
+
 	return human_readable_stats;
 }
 
+void MetricsCollector::RecordReadRange(const string &filepath, idx_t location, idx_t nr_bytes,
+                                       const QueryTag &query_tag) {
+	cache_mrc_simulator.RecordRead(filepath, location, nr_bytes);
+	if (!redundant_read_detector.IsEnabled()) {
+		return;
+	}
+	const auto duplicated_bytes =
+	    redundant_read_detector.RecordRead(filepath, location, nr_bytes, GetLatencyClockNowNs());
+	if (duplicated_bytes == 0 || !query_tag.IsValid()) {
+		return;
+	}
+	auto &shard = shards.GetLocalShard();
+	std::lock_guard<std::mutex> lck(shard.mu);
+	shard.state.query_stats_collector.GetOrCreate(query_tag).RecordDuplicatedRead(duplicated_bytes);
+}
+
+vector<RedundantReadStats> MetricsCollector::GetRedundantReads() {
+	return redundant_read_detector.GetRedundantReadStats();
+}
+
+void MetricsCollector::SetRedundantReadDetectionEnabled(bool enabled) {
+	redundant_read_detector.SetEnabled(enabled);
+}
+
+void MetricsCollector::SetRedundantReadWindow(int64_t window_sec) {
+	redundant_read_detector.SetWindowSec(window_sec);
+}
+
+CacheMissRatioCurve MetricsCollector::GetCacheMissRatioCurve() {
+	return cache_mrc_simulator.GetMissRatioCurve();
+}
+
+void MetricsCollector::SetCacheMrcEnabled(bool enabled) {
+	cache_mrc_simulator.SetEnabled(enabled);
+}
+
+void MetricsCollector::SetCacheMrcBlockSize(idx_t block_size) {
+	cache_mrc_simulator.SetBlockSize(block_size);
+}
+
+vector<QueryStats> MetricsCollector::GetQueryStats() {
+	map<idx_t, QueryStats> merged_query_stats;
+	shards.ForEachShard([&merged_query_stats](const MetricsShard &cur_shard) {
+		for (const auto &cur_query_stats : cur_shard.query_stats_collector.GetAllQueryStats()) {
+			if (cur_query_stats->request_count == 0) {
+				continue;
+			}
+			const auto query_id = cur_query_stats->query_tag.query_id;
+			auto iter = merged_query_stats.find(query_id);
+			if (iter == merged_query_stats.end()) {
+				merged_query_stats.emplace(query_id, *cur_query_stats);
+				continue;
+			}
+			iter->second.Merge(*cur_query_stats);
+		}
+	});
+
+	vector<QueryStats> query_stats;
+	query_stats.reserve(merged_query_stats.size());
+	for (auto &cur_query_stats : merged_query_stats) {
+		query_stats.emplace_back(std::move(cur_query_stats.second));
+	}
+	return query_stats;
+}
+
+vector<FileAccessStats> MetricsCollector::GetTopFiles(idx_t k, TopFilesOrder order) {
+	struct MergedFileStats {
+		FileAccessStats file_stats;
+		// Sum of min tracked count for shards which track the file.
+		uint64_t tracking_shard_min_count = 0;
+	};
+	unordered_map<string, MergedFileStats> merged_file_stats;
+	// Sum of min tracked count for all shards.
+	uint64_t total_shard_min_count = 0;
+	shards.ForEachShard([&merged_file_stats, &total_shard_min_count](const MetricsShard &cur_shard) {
+		const auto shard_min_count = cur_shard.top_files_sketch.GetMinRequestCount();
+		total_shard_min_count += shard_min_count;
+		for (const auto &cur_file_stats : cur_shard.top_files_sketch.GetAllEntries()) {
+			if (cur_file_stats->request_count == 0) {
+				continue;
+			}
+			auto iter = merged_file_stats.find(cur_file_stats->path);
+			if (iter == merged_file_stats.end()) {
+				merged_file_stats.emplace(cur_file_stats->path, MergedFileStats {*cur_file_stats, shard_min_count});
+				continue;
+			}
+			iter->second.file_stats.Merge(*cur_file_stats);
+			iter->second.tracking_shard_min_count += shard_min_count;
+		}
+	});
+
+	vector<FileAccessStats> top_files;
+	top_files.reserve(merged_file_stats.size());
+	for (auto &cur_file_stats : merged_file_stats) {
+		// Requests on shards which don't track the file are bounded by their min tracked count.
+		const auto untracked_request_bound = total_shard_min_count - cur_file_stats.second.tracking_shard_min_count;
+		cur_file_stats.second.file_stats.request_count += untracked_request_bound;
+		cur_file_stats.second.file_stats.request_count_error += untracked_request_bound;
+		top_files.emplace_back(std::move(cur_file_stats.second.file_stats));
+	}
+	// Ties are broken by path, so the result is deterministic.
+	const auto ranks_higher = [order](const FileAccessStats &lhs, const FileAccessStats &rhs) {
+		switch (order) {
+		case TopFilesOrder::kRequests:
+			if (lhs.request_count != rhs.request_count) {
+				return lhs.request_count > rhs.request_count;
+			}
+			break;
+		case TopFilesOrder::kBytes:
+			if (lhs.bytes != rhs.bytes) {
+				return lhs.bytes > rhs.bytes;
+			}
+			break;
+		case TopFilesOrder::kLatency:
+			if (lhs.total_latency_microsec != rhs.total_latency_microsec) {
+				return lhs.total_latency_microsec > rhs.total_latency_microsec;
+			}
+			break;
+		}
+		return lhs.path < rhs.path;
+	};
+	const auto top_count = std::min<idx_t>(k, top_files.size());
+	std::partial_sort(top_files.begin(), top_files.begin() + static_cast<int64_t>(top_count), top_files.end(),
+	                  ranks_higher);
+	top_files.resize(top_count);
+	return top_files;
+}
+
+vector<TimeSeriesTick> MetricsCollector::GetTimeSeries() {
+	std::lock_guard<std::mutex> sampler_lck(timeseries_sampler_mu);
+	return timeseries_sampler.GetTicks();
+}
+
+void MetricsCollector::SetTimeSeriesEnabled(bool enabled) {
+	std::lock_guard<std::mutex> sampler_lck(timeseries_sampler_mu);
+	timeseries_sampling_enabled.store(enabled, std::memory_order_relaxed);
+	// Otherwise the first sample after re-enabling would average over the whole disabled period.
+	if (!enabled) {
+		timeseries_sampler.Reset();
+		next_timeseries_sample_ns.store(0, std::memory_order_relaxed);
+	}
+}
+
 void MetricsCollector::Reset() {
-	std::lock_guard<std::mutex> lck(mu);
-	overall_latency_collector = make_uniq<OperationLatencyCollector>();
-	bucket_latency_collector.clear();
+	// Sampler lock is held while resetting shards, so no sample observes partially reset metrics.
+	std::lock_guard<std::mutex> sampler_lck(timeseries_sampler_mu);
+	shards.ForEachShard([](MetricsShard &cur_shard) { cur_shard.Reset(); });
+	overall_latency_window.Reset();
+	{
+		std::lock_guard<std::mutex> windows_lck(bucket_latency_windows_mu);
+		for (auto &cur_bucket_and_window : bucket_latency_windows) {
+			cur_bucket_and_window.second->Reset();
+		}
+	}
+	timeseries_sampler.Reset();
+	redundant_read_detector.Reset();
+	cache_mrc_simulator.Reset();
+	next_timeseries_sample_ns.store(0, std::memory_order_relaxed);
 }
 
 } // namespace duckdb
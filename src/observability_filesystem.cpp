@@ -5,13 +5,102 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "external_file_cache_stats_recorder.hpp"
+#include "observability_multi_file_list.hpp"
+#include "protected_member_accessor.hpp"
+#include "string_utils.hpp"
+#include "time_utils.hpp"
 
 namespace duckdb {
 
+namespace {
+// Get the tag for the query running in [client_context], return an invalid tag if there's no running query.
+QueryTag GetQueryTag(optional_ptr<ClientContext> client_context) {
+	QueryTag query_tag;
+	if (client_context == nullptr || !client_context->transaction.HasActiveTransaction()) {
+		return query_tag;
+	}
+	query_tag.connection_id = client_context->GetConnectionId();
+	query_tag.query_id = client_context->transaction.GetActiveQuery();
+	return query_tag;
+}
+
+QueryTag GetQueryTag(optional_ptr<FileOpener> opener) {
+	return GetQueryTag(FileOpener::TryGetClientContext(opener));
+}
+
+// Record start of an IO operation on [handle], whose latency is also accumulated into the handle's IO wait time.
+LatencyGuard RecordHandleOperationStart(MetricsCollector &metrics_collector, IoOperation io_oper,
+                                        FileHandle &handle) {
+	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
+	auto latency_guard =
+	    metrics_collector.RecordOperationStart(io_oper, handle.GetPath(), observability_file_handle.query_tag);
+	latency_guard.SetIoWaitCounter(observability_file_handle.counters.GetIoWaitCounter());
+	return latency_guard;
+}
+LatencyGuard RecordHandleOperationStart(MetricsCollector &metrics_collector, IoOperation io_oper, FileHandle &handle,
+                                        int64_t bytes) {
+	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
+	auto latency_guard =
+	    metrics_collector.RecordOperationStart(io_oper, handle.GetPath(), bytes, observability_file_handle.query_tag);
+	latency_guard.SetIoWaitCounter(observability_file_handle.counters.GetIoWaitCounter());
+	return latency_guard;
+}
+
+// Get [member] of [path] from [metadata_cache] if it's enabled and cached, otherwise invoke [fetch] and cache its
+// result. [fetch] is expected to record the operation latency, so cache hits don't skew latency stats.
+template <typename T, typename FetchFunc>
+T GetOrFetchMetadata(MetadataCache &metadata_cache, const string &path, MetadataField field,
+                     T CachedFileMetadata::*member, FetchFunc &&fetch) {
+	if (!metadata_cache.IsEnabled()) {
+		return fetch();
+	}
+	T value;
+	const auto now_ns = GetSteadyNowNanoSecSinceEpoch();
+	const auto read_cached = [&value, member](const CachedFileMetadata &metadata) { value = metadata.*member; };
+	if (metadata_cache.Lookup(path, field, now_ns, read_cached)) {
+		return value;
+	}
+	// Use timestamp before the fetch, so the cached value never outlives the TTL; and generation before the fetch, so
+	// the value is dropped if the file is modified while fetching.
+	const auto generation = metadata_cache.GetGeneration(path);
+	value = fetch();
+	const auto update_cached = [&value, member](CachedFileMetadata &metadata) { metadata.*member = value; };
+	metadata_cache.Update(path, field, now_ns, generation, update_cached);
+	return value;
+}
+} // namespace
+
 ObservabilityFileSystemHandle::ObservabilityFileSystemHandle(unique_ptr<FileHandle> internal_file_handle_p,
-                                                             ObservabilityFileSystem &fs)
+                                                             unique_ptr<FileHandle> hedge_file_handle_p,
+                                                             ObservabilityFileSystem &fs, QueryTag query_tag_p)
     : FileHandle(fs, internal_file_handle_p->GetPath(), internal_file_handle_p->GetFlags()),
-      internal_file_handle(std::move(internal_file_handle_p)) {
+      internal_file_handle(std::move(internal_file_handle_p)), hedge_file_handle(std::move(hedge_file_handle_p)),
+      query_tag(query_tag_p), counters(fs.GetLatencyClockNowNs()), observability_fs(fs) {
+}
+
+FileHandle &ObservabilityFileSystemHandle::GetInternalFileHandle(idx_t handle_idx) {
+	if (handle_idx == 0) {
+		return *internal_file_handle;
+	}
+	D_ASSERT(hedge_file_handle != nullptr);
+	return *hedge_file_handle;
+}
+
+ObservabilityFileSystemHandle::~ObservabilityFileSystemHandle() {
+	RecordLifetimeStats();
+}
+
+void ObservabilityFileSystemHandle::Close() {
+	RecordLifetimeStats();
+}
+
+void ObservabilityFileSystemHandle::RecordLifetimeStats() {
+	if (lifetime_stats_recorded) {
+		return;
+	}
+	lifetime_stats_recorded = true;
+	observability_fs.RecordHandleClose(GetPath(), counters.GetMetrics(observability_fs.GetLatencyClockNowNs()),
+	                                   access_pattern_tracker);
 }
 
 string ObservabilityFileSystem::GetName() const {
@@ -21,85 +110,319 @@ string ObservabilityFileSystem::GetName() const {
 
 void ObservabilityFileSystem::ClearObservabilityData() {
 	metrics_collector.Reset();
+	read_coalescing_stats.Reset();
+	hedged_read_stats.Reset();
+	hedged_read_policy.Reset();
+	metadata_cache.Reset();
+	listing_cache.Reset();
 }
 string ObservabilityFileSystem::GetHumanReadableStats() {
-	return metrics_collector.GetHumanReadableStats();
+	auto human_readable_stats = metrics_collector.GetHumanReadableStats();
+	const auto metadata_cache_stats = metadata_cache.GetStats();
+	if (metadata_cache_stats.hit_count + metadata_cache_stats.miss_count > 0) {
+		human_readable_stats += StringUtil::Format("\nMetadata cache: hits %d, misses %d\n",
+		                                           metadata_cache_stats.hit_count, metadata_cache_stats.miss_count);
+	}
+	const auto listing_cache_stats = listing_cache.GetStats();
+	const auto &glob_cache_stats = listing_cache_stats.glob_stats;
+	if (glob_cache_stats.hit_count + glob_cache_stats.miss_count > 0) {
+		human_readable_stats += StringUtil::Format("\nGlob cache: hits %d, misses %d, invalidations %d\n",
+		                                           glob_cache_stats.hit_count, glob_cache_stats.miss_count,
+		                                           glob_cache_stats.invalidated_entry_count);
+	}
+	const auto &list_cache_stats = listing_cache_stats.list_stats;
+	if (list_cache_stats.hit_count + list_cache_stats.miss_count > 0) {
+		human_readable_stats += StringUtil::Format("\nList cache: hits %d, misses %d, invalidations %d\n",
+		                                           list_cache_stats.hit_count, list_cache_stats.miss_count,
+		                                           list_cache_stats.invalidated_entry_count);
+	}
+	return human_readable_stats;
+}
+unique_ptr<OperationLatencyCollector> ObservabilityFileSystem::GetOverallLatencyStats() {
+	return metrics_collector.GetOverallLatencyStats();
+}
+unique_ptr<Histogram> ObservabilityFileSystem::GetRecentLatencyHistogram(IoOperation io_oper, int64_t window_sec) {
+	return metrics_collector.GetRecentLatencyHistogram(io_oper, /*bucket=*/"", window_sec);
+}
+MetricsSnapshot ObservabilityFileSystem::GetMetricsSnapshot() {
+	return metrics_collector.GetSnapshot();
+}
+vector<TimeSeriesTick> ObservabilityFileSystem::GetTimeSeries() {
+	return metrics_collector.GetTimeSeries();
+}
+void ObservabilityFileSystem::SetTimeSeriesEnabled(bool enabled) {
+	metrics_collector.SetTimeSeriesEnabled(enabled);
+}
+vector<QueryStats> ObservabilityFileSystem::GetQueryStats() {
+	return metrics_collector.GetQueryStats();
+}
+vector<FileAccessStats> ObservabilityFileSystem::GetTopFiles(idx_t k, TopFilesOrder order) {
+	return metrics_collector.GetTopFiles(k, order);
+}
+vector<RedundantReadStats> ObservabilityFileSystem::GetRedundantReads() {
+	return metrics_collector.GetRedundantReads();
+}
+void ObservabilityFileSystem::SetRedundantReadDetectionEnabled(bool enabled) {
+	metrics_collector.SetRedundantReadDetectionEnabled(enabled);
+}
+void ObservabilityFileSystem::SetRedundantReadWindow(int64_t window_sec) {
+	metrics_collector.SetRedundantReadWindow(window_sec);
+}
+CacheMissRatioCurve ObservabilityFileSystem::GetCacheMissRatioCurve() {
+	return metrics_collector.GetCacheMissRatioCurve();
+}
+void ObservabilityFileSystem::SetCacheMrcEnabled(bool enabled) {
+	metrics_collector.SetCacheMrcEnabled(enabled);
+}
+void ObservabilityFileSystem::SetCacheMrcBlockSize(idx_t block_size) {
+	metrics_collector.SetCacheMrcBlockSize(block_size);
+}
+void ObservabilityFileSystem::SetMetadataCacheEnabled(bool enabled) {
+	metadata_cache.SetEnabled(enabled);
+}
+void ObservabilityFileSystem::SetMetadataCacheTtl(int64_t ttl_sec) {
+	metadata_cache.SetTtlSec(ttl_sec);
+}
+MetadataCacheStats ObservabilityFileSystem::GetMetadataCacheStats() {
+	return metadata_cache.GetStats();
+}
+void ObservabilityFileSystem::SetListingCacheEnabled(bool enabled) {
+	listing_cache.SetEnabled(enabled);
+}
+void ObservabilityFileSystem::SetListingCacheTtl(int64_t ttl_sec) {
+	listing_cache.SetTtlSec(ttl_sec);
+}
+ListingCacheStats ObservabilityFileSystem::GetListingCacheStats() {
+	return listing_cache.GetStats();
+}
+int64_t ObservabilityFileSystem::GetHedgeThresholdNs(ObservabilityFileSystemHandle &handle) {
+	if (!hedged_read_enabled.load(std::memory_order_relaxed) || handle.hedge_file_handle == nullptr) {
+		return -1;
+	}
+	const auto now_ns = GetSteadyNowNanoSecSinceEpoch();
+	if (now_ns < handle.hedge_threshold_refresh_ns.load(std::memory_order_relaxed)) {
+		return handle.hedge_threshold_ns.load(std::memory_order_relaxed);
+	}
+	// Concurrent reads on the handle keep using the stale threshold instead of refreshing it.
+	handle.hedge_threshold_refresh_ns.store(now_ns + HedgedReadPolicy::THRESHOLD_REFRESH_INTERVAL_NS,
+	                                        std::memory_order_relaxed);
+	const auto compute_latency = [this](const string &bucket) {
+		return metrics_collector.GetRecentLatencyQuantile(IoOperation::kRead, bucket,
+		                                                  HedgedReadPolicy::HEDGE_LATENCY_QUANTILE,
+		                                                  HedgedReadPolicy::LATENCY_WINDOW_SEC,
+		                                                  HedgedReadPolicy::MIN_RECORD_COUNT);
+	};
+	const auto threshold_ns =
+	    hedged_read_policy.GetThresholdNs(GetObjectStorageBucket(handle.GetPath()), now_ns, compute_latency);
+	handle.hedge_threshold_ns.store(threshold_ns, std::memory_order_relaxed);
+	return threshold_ns;
+}
+void ObservabilityFileSystem::InvalidateCachedMetadata(const string &path) {
+	if (metadata_cache.IsEnabled()) {
+		metadata_cache.Invalidate(path);
+	}
+	if (listing_cache.IsEnabled()) {
+		listing_cache.Invalidate(path);
+	}
+}
+void ObservabilityFileSystem::RecordHandleClose(const string &filepath,
+                                                const std::array<double, kFileHandleMetricCount> &metrics,
+                                                const AccessPatternTracker &access_pattern_tracker) {
+	metrics_collector.RecordHandleClose(filepath, metrics, access_pattern_tracker);
 }
 
 void ObservabilityFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
-	GetExternalFileCacheStatsRecorder().AccessRead(handle.GetPath(), location, nr_bytes);
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kRead, handle.GetPath(), nr_bytes);
+	if (external_file_cache_stats_recorder != nullptr) {
+		external_file_cache_stats_recorder->AccessRead(handle.GetPath(), location, nr_bytes);
+	}
+	const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kRead, handle, nr_bytes);
 	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	internal_filesystem->Read(*observability_file_handle.internal_file_handle, buffer, nr_bytes, location);
+	observability_file_handle.counters.RecordRead(location, nr_bytes);
+	observability_file_handle.access_pattern_tracker.RecordRead(location, nr_bytes);
+	metrics_collector.RecordReadRange(handle.GetPath(), location, static_cast<idx_t>(nr_bytes),
+	                                  observability_file_handle.query_tag);
+	const bool read_coalescing = read_coalescing_enabled.load(std::memory_order_relaxed);
+	const int64_t hedge_threshold_ns = GetHedgeThresholdNs(observability_file_handle);
+	if (!read_coalescing && hedge_threshold_ns < 0 && !observability_file_handle.hedged_reader.HasIssuedRequest()) {
+		internal_filesystem->Read(*observability_file_handle.internal_file_handle, buffer, nr_bytes, location);
+		return;
+	}
+
+	// Hedged requests could outlive the current call, so only objects outliving the handle are referenced.
+	const HedgedReader::FetchFunc upstream_read = [this, &observability_file_handle](
+	                                                  idx_t handle_idx, char *cur_buffer, idx_t cur_nr_bytes,
+	                                                  idx_t cur_location) {
+		internal_filesystem->Read(observability_file_handle.GetInternalFileHandle(handle_idx), cur_buffer,
+		                          static_cast<int64_t>(cur_nr_bytes), cur_location);
+	};
+	// Each upstream request is hedged if enabled, including merged ones when read coalescing is enabled. Otherwise it
+	// still goes through the hedged reader, so it never shares a handle with requests of earlier hedged reads.
+	const ReadCoalescer::FetchFunc fetch = [&](char *cur_buffer, idx_t cur_nr_bytes, idx_t cur_location) {
+		auto &hedged_reader = observability_file_handle.hedged_reader;
+		if (hedge_threshold_ns < 0) {
+			hedged_reader.ReadWithoutHedging(cur_buffer, cur_nr_bytes, cur_location, upstream_read);
+			return;
+		}
+		hedged_reader.Read(cur_buffer, cur_nr_bytes, cur_location, hedge_threshold_ns, upstream_read,
+		                   hedged_read_policy, hedged_read_stats, hedged_read_executor);
+	};
+	if (!read_coalescing) {
+		fetch(static_cast<char *>(buffer), static_cast<idx_t>(nr_bytes), location);
+		return;
+	}
+	observability_file_handle.read_coalescer.Read(static_cast<char *>(buffer), static_cast<idx_t>(nr_bytes), location,
+	                                              read_coalescing_max_gap_bytes.load(std::memory_order_relaxed), fetch,
+	                                              read_coalescing_stats);
 }
 int64_t ObservabilityFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes) {
-	GetExternalFileCacheStatsRecorder().AccessRead(handle.GetPath(), handle.SeekPosition(), nr_bytes);
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kRead, handle.GetPath(), nr_bytes);
+	const auto location = handle.SeekPosition();
+	if (external_file_cache_stats_recorder != nullptr) {
+		external_file_cache_stats_recorder->AccessRead(handle.GetPath(), location, nr_bytes);
+	}
+	const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kRead, handle, nr_bytes);
 	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	return internal_filesystem->Read(*observability_file_handle.internal_file_handle, buffer, nr_bytes);
+	observability_file_handle.counters.RecordRead(location, nr_bytes);
+	observability_file_handle.access_pattern_tracker.RecordRead(location, nr_bytes);
+	metrics_collector.RecordReadRange(handle.GetPath(), location, static_cast<idx_t>(nr_bytes),
+	                                  observability_file_handle.query_tag);
+	auto &internal_file_handle = *observability_file_handle.internal_file_handle;
+	if (!observability_file_handle.hedged_reader.HasIssuedRequest()) {
+		return internal_filesystem->Read(internal_file_handle, buffer, nr_bytes);
+	}
+	// Sequential reads depend on the primary handle's position, so they wait for requests of hedged reads on it.
+	int64_t bytes_read = 0;
+	observability_file_handle.hedged_reader.RunOnPrimaryHandle(
+	    [&]() { bytes_read = internal_filesystem->Read(internal_file_handle, buffer, nr_bytes); });
+	return bytes_read;
 }
 unique_ptr<FileHandle> ObservabilityFileSystem::OpenFile(const string &path, FileOpenFlags flags,
                                                          optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kOpen, path);
-	auto file_handle = internal_filesystem->OpenFile(path, flags, opener);
+	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kOpen, path, GetQueryTag(opener));
+	return OpenAndWrapFileHandle(path, flags, opener,
+	                             [&]() { return internal_filesystem->OpenFile(path, flags, opener); });
+}
+unique_ptr<FileHandle> ObservabilityFileSystem::OpenFileExtended(const OpenFileInfo &file, FileOpenFlags flags,
+                                                                 optional_ptr<FileOpener> opener) {
+	ThrowIfDisabled();
+	const auto latency_guard =
+	    metrics_collector.RecordOperationStart(IoOperation::kOpenExtended, file.path, GetQueryTag(opener));
+	// Dispatches to the extended open of the internal filesystem, which could skip HEAD with metadata in [file].
+	return OpenAndWrapFileHandle(file.path, flags, opener,
+	                             [&]() { return internal_filesystem->OpenFile(file, flags, opener); });
+}
+bool ObservabilityFileSystem::SupportsOpenFileExtended() const {
+	return FileSystemAccessor::CallSupportsOpenFileExtended(*internal_filesystem);
+}
+unique_ptr<FileHandle>
+ObservabilityFileSystem::OpenAndWrapFileHandle(const string &path, FileOpenFlags flags, optional_ptr<FileOpener> opener,
+                                               const std::function<unique_ptr<FileHandle>()> &open) {
+	auto file_handle = open();
+	if (flags.OpenForWriting()) {
+		InvalidateCachedMetadata(path);
+	}
 	if (!file_handle) {
 		return nullptr;
 	}
-	return make_uniq<ObservabilityFileSystemHandle>(std::move(file_handle), *this);
+	// Reads on handles opened for writing are never hedged, since file content could change in between. The second
+	// handle is opened on the caller thread within the open latency, so no file is opened in background, where the
+	// opener may not be alive anymore.
+	unique_ptr<FileHandle> hedge_file_handle;
+	if (hedged_read_enabled.load(std::memory_order_relaxed) && !flags.OpenForWriting()) {
+		hedge_file_handle = open();
+	}
+	return make_uniq<ObservabilityFileSystemHandle>(std::move(file_handle), std::move(hedge_file_handle), *this,
+	                                                GetQueryTag(opener));
 }
 FileMetadata ObservabilityFileSystem::Stats(FileHandle &handle) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kStats, handle.GetPath());
-	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	return internal_filesystem->Stats(*observability_file_handle.internal_file_handle);
+	auto &internal_file_handle = *handle.Cast<ObservabilityFileSystemHandle>().internal_file_handle;
+	const auto fetch = [&]() {
+		const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kStats, handle);
+		return internal_filesystem->Stats(internal_file_handle);
+	};
+	return GetOrFetchMetadata(metadata_cache, handle.GetPath(), MetadataField::kStats, &CachedFileMetadata::stats,
+	                          fetch);
 }
 int64_t ObservabilityFileSystem::GetFileSize(FileHandle &handle) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kStats, handle.GetPath());
-	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	return internal_filesystem->GetFileSize(*observability_file_handle.internal_file_handle);
+	auto &internal_file_handle = *handle.Cast<ObservabilityFileSystemHandle>().internal_file_handle;
+	const auto fetch = [&]() {
+		const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kStats, handle);
+		return internal_filesystem->GetFileSize(internal_file_handle);
+	};
+	return GetOrFetchMetadata(metadata_cache, handle.GetPath(), MetadataField::kFileSize,
+	                          &CachedFileMetadata::file_size, fetch);
 }
 timestamp_t ObservabilityFileSystem::GetLastModifiedTime(FileHandle &handle) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kStats, handle.GetPath());
-	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	return internal_filesystem->GetLastModifiedTime(*observability_file_handle.internal_file_handle);
+	auto &internal_file_handle = *handle.Cast<ObservabilityFileSystemHandle>().internal_file_handle;
+	const auto fetch = [&]() {
+		const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kStats, handle);
+		return internal_filesystem->GetLastModifiedTime(internal_file_handle);
+	};
+	return GetOrFetchMetadata(metadata_cache, handle.GetPath(), MetadataField::kLastModifiedTime,
+	                          &CachedFileMetadata::last_modified_time, fetch);
 }
 string ObservabilityFileSystem::GetVersionTag(FileHandle &handle) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kStats, handle.GetPath());
-	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	return internal_filesystem->GetVersionTag(*observability_file_handle.internal_file_handle);
+	auto &internal_file_handle = *handle.Cast<ObservabilityFileSystemHandle>().internal_file_handle;
+	const auto fetch = [&]() {
+		const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kStats, handle);
+		return internal_filesystem->GetVersionTag(internal_file_handle);
+	};
+	return GetOrFetchMetadata(metadata_cache, handle.GetPath(), MetadataField::kVersionTag,
+	                          &CachedFileMetadata::version_tag, fetch);
 }
 bool ObservabilityFileSystem::FileExists(const string &filename, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kStats, filename);
-	return internal_filesystem->FileExists(filename, opener);
+	const auto fetch = [&]() {
+		const auto latency_guard =
+		    metrics_collector.RecordOperationStart(IoOperation::kStats, filename, GetQueryTag(opener));
+		return internal_filesystem->FileExists(filename, opener);
+	};
+	return GetOrFetchMetadata(metadata_cache, filename, MetadataField::kFileExists, &CachedFileMetadata::file_exists,
+	                          fetch);
 }
 FileType ObservabilityFileSystem::GetFileType(FileHandle &handle) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kStats, handle.GetPath());
-	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	return internal_filesystem->GetFileType(*observability_file_handle.internal_file_handle);
+	auto &internal_file_handle = *handle.Cast<ObservabilityFileSystemHandle>().internal_file_handle;
+	const auto fetch = [&]() {
+		const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kStats, handle);
+		return internal_filesystem->GetFileType(internal_file_handle);
+	};
+	return GetOrFetchMetadata(metadata_cache, handle.GetPath(), MetadataField::kFileType,
+	                          &CachedFileMetadata::file_type, fetch);
 }
 unique_ptr<FileHandle> ObservabilityFileSystem::OpenCompressedFile(QueryContext context, unique_ptr<FileHandle> handle,
                                                                    bool write) {
+	// Handles opened without a file opener don't know their query, which is available from the query context.
+	if (&handle->file_system == this) {
+		auto &observability_file_handle = handle->Cast<ObservabilityFileSystemHandle>();
+		if (!observability_file_handle.query_tag.IsValid()) {
+			observability_file_handle.query_tag = GetQueryTag(context.GetClientContext());
+		}
+	}
 	return internal_filesystem->OpenCompressedFile(std::move(context), std::move(handle), write);
 }
 void ObservabilityFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kWrite, handle.GetPath(), nr_bytes);
+	const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kWrite, handle, nr_bytes);
 	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
 	internal_filesystem->Write(*observability_file_handle.internal_file_handle, buffer, nr_bytes, location);
+	InvalidateCachedMetadata(handle.GetPath());
 }
 int64_t ObservabilityFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kWrite, handle.GetPath(), nr_bytes);
+	const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kWrite, handle, nr_bytes);
 	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
-	return internal_filesystem->Write(*observability_file_handle.internal_file_handle, buffer, nr_bytes);
+	const auto bytes_written =
+	    internal_filesystem->Write(*observability_file_handle.internal_file_handle, buffer, nr_bytes);
+	InvalidateCachedMetadata(handle.GetPath());
+	return bytes_written;
 }
 void ObservabilityFileSystem::FileSync(FileHandle &handle) {
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kFileSync, handle.GetPath());
+	const auto latency_guard = RecordHandleOperationStart(metrics_collector, IoOperation::kFileSync, handle);
 	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
 	internal_filesystem->FileSync(*observability_file_handle.internal_file_handle);
 }
 void ObservabilityFileSystem::Truncate(FileHandle &handle, int64_t new_size) {
 	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
 	internal_filesystem->Truncate(*observability_file_handle.internal_file_handle, new_size);
+	InvalidateCachedMetadata(handle.GetPath());
 }
 bool ObservabilityFileSystem::DirectoryExists(const string &directory, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
@@ -108,47 +431,146 @@ bool ObservabilityFileSystem::DirectoryExists(const string &directory, optional_
 void ObservabilityFileSystem::CreateDirectory(const string &directory, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
 	internal_filesystem->CreateDirectory(directory, opener);
+	InvalidateCachedMetadata(directory);
 }
 void ObservabilityFileSystem::CreateDirectoriesRecursive(const string &path, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
 	internal_filesystem->CreateDirectoriesRecursive(path, opener);
+	// Cached listings covering the path are dropped as well, which includes all intermediate directories created.
+	InvalidateCachedMetadata(path);
 }
 void ObservabilityFileSystem::RemoveDirectory(const string &directory, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
 	internal_filesystem->RemoveDirectory(directory, opener);
+	InvalidateCachedMetadata(directory);
 }
 bool ObservabilityFileSystem::ListFiles(const string &directory,
                                         const std::function<void(const string &, bool)> &callback, FileOpener *opener) {
 	ThrowIfDisabled();
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kList, directory);
-	return internal_filesystem->ListFiles(directory, callback, opener);
+	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kList, directory,
+	                                                                  GetQueryTag(opener));
+	if (!listing_cache.IsEnabled()) {
+		return internal_filesystem->ListFiles(directory, callback, opener);
+	}
+
+	const auto now_ns = GetSteadyNowNanoSecSinceEpoch();
+	vector<ListedFile> listed_files;
+	bool listed = false;
+	if (listing_cache.LookupList(directory, now_ns, listed_files, listed)) {
+		for (const auto &cur_file : listed_files) {
+			callback(cur_file.name, cur_file.is_directory);
+		}
+		return listed;
+	}
+	const auto generation = listing_cache.GetGeneration();
+	listed = internal_filesystem->ListFiles(
+	    directory,
+	    [&listed_files, &callback](const string &name, bool is_directory) {
+		    listed_files.emplace_back(ListedFile {name, is_directory});
+		    callback(name, is_directory);
+	    },
+	    opener);
+	listing_cache.UpdateList(directory, now_ns, generation, listed_files, listed);
+	return listed;
+}
+bool ObservabilityFileSystem::ListFilesExtended(const string &directory,
+                                                const std::function<void(OpenFileInfo &info)> &callback,
+                                                optional_ptr<FileOpener> opener) {
+	ThrowIfDisabled();
+	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kListExtended, directory,
+	                                                                  GetQueryTag(opener));
+	// Dispatches to the extended list of the internal filesystem, which passes metadata returned by listing.
+	if (!listing_cache.IsEnabled()) {
+		return internal_filesystem->ListFiles(directory, callback, opener);
+	}
+
+	const auto now_ns = GetSteadyNowNanoSecSinceEpoch();
+	vector<OpenFileInfo> listed_files;
+	bool listed = false;
+	if (listing_cache.LookupListExtended(directory, now_ns, listed_files, listed)) {
+		for (auto &cur_file : listed_files) {
+			callback(cur_file);
+		}
+		return listed;
+	}
+	const auto generation = listing_cache.GetGeneration();
+	listed = internal_filesystem->ListFiles(
+	    directory,
+	    [&listed_files, &callback](OpenFileInfo &info) {
+		    // Copy before invoking the callback, which could move out of [info].
+		    listed_files.emplace_back(info);
+		    callback(info);
+	    },
+	    opener);
+	listing_cache.UpdateListExtended(directory, now_ns, generation, listed_files, listed);
+	return listed;
+}
+bool ObservabilityFileSystem::SupportsListFilesExtended() const {
+	return FileSystemAccessor::CallSupportsListFilesExtended(*internal_filesystem);
 }
 void ObservabilityFileSystem::MoveFile(const string &source, const string &target, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
 	internal_filesystem->MoveFile(source, target, opener);
+	InvalidateCachedMetadata(source);
+	InvalidateCachedMetadata(target);
 }
 void ObservabilityFileSystem::RemoveFile(const string &filename, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kRemoveFile, filename);
+	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kRemoveFile, filename,
+	                                                                  GetQueryTag(opener));
 	internal_filesystem->RemoveFile(filename, opener);
+	InvalidateCachedMetadata(filename);
 }
 bool ObservabilityFileSystem::TryRemoveFile(const string &filename, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kRemoveFile, filename);
-	return internal_filesystem->TryRemoveFile(filename, opener);
+	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kRemoveFile, filename,
+	                                                                  GetQueryTag(opener));
+	const bool removed = internal_filesystem->TryRemoveFile(filename, opener);
+	InvalidateCachedMetadata(filename);
+	return removed;
 }
 void ObservabilityFileSystem::RemoveFiles(const vector<string> &filenames, optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
 	internal_filesystem->RemoveFiles(filenames, opener);
+	for (const auto &cur_filename : filenames) {
+		InvalidateCachedMetadata(cur_filename);
+	}
 }
 vector<OpenFileInfo> ObservabilityFileSystem::Glob(const string &path, FileOpener *opener) {
+	return GlobFilesExtended(path, FileGlobOptions::ALLOW_EMPTY, opener)->GetAllFiles();
+}
+unique_ptr<MultiFileList> ObservabilityFileSystem::GlobFilesExtended(const string &path, const FileGlobInput &input,
+                                                                     optional_ptr<FileOpener> opener) {
 	ThrowIfDisabled();
-	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kGlob, path);
-	auto result = internal_filesystem->Glob(path, FileGlobOptions::ALLOW_EMPTY, opener);
-	return result->GetAllFiles();
+	const auto query_tag = GetQueryTag(opener);
+	if (!listing_cache.IsEnabled()) {
+		unique_ptr<MultiFileList> internal_file_list;
+		{
+			// Later expansions are recorded per listing page by the file list.
+			const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kGlob, path, query_tag);
+			internal_file_list = internal_filesystem->Glob(path, input, opener);
+		}
+		return make_uniq<ObservabilityMultiFileList>(std::move(internal_file_list), path, input, metrics_collector,
+		                                             query_tag);
+	}
+
+	// Cached results have to be complete, so the listing is materialized.
+	const auto latency_guard = metrics_collector.RecordOperationStart(IoOperation::kGlob, path, query_tag);
+	const auto now_ns = GetSteadyNowNanoSecSinceEpoch();
+	vector<OpenFileInfo> files;
+	if (!listing_cache.LookupGlob(path, now_ns, files)) {
+		const auto generation = listing_cache.GetGeneration();
+		files = internal_filesystem->Glob(path, input, opener)->GetAllFiles();
+		// Empty result is not cached, since whether it's allowed depends on glob options.
+		if (!files.empty()) {
+			listing_cache.UpdateGlob(path, now_ns, generation, files);
+		}
+	}
+	return make_uniq<SimpleMultiFileList>(std::move(files));
 }
 void ObservabilityFileSystem::Seek(FileHandle &handle, idx_t location) {
 	auto &observability_file_handle = handle.Cast<ObservabilityFileSystemHandle>();
+	observability_file_handle.counters.RecordSeek();
 	internal_filesystem->Seek(*observability_file_handle.internal_file_handle, location);
 }
 void ObservabilityFileSystem::Reset(FileHandle &handle) {
@@ -0,0 +1,73 @@
+#include "observability_multi_file_list.hpp"
+
+#include "protected_member_accessor.hpp"
+
+namespace duckdb {
+
+ObservabilityMultiFileList::ObservabilityMultiFileList(unique_ptr<MultiFileList> internal_file_list_p,
+                                                       const string &pattern_p, const FileGlobInput &glob_input_p,
+                                                       MetricsCollector &metrics_collector_p, QueryTag query_tag_p)
+    : MultiFileList(vector<OpenFileInfo> {OpenFileInfo(pattern_p)}, glob_input_p),
+      internal_file_list(std::move(internal_file_list_p)), pattern(pattern_p), metrics_collector(metrics_collector_p),
+      query_tag(query_tag_p) {
+}
+
+LatencyGuard ObservabilityMultiFileList::RecordExpansionStart() {
+	return metrics_collector.RecordOperationStart(IoOperation::kGlob, pattern, query_tag);
+}
+
+bool ObservabilityMultiFileList::RequiresExpansion() {
+	if (fully_expanded.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	// Files are expanded in order, so there's more to fetch if the file after the scanned ones isn't available.
+	return !FileIsAvailable(scanned_file_count.load(std::memory_order_relaxed));
+}
+
+vector<OpenFileInfo> ObservabilityMultiFileList::GetAllFiles() {
+	if (!RequiresExpansion()) {
+		return internal_file_list->GetAllFiles();
+	}
+	const auto latency_guard = RecordExpansionStart();
+	auto files = internal_file_list->GetAllFiles();
+	fully_expanded.store(true, std::memory_order_relaxed);
+	return files;
+}
+
+FileExpandResult ObservabilityMultiFileList::GetExpandResult() {
+	// Expand result is decided by the first few files, which are fetched with the first page.
+	if (fully_expanded.load(std::memory_order_relaxed) || FileIsAvailable(0)) {
+		return internal_file_list->GetExpandResult();
+	}
+	const auto latency_guard = RecordExpansionStart();
+	return internal_file_list->GetExpandResult();
+}
+
+idx_t ObservabilityMultiFileList::GetTotalFileCount() {
+	if (!RequiresExpansion()) {
+		return internal_file_list->GetTotalFileCount();
+	}
+	const auto latency_guard = RecordExpansionStart();
+	const auto file_count = internal_file_list->GetTotalFileCount();
+	fully_expanded.store(true, std::memory_order_relaxed);
+	return file_count;
+}
+
+bool ObservabilityMultiFileList::FileIsAvailable(idx_t i) {
+	return MultiFileListAccessor::CallFileIsAvailable(*internal_file_list, i);
+}
+
+OpenFileInfo ObservabilityMultiFileList::GetFile(idx_t i) {
+	idx_t scanned_count = scanned_file_count.load(std::memory_order_relaxed);
+	while (scanned_count < i + 1 &&
+	       !scanned_file_count.compare_exchange_weak(scanned_count, i + 1, std::memory_order_relaxed)) {
+	}
+	// Files already expanded are served without IO.
+	if (fully_expanded.load(std::memory_order_relaxed) || FileIsAvailable(i)) {
+		return MultiFileListAccessor::CallGetFile(*internal_file_list, i);
+	}
+	const auto latency_guard = RecordExpansionStart();
+	return MultiFileListAccessor::CallGetFile(*internal_file_list, i);
+}
+
+} // namespace duckdb
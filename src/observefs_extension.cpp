@@ -1,5 +1,8 @@
 #define DUCKDB_EXTENSION_MAIN
 
+#include "access_patterns_query_function.hpp"
+#include "cache_mrc_query_function.hpp"
+#include "cache_mrc_simulator.hpp"
 #include "duckdb.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/helper.hpp"
@@ -12,12 +15,26 @@
 #include "fake_filesystem.hpp"
 #include "filesystem_ref_registry.hpp"
 #include "filesystem_status_query_function.hpp"
+#include "handle_stats_query_function.hpp"
+#include "hedged_reads_query_function.hpp"
 #include "hffs.hpp"
+#include "histogram_buckets_query_function.hpp"
 #include "httpfs_extension.hpp"
+#include "io_operation.hpp"
+#include "metadata_cache_query_function.hpp"
 #include "observefs_extension.hpp"
 #include "observefs_instance_state.hpp"
 #include "observability_filesystem.hpp"
+#include "query_stats_query_function.hpp"
+#include "read_coalescing_query_function.hpp"
+#include "redundant_read_detector.hpp"
+#include "redundant_reads_query_function.hpp"
+#include "rolling_histogram.hpp"
 #include "s3fs.hpp"
+#include "stats_query_function.hpp"
+#include "time_utils.hpp"
+#include "timeseries_query_function.hpp"
+#include "top_files_query_function.hpp"
 
 namespace duckdb {
 
@@ -27,6 +44,11 @@ namespace {
 constexpr const char *HTTPFS_EXTENSION = "httpfs";
 // Indicates successful query.
 constexpr bool SUCCESS = true;
+// Latency clock source options.
+constexpr const char *STEADY_CLOCK_SOURCE = "steady";
+constexpr const char *TSC_CLOCK_SOURCE = "tsc";
+// Filesystem name which matches all observability filesystems.
+constexpr const char *ALL_FILESYSTEMS = "*";
 
 // Get database instance from expression state.
 // Returned instance ownership lies in the given [`state`].
@@ -66,6 +88,94 @@ void GetProfileStats(const DataChunk &args, ExpressionState &state, Vector &resu
 	result.Reference(Value(std::move(latest_stat)));
 }
 
+// Whether the observability filesystem matches the requested name, either wrapped or internal filesystem name.
+bool MatchFileSystemName(ObservabilityFileSystem &observefs, const string &filesystem_name) {
+	if (filesystem_name == ALL_FILESYSTEMS) {
+		return true;
+	}
+	return observefs.GetName() == filesystem_name || observefs.GetInternalFileSystem()->GetName() == filesystem_name;
+}
+
+// Get latency quantile for the given filesystem and IO operation, latency from all matched filesystems are merged.
+// An optional fourth argument limits records to the last given seconds.
+// Example usage:
+// D. SELECT observefs_quantile('HTTPFileSystem', 'read', 0.999);
+// -- p99 read latency over the last minute.
+// D. SELECT observefs_quantile('HTTPFileSystem', 'read', 0.99, 60);
+void GetLatencyQuantile(DataChunk &args, ExpressionState &state, Vector &result) {
+	D_ASSERT(args.ColumnCount() == 3 || args.ColumnCount() == 4);
+	const bool has_window = args.ColumnCount() == 4;
+	auto &duckdb_instance = GetDatabaseInstance(state);
+	auto &instance_state = GetInstanceStateOrThrow(duckdb_instance);
+	const auto observefs_instances = instance_state.registry.GetAllObservabilityFs();
+
+	for (idx_t row_idx = 0; row_idx < args.size(); ++row_idx) {
+		const auto filesystem_value = args.GetValue(/*col_idx=*/0, row_idx);
+		const auto operation_value = args.GetValue(/*col_idx=*/1, row_idx);
+		const auto quantile_value = args.GetValue(/*col_idx=*/2, row_idx);
+		const auto window_value = has_window ? args.GetValue(/*col_idx=*/3, row_idx) : Value::BIGINT(0);
+		if (filesystem_value.IsNull() || operation_value.IsNull() || quantile_value.IsNull() || window_value.IsNull()) {
+			result.SetValue(row_idx, Value(LogicalType {LogicalTypeId::DOUBLE}));
+			continue;
+		}
+
+		const auto filesystem_name = filesystem_value.ToString();
+		const auto operation_name = StringUtil::Lower(operation_value.ToString());
+		const auto io_oper = GetIoOperation(operation_name);
+		if (io_oper == IoOperation::kUnknown) {
+			throw InvalidInputException("Unknown IO operation %s, valid options are %s", operation_name,
+			                            StringUtil::Join(vector<string>(OPER_NAMES.begin(), OPER_NAMES.end()), ", "));
+		}
+		const auto quantile = quantile_value.GetValue<double>();
+		if (quantile < 0.0 || quantile > 1.0) {
+			throw InvalidInputException("Quantile should be within [0, 1], but got %lf", quantile);
+		}
+		const auto window_sec = window_value.GetValue<int64_t>();
+		if (has_window && (window_sec <= 0 || window_sec > RollingHistogram::GetMaxWindowSec())) {
+			throw InvalidInputException("Window should be within (0, %d] seconds, but got %d",
+			                            RollingHistogram::GetMaxWindowSec(), window_sec);
+		}
+
+		OperationLatencyCollector merged_latency_collector;
+		Histogram merged_window_histogram {RollingHistogram::SUB_BUCKET_BITS};
+		bool filesystem_found = false;
+		for (auto *cur_filesystem : observefs_instances) {
+			if (!MatchFileSystemName(*cur_filesystem, filesystem_name)) {
+				continue;
+			}
+			filesystem_found = true;
+			if (has_window) {
+				merged_window_histogram.Merge(*cur_filesystem->GetRecentLatencyHistogram(io_oper, window_sec));
+			} else {
+				merged_latency_collector.Merge(*cur_filesystem->GetOverallLatencyStats());
+			}
+		}
+		if (!filesystem_found) {
+			throw InvalidInputException("Filesystem %s hasn't been wrapped by observefs!", filesystem_name);
+		}
+
+		if (has_window) {
+			if (merged_window_histogram.counts() == 0) {
+				result.SetValue(row_idx, Value(LogicalType {LogicalTypeId::DOUBLE}));
+				continue;
+			}
+			result.SetValue(row_idx, Value::DOUBLE(merged_window_histogram.Quantile(quantile)));
+			continue;
+		}
+
+		const auto &quantile_estimator = merged_latency_collector.GetQuantileEstimator(io_oper);
+		if (quantile_estimator.Count() == 0) {
+			result.SetValue(row_idx, Value(LogicalType {LogicalTypeId::DOUBLE}));
+			continue;
+		}
+		result.SetValue(row_idx, Value::DOUBLE(quantile_estimator.Quantile(quantile)));
+	}
+
+	if (args.AllConstant()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
 // Wrap the filesystem with extension cache filesystem.
 // Throw exception if the requested filesystem hasn't been registered into duckdb instance.
 void WrapFileSystem(const DataChunk &args, ExpressionState &state, Vector &result) {
@@ -81,16 +191,50 @@ void WrapFileSystem(const DataChunk &args, ExpressionState &state, Vector &resul
 		throw InvalidInputException("Filesystem %s hasn't been registered yet!", filesystem_name);
 	}
 
-	auto observe_filesystem = make_uniq<ObservabilityFileSystem>(std::move(internal_filesystem), vfs);
 	auto &instance_state = GetInstanceStateOrThrow(duckdb_instance);
+	auto observe_filesystem = make_uniq<ObservabilityFileSystem>(std::move(internal_filesystem), vfs,
+	                                                             instance_state.external_file_cache_stats_recorder);
+	observe_filesystem->SetLatencyClockSource(instance_state.latency_clock_source.load());
+	observe_filesystem->SetTimeSeriesEnabled(instance_state.timeseries_enabled.load());
+	observe_filesystem->SetRedundantReadWindow(instance_state.redundant_read_window_sec.load());
+	observe_filesystem->SetRedundantReadDetectionEnabled(instance_state.redundant_read_detection_enabled.load());
+	observe_filesystem->SetCacheMrcBlockSize(instance_state.cache_mrc_block_size.load());
+	observe_filesystem->SetCacheMrcEnabled(instance_state.cache_mrc_enabled.load());
+	observe_filesystem->SetReadCoalescing(instance_state.read_coalescing_enabled.load(),
+	                                      instance_state.read_coalescing_max_gap_bytes.load());
+	observe_filesystem->SetHedgedReads(instance_state.hedged_read_enabled.load(),
+	                                   instance_state.hedged_read_budget_percent.load());
+	observe_filesystem->SetMetadataCacheTtl(instance_state.metadata_cache_ttl_sec.load());
+	observe_filesystem->SetMetadataCacheEnabled(instance_state.metadata_cache_enabled.load());
+	observe_filesystem->SetListingCacheTtl(instance_state.listing_cache_ttl_sec.load());
+	observe_filesystem->SetListingCacheEnabled(instance_state.listing_cache_enabled.load());
 	instance_state.registry.Register(observe_filesystem.get());
 	vfs.RegisterSubSystem(std::move(observe_filesystem));
 
 	result.Reference(Value(SUCCESS));
 }
 
+// Apply read coalescing settings to all registered filesystems.
+void ApplyReadCoalescingSettings(ObservefsInstanceState &instance_state) {
+	const bool enabled = instance_state.read_coalescing_enabled.load();
+	const idx_t max_gap_bytes = instance_state.read_coalescing_max_gap_bytes.load();
+	for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+		cur_filesystem->SetReadCoalescing(enabled, max_gap_bytes);
+	}
+}
+
+// Apply hedged read settings to all registered filesystems.
+void ApplyHedgedReadSettings(ObservefsInstanceState &instance_state) {
+	const bool enabled = instance_state.hedged_read_enabled.load();
+	const idx_t budget_percent = instance_state.hedged_read_budget_percent.load();
+	for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+		cur_filesystem->SetHedgedReads(enabled, budget_percent);
+	}
+}
+
 void ClearExternalFileCacheStatsRecord(DataChunk &args, ExpressionState &state, Vector &result) {
-	GetExternalFileCacheStatsRecorder().ClearCacheAccessRecord();
+	auto &instance_state = GetInstanceStateOrThrow(GetDatabaseInstance(state));
+	instance_state.external_file_cache_stats_recorder->ClearCacheAccessRecord();
 	result.Reference(Value(SUCCESS));
 }
 
@@ -175,11 +319,10 @@ void LoadInternal(ExtensionLoader &loader) {
 	EnsureHttpfsExtensionLoaded(loader, duckdb_instance);
 
 	auto instance_state = make_shared_ptr<ObservefsInstanceState>();
+	instance_state->external_file_cache_stats_recorder =
+	    make_shared_ptr<ExternalFileCacheStatsRecorder>(ExternalFileCache::Get(duckdb_instance));
 	SetInstanceState(duckdb_instance, instance_state);
 
-	auto &external_file_cache = ExternalFileCache::Get(duckdb_instance);
-	InitOrResetExternalFileCache(external_file_cache);
-
 	// TODO(hjiang): Register a fake filesystem at extension load for testing purpose. This is not ideal since
 	// additional necessary instance is shipped in the extension. Local filesystem is not viable because it's not
 	// registered in virtual filesystem. A better approach is find another filesystem not in httpfs extension.
@@ -189,35 +332,241 @@ void LoadInternal(ExtensionLoader &loader) {
 	//
 	// Register http filesystem.
 	auto http_fs = ExtractOrCreateHttpfs(vfs);
-	auto observability_httpfs_filesystem = make_uniq<ObservabilityFileSystem>(std::move(http_fs), vfs);
+	auto observability_httpfs_filesystem = make_uniq<ObservabilityFileSystem>(
+	    std::move(http_fs), vfs, instance_state->external_file_cache_stats_recorder);
 	instance_state->registry.Register(observability_httpfs_filesystem.get());
 	vfs.RegisterSubSystem(std::move(observability_httpfs_filesystem));
 
 	// Register hugging filesystem.
 	auto hf_fs = ExtractOrCreateHuggingfs(vfs);
-	auto observability_hf_filesystem = make_uniq<ObservabilityFileSystem>(std::move(hf_fs), vfs);
+	auto observability_hf_filesystem = make_uniq<ObservabilityFileSystem>(
+	    std::move(hf_fs), vfs, instance_state->external_file_cache_stats_recorder);
 	instance_state->registry.Register(observability_hf_filesystem.get());
 	vfs.RegisterSubSystem(std::move(observability_hf_filesystem));
 
 	// Register s3 filesystem.
 	auto s3_fs = ExtractOrCreateS3fs(vfs, duckdb_instance);
-	auto observability_s3_filesystem = make_uniq<ObservabilityFileSystem>(std::move(s3_fs), vfs);
+	auto observability_s3_filesystem = make_uniq<ObservabilityFileSystem>(
+	    std::move(s3_fs), vfs, instance_state->external_file_cache_stats_recorder);
 	instance_state->registry.Register(observability_s3_filesystem.get());
 	vfs.RegisterSubSystem(std::move(observability_s3_filesystem));
 	auto &config = DBConfig::GetConfig(duckdb_instance);
 
 	auto enable_external_file_cache_stats_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
 		const auto to_enable = parameter.GetValue<bool>();
+		auto &recorder = *GetInstanceStateOrThrow(*context.db).external_file_cache_stats_recorder;
 		if (to_enable) {
-			GetExternalFileCacheStatsRecorder().Enable();
+			recorder.Enable();
 		} else {
-			GetExternalFileCacheStatsRecorder().Disable();
+			recorder.Disable();
 		}
 	};
 	config.AddExtensionOption(
 	    "observefs_enable_external_file_cache_stats", "Whether to enable stats record for external file cache.",
 	    LogicalType {LogicalTypeId::BOOLEAN}, true, std::move(enable_external_file_cache_stats_callback));
 
+	auto latency_clock_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto clock_source_str = StringUtil::Lower(parameter.ToString());
+		LatencyClockSource clock_source = LatencyClockSource::kSteadyClock;
+		if (clock_source_str == TSC_CLOCK_SOURCE) {
+			if (!IsTscClockSupported()) {
+				throw InvalidInputException("Latency clock source %s is not supported on the current platform",
+				                            clock_source_str);
+			}
+			clock_source = LatencyClockSource::kTsc;
+		} else if (clock_source_str != STEADY_CLOCK_SOURCE) {
+			throw InvalidInputException("Unknown latency clock source %s, valid options are '%s' and '%s'",
+			                            clock_source_str, STEADY_CLOCK_SOURCE, TSC_CLOCK_SOURCE);
+		}
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.latency_clock_source.store(clock_source);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetLatencyClockSource(clock_source);
+		}
+	};
+	config.AddExtensionOption("observefs_latency_clock",
+	                          "Clock source to measure IO latency, either 'steady' (default) or 'tsc'.",
+	                          LogicalType {LogicalTypeId::VARCHAR}, Value(STEADY_CLOCK_SOURCE),
+	                          std::move(latency_clock_callback));
+
+	auto enable_timeseries_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto to_enable = parameter.GetValue<bool>();
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.timeseries_enabled.store(to_enable);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetTimeSeriesEnabled(to_enable);
+		}
+	};
+	config.AddExtensionOption("observefs_enable_timeseries",
+	                          "Whether to sample per-second throughput and latency, see observefs_timeseries().",
+	                          LogicalType {LogicalTypeId::BOOLEAN}, false, std::move(enable_timeseries_callback));
+
+	auto enable_redundant_read_detection_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto to_enable = parameter.GetValue<bool>();
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.redundant_read_detection_enabled.store(to_enable);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetRedundantReadDetectionEnabled(to_enable);
+		}
+	};
+	config.AddExtensionOption(
+	    "observefs_enable_redundant_read_detection",
+	    "Whether to detect reads on overlapping byte ranges of the same file, see observefs_redundant_reads().",
+	    LogicalType {LogicalTypeId::BOOLEAN}, false, std::move(enable_redundant_read_detection_callback));
+
+	auto redundant_read_window_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto window_sec = parameter.GetValue<int64_t>();
+		if (window_sec <= 0) {
+			throw InvalidInputException("Redundant read window should be positive, but got %d seconds", window_sec);
+		}
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.redundant_read_window_sec.store(window_sec);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetRedundantReadWindow(window_sec);
+		}
+	};
+	config.AddExtensionOption(
+	    "observefs_redundant_read_window_sec",
+	    "Window in seconds within which reads on overlapping byte ranges of the same file are considered redundant.",
+	    LogicalType {LogicalTypeId::BIGINT}, Value::BIGINT(RedundantReadDetector::DEFAULT_WINDOW_SEC),
+	    std::move(redundant_read_window_callback));
+
+	auto enable_cache_mrc_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto to_enable = parameter.GetValue<bool>();
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.cache_mrc_enabled.store(to_enable);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetCacheMrcEnabled(to_enable);
+		}
+	};
+	config.AddExtensionOption("observefs_enable_cache_mrc",
+	                          "Whether to simulate block caches over recorded reads, see observefs_cache_mrc().",
+	                          LogicalType {LogicalTypeId::BOOLEAN}, false, std::move(enable_cache_mrc_callback));
+
+	auto cache_mrc_block_size_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto block_size = parameter.GetValue<int64_t>();
+		if (block_size <= 0) {
+			throw InvalidInputException("Cache simulation block size should be positive, but got %d bytes", block_size);
+		}
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.cache_mrc_block_size.store(static_cast<idx_t>(block_size));
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetCacheMrcBlockSize(static_cast<idx_t>(block_size));
+		}
+	};
+	config.AddExtensionOption(
+	    "observefs_cache_mrc_block_size", "Block size in bytes for cache simulation, which resets simulated caches.",
+	    LogicalType {LogicalTypeId::BIGINT}, Value::BIGINT(static_cast<int64_t>(CacheMrcSimulator::DEFAULT_BLOCK_SIZE)),
+	    std::move(cache_mrc_block_size_callback));
+
+	auto enable_read_coalescing_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.read_coalescing_enabled.store(parameter.GetValue<bool>());
+		ApplyReadCoalescingSettings(instance_state);
+	};
+	config.AddExtensionOption("observefs_enable_read_coalescing",
+	                          "Whether to merge nearby positional reads queued on the same file handle into one "
+	                          "upstream request, see observefs_read_coalescing().",
+	                          LogicalType {LogicalTypeId::BOOLEAN}, false, std::move(enable_read_coalescing_callback));
+
+	auto read_coalescing_max_gap_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto max_gap_bytes = parameter.GetValue<int64_t>();
+		if (max_gap_bytes < 0) {
+			throw InvalidInputException("Read coalescing max gap should be non-negative, but got %d bytes",
+			                            max_gap_bytes);
+		}
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.read_coalescing_max_gap_bytes.store(static_cast<idx_t>(max_gap_bytes));
+		ApplyReadCoalescingSettings(instance_state);
+	};
+	config.AddExtensionOption(
+	    "observefs_read_coalescing_max_gap_bytes", "Max gap in bytes between two reads to merge them.",
+	    LogicalType {LogicalTypeId::BIGINT},
+	    Value::BIGINT(static_cast<int64_t>(ObservefsInstanceState::DEFAULT_READ_COALESCING_MAX_GAP_BYTES)),
+	    std::move(read_coalescing_max_gap_callback));
+
+	auto enable_hedged_reads_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.hedged_read_enabled.store(parameter.GetValue<bool>());
+		ApplyHedgedReadSettings(instance_state);
+	};
+	config.AddExtensionOption("observefs_enable_hedged_reads",
+	                          "Whether to issue a duplicate request for positional reads slower than the recent p95 "
+	                          "latency of their bucket, see observefs_hedged_reads().",
+	                          LogicalType {LogicalTypeId::BOOLEAN}, false, std::move(enable_hedged_reads_callback));
+
+	auto hedged_read_budget_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto budget_percent = parameter.GetValue<int64_t>();
+		if (budget_percent < 0 || budget_percent > 100) {
+			throw InvalidInputException("Hedged read budget should be within [0, 100] percent, but got %d",
+			                            budget_percent);
+		}
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.hedged_read_budget_percent.store(static_cast<idx_t>(budget_percent));
+		ApplyHedgedReadSettings(instance_state);
+	};
+	config.AddExtensionOption(
+	    "observefs_hedged_read_budget_percent", "Max number of duplicate requests, in percentage of eligible reads.",
+	    LogicalType {LogicalTypeId::BIGINT},
+	    Value::BIGINT(static_cast<int64_t>(HedgedReadPolicy::DEFAULT_BUDGET_PERCENT)),
+	    std::move(hedged_read_budget_callback));
+
+	auto enable_metadata_cache_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto to_enable = parameter.GetValue<bool>();
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.metadata_cache_enabled.store(to_enable);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetMetadataCacheEnabled(to_enable);
+		}
+	};
+	config.AddExtensionOption("observefs_enable_metadata_cache",
+	                          "Whether to cache results of metadata calls (e.g. file size, last modification time and "
+	                          "existence), see observefs_metadata_cache().",
+	                          LogicalType {LogicalTypeId::BOOLEAN}, false, std::move(enable_metadata_cache_callback));
+
+	auto metadata_cache_ttl_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto ttl_sec = parameter.GetValue<int64_t>();
+		if (ttl_sec <= 0) {
+			throw InvalidInputException("Metadata cache TTL should be positive, but got %d seconds", ttl_sec);
+		}
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.metadata_cache_ttl_sec.store(ttl_sec);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetMetadataCacheTtl(ttl_sec);
+		}
+	};
+	config.AddExtensionOption("observefs_metadata_cache_ttl_sec", "Seconds for which cached metadata stays valid.",
+	                          LogicalType {LogicalTypeId::BIGINT}, Value::BIGINT(MetadataCache::DEFAULT_TTL_SEC),
+	                          std::move(metadata_cache_ttl_callback));
+
+	auto enable_listing_cache_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto to_enable = parameter.GetValue<bool>();
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.listing_cache_enabled.store(to_enable);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetListingCacheEnabled(to_enable);
+		}
+	};
+	config.AddExtensionOption("observefs_enable_listing_cache",
+	                          "Whether to cache glob and list results, see observefs_metadata_cache().",
+	                          LogicalType {LogicalTypeId::BOOLEAN}, false, std::move(enable_listing_cache_callback));
+
+	auto listing_cache_ttl_callback = [](ClientContext &context, SetScope scope, Value &parameter) {
+		const auto ttl_sec = parameter.GetValue<int64_t>();
+		if (ttl_sec <= 0) {
+			throw InvalidInputException("Listing cache TTL should be positive, but got %d seconds", ttl_sec);
+		}
+		auto &instance_state = GetInstanceStateOrThrow(*context.db);
+		instance_state.listing_cache_ttl_sec.store(ttl_sec);
+		for (auto *cur_filesystem : instance_state.registry.GetAllObservabilityFs()) {
+			cur_filesystem->SetListingCacheTtl(ttl_sec);
+		}
+	};
+	config.AddExtensionOption(
+	    "observefs_listing_cache_ttl_sec", "Seconds for which cached glob and list results stay valid.",
+	    LogicalType {LogicalTypeId::BIGINT}, Value::BIGINT(ListingCache::DEFAULT_TTL_SEC),
+	    std::move(listing_cache_ttl_callback));
+
 	// Register observability data cleanup function.
 	ScalarFunction clear_cache_function("observefs_clear", /*arguments=*/ {},
 	                                    /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN}, ClearObservabilityData);
@@ -229,6 +578,53 @@ void LoadInternal(ExtensionLoader &loader) {
 	                                          /*return_type=*/LogicalType {LogicalTypeId::VARCHAR}, GetProfileStats);
 	loader.RegisterFunction(get_profile_stats_function);
 
+	// Register latency quantile query function, filesystem could be either wrapped or internal filesystem name, or '*'
+	// for all observability filesystems. An optional window in seconds limits records to recent ones.
+	ScalarFunctionSet get_latency_quantile_functions("observefs_quantile");
+	get_latency_quantile_functions.AddFunction(
+	    ScalarFunction(/*arguments=*/ {LogicalTypeId::VARCHAR, LogicalTypeId::VARCHAR, LogicalTypeId::DOUBLE},
+	                   /*return_type=*/LogicalTypeId::DOUBLE, GetLatencyQuantile));
+	get_latency_quantile_functions.AddFunction(ScalarFunction(
+	    /*arguments=*/ {LogicalTypeId::VARCHAR, LogicalTypeId::VARCHAR, LogicalTypeId::DOUBLE, LogicalTypeId::BIGINT},
+	    /*return_type=*/LogicalTypeId::DOUBLE, GetLatencyQuantile));
+	loader.RegisterFunction(get_latency_quantile_functions);
+
+	// Register structured latency and request size stats query function.
+	loader.RegisterFunction(ObservefsStatsQueryFunc());
+
+	// Register raw histogram buckets query function, which exposes the exact distribution shape.
+	loader.RegisterFunction(ObservefsHistogramBucketsQueryFunc());
+
+	// Register per-second time series query function.
+	loader.RegisterFunction(ObservefsTimeSeriesQueryFunc());
+
+	// Register per-query IO stats query function, which attributes IO operations to the queries issuing them.
+	loader.RegisterFunction(ObservefsQueryStatsQueryFunc());
+
+	// Register top accessed files query function, which is tracked by a heavy-hitters sketch in bounded memory.
+	loader.RegisterFunction(ObservefsTopFilesQueryFunc());
+
+	// Register redundant reads query function, which reports byte ranges fetched more than once within a window.
+	loader.RegisterFunction(ObservefsRedundantReadsQueryFunc());
+
+	// Register cache miss ratio curve query function, which predicts hit ratio for various cache sizes.
+	loader.RegisterFunction(ObservefsCacheMrcQueryFunc());
+
+	// Register read coalescing query function, which reports merged reads and extra bytes fetched.
+	loader.RegisterFunction(ObservefsReadCoalescingQueryFunc());
+
+	// Register hedged reads query function, which reports duplicate requests issued for slow reads and their wins.
+	loader.RegisterFunction(ObservefsHedgedReadsQueryFunc());
+
+	// Register metadata cache query function, which reports metadata and listing cache hits and misses.
+	loader.RegisterFunction(ObservefsMetadataCacheQueryFunc());
+
+	// Register per-open file handle stats query function.
+	loader.RegisterFunction(ObservefsHandleStatsQueryFunc());
+
+	// Register access pattern query function, which suggests readahead size based on recorded reads.
+	loader.RegisterFunction(ObservefsAccessPatternsQueryFunc());
+
 	// Register a function to list all existing filesystem instances, which is useful for wrapping.
 	loader.RegisterFunction(ListRegisteredFileSystemsQueryFunc());
 
@@ -254,6 +650,9 @@ void LoadInternal(ExtensionLoader &loader) {
 	// Register external file cache access query function.
 	loader.RegisterFunction(ExternalFileCacheAccessQueryFunc());
 
+	// Register external file cache breakdown query function, which shows cache effectiveness per bucket and path.
+	loader.RegisterFunction(ExternalFileCacheBreakdownQueryFunc());
+
 	// Set extension description.
 	loader.SetDescription("Filesystem observability extension to record I/O metrics (i.e., latency, operation counts) "
 	                      "and allow wrapping additional DuckDB-compatible filesystems.");
@@ -2,64 +2,114 @@
 
 #include "duckdb/common/string_util.hpp"
 #include "no_destructor.hpp"
+#include "query_stats_collector.hpp"
 #include "time_utils.hpp"
+#include "top_files_sketch.hpp"
 
 namespace duckdb {
 
-const std::array<LatencyHeuristic, static_cast<size_t>(IoOperation::kUnknown)> kLatencyHeuristics = {{
-    // kOpen
-    {0, 1000, 100},
-    // kRead
-    {0, 1000, 100},
-    // kList
-    {0, 3000, 100},
-    // kGlob
-    {0, 3000, 100},
-    // kStats,
-    {0, 1000, 100},
-}};
-
 namespace {
 const NoDestructor<string> LATENCY_HISTOGRAM_ITEM {"latency"};
-const NoDestructor<string> LATENCY_HISTOGRAM_UNIT {"millisec"};
+const NoDestructor<string> LATENCY_HISTOGRAM_UNIT {"microsec"};
+constexpr double NANOS_PER_MICRO = 1000.0;
 } // namespace
 
-LatencyGuard::LatencyGuard(OperationLatencyCollector &latency_collector_p, IoOperation io_operation_p)
-    : latency_collector(latency_collector_p), io_operation(io_operation_p),
-      start_timestamp(GetSteadyNowMilliSecSinceEpoch()) {
+LatencyGuard::LatencyGuard(std::mutex &latency_collector_mu_p, IoOperation io_operation_p,
+                           LatencyClockSource clock_source_p, int64_t start_timestamp_ns_p)
+    : latency_collector_mu(&latency_collector_mu_p), io_operation(io_operation_p), clock_source(clock_source_p),
+      start_timestamp_ns(start_timestamp_ns_p) {
+}
+
+LatencyGuard::LatencyGuard(LatencyGuard &&other) noexcept
+    : latency_collector_mu(other.latency_collector_mu), latency_collectors(other.latency_collectors),
+      latency_collector_count(other.latency_collector_count), latency_windows(other.latency_windows),
+      latency_window_count(other.latency_window_count), query_stats(other.query_stats),
+      file_access_stats(other.file_access_stats), io_wait_counter(other.io_wait_counter),
+      io_operation(other.io_operation), clock_source(other.clock_source),
+      start_timestamp_ns(other.start_timestamp_ns) {
+	other.latency_collector_mu = nullptr;
+	other.latency_collector_count = 0;
+	other.latency_window_count = 0;
+	other.query_stats = nullptr;
+	other.file_access_stats = nullptr;
+	other.io_wait_counter = nullptr;
+}
+
+void LatencyGuard::AddCollector(OperationLatencyCollector &latency_collector) {
+	D_ASSERT(latency_collector_count < MAX_COLLECTOR_COUNT);
+	latency_collectors[latency_collector_count++] = &latency_collector;
+}
+
+void LatencyGuard::AddWindow(OperationLatencyWindow &latency_window) {
+	D_ASSERT(latency_window_count < MAX_COLLECTOR_COUNT);
+	latency_windows[latency_window_count++] = &latency_window;
+}
+
+void LatencyGuard::SetQueryStats(QueryStats &query_stats_p) {
+	query_stats = &query_stats_p;
+}
+
+void LatencyGuard::SetFileAccessStats(FileAccessStats &file_access_stats_p) {
+	file_access_stats = &file_access_stats_p;
+}
+
+void LatencyGuard::SetIoWaitCounter(std::atomic<int64_t> &io_wait_counter_p) {
+	io_wait_counter = &io_wait_counter_p;
 }
 
 LatencyGuard::~LatencyGuard() {
-	const auto now = GetSteadyNowMilliSecSinceEpoch();
-	const auto latency_millisec = now - start_timestamp;
-	latency_collector.RecordOperationEnd(io_operation, latency_millisec);
+	if (latency_collector_mu == nullptr) {
+		return;
+	}
+	const auto now_ns = GetLatencyClockNowNanoSec(clock_source);
+	const double latency_microsec = static_cast<double>(now_ns - start_timestamp_ns) / NANOS_PER_MICRO;
+	if (io_wait_counter != nullptr) {
+		io_wait_counter->fetch_add(now_ns - start_timestamp_ns, std::memory_order_relaxed);
+	}
+	for (idx_t idx = 0; idx < latency_window_count; ++idx) {
+		latency_windows[idx]->RecordOperationEnd(io_operation, latency_microsec, now_ns);
+	}
+	std::lock_guard<std::mutex> lck(*latency_collector_mu);
+	for (idx_t idx = 0; idx < latency_collector_count; ++idx) {
+		latency_collectors[idx]->RecordOperationEnd(io_operation, latency_microsec);
+	}
+	if (query_stats != nullptr) {
+		query_stats->RecordOperationEnd(latency_microsec);
+	}
+	if (file_access_stats != nullptr) {
+		file_access_stats->RecordOperationEnd(latency_microsec);
+	}
 }
 
 OperationLatencyCollector::OperationLatencyCollector() {
+	Reset();
+}
+
+void OperationLatencyCollector::Reset() {
 	for (size_t i = 0; i < kIoOperationCount; ++i) {
-		const auto &heuristic = kLatencyHeuristics[i];
-		latency_collector[i].histogram =
-		    make_uniq<Histogram>(heuristic.min_latency_ms, heuristic.max_latency_ms, heuristic.num_buckets);
+		latency_collector[i].histogram = make_uniq<Histogram>();
 		latency_collector[i].histogram->SetStatsDistribution(*LATENCY_HISTOGRAM_ITEM, *LATENCY_HISTOGRAM_UNIT);
 		latency_collector[i].quantile_estimator =
 		    make_uniq<QuantileEstimator>(*LATENCY_HISTOGRAM_ITEM, *LATENCY_HISTOGRAM_UNIT);
 	}
 }
 
-LatencyGuard OperationLatencyCollector::RecordOperationStart(IoOperation io_oper) {
-	return LatencyGuard {*this, io_oper};
+void OperationLatencyCollector::RecordOperationEnd(IoOperation io_oper, double latency_microsec) {
+	auto &cur_stats_collector = latency_collector[static_cast<idx_t>(io_oper)];
+	cur_stats_collector.histogram->Add(latency_microsec);
+	cur_stats_collector.quantile_estimator->Add(static_cast<float>(latency_microsec));
 }
 
-void OperationLatencyCollector::RecordOperationEnd(IoOperation io_oper, int64_t latency_millisec) {
-	std::lock_guard<std::mutex> lck(latency_collector_mu);
-	auto &cur_histogram = latency_collector[static_cast<idx_t>(io_oper)].histogram;
-	cur_histogram->Add(latency_millisec);
-	auto &cur_quantile_estimator = latency_collector[static_cast<idx_t>(io_oper)].quantile_estimator;
-	cur_quantile_estimator->Add(static_cast<float>(latency_millisec));
+void OperationLatencyCollector::Merge(const OperationLatencyCollector &other) {
+	for (idx_t cur_oper_idx = 0; cur_oper_idx < kIoOperationCount; ++cur_oper_idx) {
+		auto &cur_stats_collector = latency_collector[cur_oper_idx];
+		const auto &other_stats_collector = other.latency_collector[cur_oper_idx];
+		cur_stats_collector.histogram->Merge(*other_stats_collector.histogram);
+		cur_stats_collector.quantile_estimator->Merge(*other_stats_collector.quantile_estimator);
+	}
 }
 
-string OperationLatencyCollector::GetHumanReadableStats() {
-	std::lock_guard<std::mutex> lck(latency_collector_mu);
+string OperationLatencyCollector::GetHumanReadableStats() const {
 	string stats;
 
 	// Record IO operation latency.
@@ -81,4 +131,23 @@ string OperationLatencyCollector::GetHumanReadableStats() {
 	return stats;
 }
 
+void OperationLatencyWindow::RecordOperationEnd(IoOperation io_oper, double latency_microsec,
+                                                int64_t end_timestamp_ns) {
+	std::lock_guard<std::mutex> lck(mu);
+	rolling_histograms[static_cast<idx_t>(io_oper)].Add(latency_microsec, end_timestamp_ns);
+}
+
+void OperationLatencyWindow::MergeWindowInto(IoOperation io_oper, int64_t now_ns, int64_t window_sec,
+                                             Histogram &histogram) const {
+	std::lock_guard<std::mutex> lck(mu);
+	rolling_histograms[static_cast<idx_t>(io_oper)].MergeWindowInto(now_ns, window_sec, histogram);
+}
+
+void OperationLatencyWindow::Reset() {
+	std::lock_guard<std::mutex> lck(mu);
+	for (auto &cur_rolling_histogram : rolling_histograms) {
+		cur_rolling_histogram.Reset();
+	}
+}
+
 } // namespace duckdb
@@ -7,27 +7,33 @@ namespace duckdb {
 
 namespace {
 const NoDestructor<string> SIZE_HISTOGRAM_ITEM {"request_size"};
-const NoDestructor<string> SIZE_HISTOGRAM_UNIT {""};
-
-// Heuristic estimation for request size.
-constexpr double MIN_REQUEST_SIZE = 0;
-constexpr double MAX_REQUEST_SIZE = 6 * 1024 * 1024;
-constexpr int REQUEST_HIST_BUCKET_NUM = 128;
+const NoDestructor<string> SIZE_HISTOGRAM_UNIT {"bytes"};
 } // namespace
 
 OperationSizeCollector::OperationSizeCollector() {
 	for (size_t ii = 0; ii < kIoOperationCount; ++ii) {
-		request_size_histograms[ii] = make_uniq<Histogram>(MIN_REQUEST_SIZE, MAX_REQUEST_SIZE, REQUEST_HIST_BUCKET_NUM);
+		request_size_histograms[ii] = make_uniq<Histogram>();
+		request_size_histograms[ii]->SetStatsDistribution(*SIZE_HISTOGRAM_ITEM, *SIZE_HISTOGRAM_UNIT);
+	}
+}
+
+void OperationSizeCollector::Reset() {
+	for (auto &cur_histogram : request_size_histograms) {
+		cur_histogram->Reset();
 	}
 }
 
 void OperationSizeCollector::RecordOperationSize(IoOperation io_oper, int64_t request_size) {
-	std::lock_guard<std::mutex> lck(mu);
 	request_size_histograms[static_cast<idx_t>(io_oper)]->Add(request_size);
 }
 
-string OperationSizeCollector::GetHumanReadableStats() {
-	std::lock_guard<std::mutex> lck(mu);
+void OperationSizeCollector::Merge(const OperationSizeCollector &other) {
+	for (idx_t cur_oper_idx = 0; cur_oper_idx < kIoOperationCount; ++cur_oper_idx) {
+		request_size_histograms[cur_oper_idx]->Merge(*other.request_size_histograms[cur_oper_idx]);
+	}
+}
+
+string OperationSizeCollector::GetHumanReadableStats() const {
 	string stats;
 
 	// Record IO operation size.
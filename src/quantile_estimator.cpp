@@ -1,79 +1,68 @@
 #include "quantile_estimator.hpp"
 
+#include "duckdb/common/assert.hpp"
 #include "duckdb/common/string_util.hpp"
 
 namespace duckdb {
 
+constexpr size_t QuantileEstimator::LARGE_SCALE_DATA_POINT_THRESHOLD;
+
 void QuantileEstimator::Add(float x) {
-	std::lock_guard<std::mutex> lck(mu);
-	if (!estimators.empty()) {
-		for (auto &e : estimators) {
-			e.Add(x);
-		}
+	const bool is_exact = IsExact();
+	sketch.Add(x);
+	if (!is_exact) {
 		return;
 	}
 
-	// If inline memory storage reaches threshold, switch to stats based method.
+	// If inline memory storage reaches threshold, only rely on sketch afterwards.
 	if (quantile_lite.GetNumCollected() >= LARGE_SCALE_DATA_POINT_THRESHOLD) {
-		InitializeP2QuantileWithLock();
-		for (auto &e : estimators) {
-			e.Add(x);
-		}
+		quantile_lite.Extract();
 		return;
 	}
-
-	// Fallback to in-memory storage.
 	quantile_lite.Add(x);
 }
 
-float QuantileEstimator::p50() const {
-	std::lock_guard<std::mutex> lck(mu);
-	if (estimators.empty()) {
-		return quantile_lite.p50();
+void QuantileEstimator::Merge(const QuantileEstimator &other) {
+	D_ASSERT(this != &other);
+	// Keep exact data points only if both sides are exact and the total still fits in memory.
+	const bool keep_exact = IsExact() && other.IsExact() &&
+	                        quantile_lite.GetNumCollected() + other.quantile_lite.GetNumCollected() <=
+	                            LARGE_SCALE_DATA_POINT_THRESHOLD;
+	if (keep_exact) {
+		for (float cur_data : other.quantile_lite.GetSamples()) {
+			quantile_lite.Add(cur_data);
+		}
+	} else {
+		quantile_lite.Extract();
 	}
-	return estimators[0].Get();
+	sketch.Merge(other.sketch);
 }
-float QuantileEstimator::p75() const {
-	std::lock_guard<std::mutex> lck(mu);
-	if (estimators.empty()) {
-		return quantile_lite.p75();
+
+float QuantileEstimator::Quantile(double q) const {
+	if (IsExact()) {
+		return quantile_lite.Quantile(static_cast<float>(q));
 	}
-	return estimators[1].Get();
+	return static_cast<float>(sketch.Quantile(q));
+}
+
+uint64_t QuantileEstimator::Count() const {
+	return sketch.Count();
+}
+
+float QuantileEstimator::p50() const {
+	return Quantile(0.50);
+}
+float QuantileEstimator::p75() const {
+	return Quantile(0.75);
 }
 float QuantileEstimator::p90() const {
-	std::lock_guard<std::mutex> lck(mu);
-	if (estimators.empty()) {
-		return quantile_lite.p90();
-	}
-	return estimators[2].Get();
+	return Quantile(0.90);
 }
 float QuantileEstimator::p95() const {
-	std::lock_guard<std::mutex> lck(mu);
-	if (estimators.empty()) {
-		return quantile_lite.p95();
-	}
-	return estimators[3].Get();
+	return Quantile(0.95);
 }
 float QuantileEstimator::p99() const {
-	std::lock_guard<std::mutex> lck(mu);
-	if (estimators.empty()) {
-		return quantile_lite.p99();
-	}
-	return estimators[4].Get();
-}
-
-void QuantileEstimator::InitializeP2QuantileWithLock() {
-	D_ASSERT(estimators.empty());
-	constexpr std::array<double, 5> QUANTILES {0.50, 0.75, 0.90, 0.95, 0.99};
-	estimators.reserve(QUANTILES.size());
-	for (double q : QUANTILES) {
-		estimators.emplace_back(q);
-	}
-
-	auto data_points = quantile_lite.Extract();
-	for (auto &e : estimators) {
-		e.BulkAdd(data_points);
-	}
+	return Quantile(0.99);
 }
 
 string QuantileEstimator::FormatString() const {
@@ -83,6 +72,7 @@ string QuantileEstimator::FormatString() const {
 	stats += StringUtil::Format("\nP90 %s %f %s", quantile_name, p90(), quantile_unit);
 	stats += StringUtil::Format("\nP95 %s %f %s", quantile_name, p95(), quantile_unit);
 	stats += StringUtil::Format("\nP99 %s %f %s", quantile_name, p99(), quantile_unit);
+	stats += StringUtil::Format("\nP99.9 %s %f %s", quantile_name, Quantile(0.999), quantile_unit);
 	return stats;
 }
 
@@ -0,0 +1,50 @@
+#include "query_function_utils.hpp"
+
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "observability_filesystem.hpp"
+#include "observefs_instance_state.hpp"
+
+namespace duckdb {
+
+void BindQueryFunctionColumns(std::initializer_list<QueryFunctionColumn> columns, vector<LogicalType> &return_types,
+                              vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+
+	return_types.reserve(columns.size());
+	names.reserve(columns.size());
+	for (const auto &cur_column : columns) {
+		return_types.emplace_back(LogicalType {cur_column.type});
+		names.emplace_back(cur_column.name);
+	}
+}
+
+void SetStringColumnValue(Vector &column, idx_t row_idx, const string &value) {
+	FlatVector::GetData<string_t>(column)[row_idx] = StringVector::AddString(column, value);
+}
+
+void SetStringColumnValueOrNull(Vector &column, idx_t row_idx, const string &value) {
+	if (value.empty()) {
+		FlatVector::SetNull(column, row_idx, true);
+		return;
+	}
+	SetStringColumnValue(column, row_idx, value);
+}
+
+vector<ObservabilityFileSystem *> GetAllObservabilityFs(ClientContext &context) {
+	auto &instance_state = GetInstanceStateOrThrow(*context.db);
+	return instance_state.registry.GetAllObservabilityFs();
+}
+
+vector<std::pair<string, MetricsSnapshot>> GetAllMetricsSnapshots(ClientContext &context) {
+	const auto observefs_instances = GetAllObservabilityFs(context);
+	vector<std::pair<string, MetricsSnapshot>> snapshots;
+	snapshots.reserve(observefs_instances.size());
+	for (auto *cur_filesystem : observefs_instances) {
+		snapshots.emplace_back(cur_filesystem->GetName(), cur_filesystem->GetMetricsSnapshot());
+	}
+	return snapshots;
+}
+
+} // namespace duckdb
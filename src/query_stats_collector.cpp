@@ -0,0 +1,86 @@
+#include "query_stats_collector.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/helper.hpp"
+
+namespace duckdb {
+
+constexpr idx_t QueryStatsCollector::MAX_QUERY_COUNT;
+
+void QueryStats::RecordOperationStart(int64_t bytes_p) {
+	++request_count;
+	bytes += static_cast<uint64_t>(bytes_p);
+}
+
+void QueryStats::RecordOperationEnd(double latency_microsec) {
+	io_wait_microsec += latency_microsec;
+	latency_sketch.Add(latency_microsec);
+}
+
+void QueryStats::RecordDuplicatedRead(uint64_t duplicated_bytes_p) {
+	++duplicated_request_count;
+	duplicated_bytes += duplicated_bytes_p;
+}
+
+void QueryStats::Merge(const QueryStats &other) {
+	D_ASSERT(query_tag.query_id == other.query_tag.query_id);
+	request_count += other.request_count;
+	bytes += other.bytes;
+	io_wait_microsec += other.io_wait_microsec;
+	duplicated_request_count += other.duplicated_request_count;
+	duplicated_bytes += other.duplicated_bytes;
+	latency_sketch.Merge(other.latency_sketch);
+}
+
+void QueryStats::Reset(const QueryTag &query_tag_p) {
+	query_tag = query_tag_p;
+	request_count = 0;
+	bytes = 0;
+	io_wait_microsec = 0.0;
+	duplicated_request_count = 0;
+	duplicated_bytes = 0;
+	latency_sketch.Reset();
+}
+
+QueryStatsCollector::QueryStatsCollector() {
+	query_stats.reserve(MAX_QUERY_COUNT);
+	for (idx_t idx = 0; idx < MAX_QUERY_COUNT; ++idx) {
+		query_stats.emplace_back(make_uniq<QueryStats>());
+	}
+}
+
+QueryStats &QueryStatsCollector::GetOrCreate(const QueryTag &query_tag) {
+	D_ASSERT(query_tag.IsValid());
+	if (last_accessed_idx < query_stats.size() &&
+	    query_stats[last_accessed_idx]->query_tag.query_id == query_tag.query_id) {
+		return *query_stats[last_accessed_idx];
+	}
+
+	// Look for the query, and the entry to evict in the meantime.
+	idx_t evict_idx = 0;
+	for (idx_t idx = 0; idx < query_stats.size(); ++idx) {
+		const auto cur_query_id = query_stats[idx]->query_tag.query_id;
+		if (cur_query_id == query_tag.query_id) {
+			last_accessed_idx = idx;
+			return *query_stats[idx];
+		}
+		// Entries which have been reset are recycled first, otherwise the oldest query is evicted.
+		const auto evict_query_id = query_stats[evict_idx]->query_tag.query_id;
+		if (evict_query_id != DConstants::INVALID_INDEX &&
+		    (cur_query_id == DConstants::INVALID_INDEX || cur_query_id < evict_query_id)) {
+			evict_idx = idx;
+		}
+	}
+
+	query_stats[evict_idx]->Reset(query_tag);
+	last_accessed_idx = evict_idx;
+	return *query_stats[evict_idx];
+}
+
+void QueryStatsCollector::Reset() {
+	for (auto &cur_query_stats : query_stats) {
+		cur_query_stats->Reset(QueryTag {});
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,83 @@
+#include "query_stats_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct QueryStatsRow {
+	string filesystem;
+	QueryStats query_stats;
+};
+
+unique_ptr<FunctionData> ObservefsQueryStatsQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                          vector<LogicalType> &return_types, vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        {"connection_id", LogicalTypeId::UBIGINT},
+	        {"query_id", LogicalTypeId::UBIGINT},
+	        {"requests", LogicalTypeId::UBIGINT},
+	        {"bytes", LogicalTypeId::UBIGINT},
+	        // Accumulated latency of all IO operations issued by the query.
+	        {"io_wait_us", LogicalTypeId::DOUBLE},
+	        {"p50_latency_us", LogicalTypeId::DOUBLE},
+	        {"p90_latency_us", LogicalTypeId::DOUBLE},
+	        {"p99_latency_us", LogicalTypeId::DOUBLE},
+	        // Reads and bytes re-fetching byte ranges already read within the redundant read window, only counted when
+	        // redundant read detection is enabled.
+	        {"duplicated_requests", LogicalTypeId::UBIGINT},
+	        {"duplicated_bytes", LogicalTypeId::UBIGINT},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsQueryStatsQueryFuncInit(ClientContext &context,
+                                                                      TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<QueryStatsRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto filesystem = cur_filesystem->GetName();
+		auto all_query_stats = cur_filesystem->GetQueryStats();
+		for (auto &cur_query_stats : all_query_stats) {
+			QueryStatsRow row {filesystem, std::move(cur_query_stats)};
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	return std::move(result);
+}
+
+void EmitQueryStatsRow(const QueryStatsRow &row, DataChunk &output, idx_t row_idx) {
+	const auto &query_stats = row.query_stats;
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetColumnValue<uint64_t>(output.data[1], row_idx, query_stats.query_tag.connection_id);
+	SetColumnValue<uint64_t>(output.data[2], row_idx, query_stats.query_tag.query_id);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, query_stats.request_count);
+	SetColumnValue<uint64_t>(output.data[4], row_idx, query_stats.bytes);
+	SetColumnValue<double>(output.data[5], row_idx, query_stats.io_wait_microsec);
+	SetColumnValue<double>(output.data[6], row_idx, query_stats.latency_sketch.Quantile(0.5));
+	SetColumnValue<double>(output.data[7], row_idx, query_stats.latency_sketch.Quantile(0.9));
+	SetColumnValue<double>(output.data[8], row_idx, query_stats.latency_sketch.Quantile(0.99));
+	SetColumnValue<uint64_t>(output.data[9], row_idx, query_stats.duplicated_request_count);
+	SetColumnValue<uint64_t>(output.data[10], row_idx, query_stats.duplicated_bytes);
+}
+
+} // namespace
+
+TableFunction ObservefsQueryStatsQueryFunc() {
+	TableFunction query_stats_query_func {/*name=*/"observefs_query_stats",
+	                                      /*arguments=*/ {},
+	                                      /*function=*/EmitMaterializedRows<QueryStatsRow, EmitQueryStatsRow>,
+	                                      /*bind=*/ObservefsQueryStatsQueryFuncBind,
+	                                      /*init_global=*/ObservefsQueryStatsQueryFuncInit};
+	return query_stats_query_func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,108 @@
+#include "read_coalescer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+constexpr idx_t ReadCoalescer::MAX_COALESCED_BYTES;
+
+void ReadCoalescingStats::Reset() {
+	request_count.store(0, std::memory_order_relaxed);
+	upstream_request_count.store(0, std::memory_order_relaxed);
+	merged_request_count.store(0, std::memory_order_relaxed);
+	extra_bytes.store(0, std::memory_order_relaxed);
+}
+
+void ReadCoalescer::FetchPendingReads(vector<PendingRead *> &reads, idx_t max_gap_bytes, const FetchFunc &fetch,
+                                      ReadCoalescingStats &stats) {
+	std::sort(reads.begin(), reads.end(),
+	          [](const PendingRead *lhs, const PendingRead *rhs) { return lhs->location < rhs->location; });
+
+	vector<char> coalesced_buffer;
+	idx_t group_begin = 0;
+	while (group_begin < reads.size()) {
+		// Extend the group as long as the next read is close enough, and the merged request is not too large.
+		const idx_t group_start = reads[group_begin]->location;
+		idx_t group_end = group_start + reads[group_begin]->nr_bytes;
+		idx_t requested_bytes = reads[group_begin]->nr_bytes;
+		idx_t group_finish = group_begin + 1;
+		for (; group_finish < reads.size(); ++group_finish) {
+			const auto &cur_read = *reads[group_finish];
+			const auto cur_end = cur_read.location + cur_read.nr_bytes;
+			if (cur_read.location > group_end + max_gap_bytes ||
+			    std::max(cur_end, group_end) - group_start > MAX_COALESCED_BYTES) {
+				break;
+			}
+			// Only count bytes not covered by previous reads, since reads could overlap.
+			if (cur_end > group_end) {
+				requested_bytes += cur_end - std::max(cur_read.location, group_end);
+				group_end = cur_end;
+			}
+		}
+
+		stats.upstream_request_count.fetch_add(1, std::memory_order_relaxed);
+		stats.merged_request_count.fetch_add(group_finish - group_begin - 1, std::memory_order_relaxed);
+		stats.extra_bytes.fetch_add((group_end - group_start) - requested_bytes, std::memory_order_relaxed);
+		try {
+			// Single read is fetched into its own buffer directly, without an extra copy.
+			if (group_finish - group_begin == 1) {
+				auto &cur_read = *reads[group_begin];
+				fetch(cur_read.buffer, cur_read.nr_bytes, cur_read.location);
+			} else {
+				coalesced_buffer.resize(group_end - group_start);
+				fetch(coalesced_buffer.data(), group_end - group_start, group_start);
+				for (idx_t idx = group_begin; idx < group_finish; ++idx) {
+					auto &cur_read = *reads[idx];
+					std::memcpy(cur_read.buffer, coalesced_buffer.data() + (cur_read.location - group_start),
+					            cur_read.nr_bytes);
+				}
+			}
+		} catch (...) {
+			const auto error = std::current_exception();
+			for (idx_t idx = group_begin; idx < group_finish; ++idx) {
+				reads[idx]->error = error;
+			}
+		}
+		group_begin = group_finish;
+	}
+}
+
+void ReadCoalescer::Read(char *buffer, idx_t nr_bytes, idx_t location, idx_t max_gap_bytes, const FetchFunc &fetch,
+                         ReadCoalescingStats &stats) {
+	stats.request_count.fetch_add(1, std::memory_order_relaxed);
+	PendingRead read;
+	read.buffer = buffer;
+	read.nr_bytes = nr_bytes;
+	read.location = location;
+
+	std::unique_lock<std::mutex> lck(mu);
+	pending_reads.emplace_back(&read);
+	while (!read.done) {
+		if (fetching) {
+			cv.wait(lck);
+			continue;
+		}
+
+		// Take over all queued reads, including the current one, and issue them without holding the lock, so more
+		// reads could queue up in the meantime.
+		fetching = true;
+		vector<PendingRead *> reads_to_fetch;
+		reads_to_fetch.swap(pending_reads);
+		lck.unlock();
+		FetchPendingReads(reads_to_fetch, max_gap_bytes, fetch, stats);
+		lck.lock();
+		for (auto *cur_read : reads_to_fetch) {
+			cur_read->done = true;
+		}
+		fetching = false;
+		cv.notify_all();
+	}
+	lck.unlock();
+
+	if (read.error) {
+		std::rethrow_exception(read.error);
+	}
+}
+
+} // namespace duckdb
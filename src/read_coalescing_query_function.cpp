@@ -0,0 +1,81 @@
+#include "read_coalescing_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct ReadCoalescingRow {
+	string filesystem;
+	uint64_t request_count = 0;
+	uint64_t upstream_request_count = 0;
+	uint64_t merged_request_count = 0;
+	uint64_t extra_bytes = 0;
+};
+
+unique_ptr<FunctionData> ObservefsReadCoalescingQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                              vector<LogicalType> &return_types,
+                                                              vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        // Number of reads requested by callers, and number of requests actually issued to the internal filesystem.
+	        {"requests", LogicalTypeId::UBIGINT},
+	        {"upstream_requests", LogicalTypeId::UBIGINT},
+	        // Number of reads served by an upstream request issued for another read.
+	        {"merged_requests", LogicalTypeId::UBIGINT},
+	        // Number of bytes fetched in gaps between merged reads.
+	        {"extra_bytes", LogicalTypeId::UBIGINT},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsReadCoalescingQueryFuncInit(ClientContext &context,
+                                                                          TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<ReadCoalescingRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto &stats = cur_filesystem->GetReadCoalescingStats();
+		ReadCoalescingRow row;
+		row.request_count = stats.request_count.load(std::memory_order_relaxed);
+		// Skip filesystems without any coalesced read.
+		if (row.request_count == 0) {
+			continue;
+		}
+		row.filesystem = cur_filesystem->GetName();
+		row.upstream_request_count = stats.upstream_request_count.load(std::memory_order_relaxed);
+		row.merged_request_count = stats.merged_request_count.load(std::memory_order_relaxed);
+		row.extra_bytes = stats.extra_bytes.load(std::memory_order_relaxed);
+		result->rows.emplace_back(std::move(row));
+	}
+	return std::move(result);
+}
+
+void EmitReadCoalescingRow(const ReadCoalescingRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetColumnValue<uint64_t>(output.data[1], row_idx, row.request_count);
+	SetColumnValue<uint64_t>(output.data[2], row_idx, row.upstream_request_count);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, row.merged_request_count);
+	SetColumnValue<uint64_t>(output.data[4], row_idx, row.extra_bytes);
+}
+
+} // namespace
+
+TableFunction ObservefsReadCoalescingQueryFunc() {
+	TableFunction read_coalescing_query_func {
+	    /*name=*/"observefs_read_coalescing",
+	    /*arguments=*/ {},
+	    /*function=*/EmitMaterializedRows<ReadCoalescingRow, EmitReadCoalescingRow>,
+	    /*bind=*/ObservefsReadCoalescingQueryFuncBind,
+	    /*init_global=*/ObservefsReadCoalescingQueryFuncInit};
+	return read_coalescing_query_func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,126 @@
+#include "redundant_read_detector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/helper.hpp"
+
+namespace duckdb {
+
+constexpr idx_t RedundantReadDetector::STRIPE_COUNT;
+constexpr idx_t RedundantReadDetector::MAX_FILE_COUNT_PER_STRIPE;
+constexpr idx_t RedundantReadDetector::MAX_RANGE_COUNT_PER_FILE;
+constexpr int64_t RedundantReadDetector::DEFAULT_WINDOW_SEC;
+constexpr int64_t RedundantReadDetector::NANOS_PER_SEC;
+
+RedundantReadDetector::FileReadRanges &RedundantReadDetector::GetOrCreateFileWithLock(Stripe &stripe,
+                                                                                      const string &path) {
+	auto iter = stripe.files.find(path);
+	if (iter != stripe.files.end()) {
+		return *iter->second;
+	}
+
+	if (stripe.files.size() >= MAX_FILE_COUNT_PER_STRIPE) {
+		auto evict_iter = stripe.files.begin();
+		for (auto cur_iter = stripe.files.begin(); cur_iter != stripe.files.end(); ++cur_iter) {
+			if (cur_iter->second->last_access_ns < evict_iter->second->last_access_ns) {
+				evict_iter = cur_iter;
+			}
+		}
+		stripe.files.erase(evict_iter);
+	}
+
+	auto file_read_ranges = make_uniq<FileReadRanges>();
+	file_read_ranges->stats.path = path;
+	auto &result = *file_read_ranges;
+	stripe.files.emplace(path, std::move(file_read_ranges));
+	return result;
+}
+
+uint64_t RedundantReadDetector::RecordRead(const string &path, idx_t location, idx_t nr_bytes, int64_t now_ns) {
+	if (!IsEnabled() || nr_bytes == 0) {
+		return 0;
+	}
+	const idx_t end = location + nr_bytes;
+	const int64_t expire_before_ns = now_ns - window_ns.load(std::memory_order_relaxed);
+
+	auto &stripe = stripes[std::hash<string> {}(path) % STRIPE_COUNT];
+	std::lock_guard<std::mutex> lck(stripe.mu);
+	auto &file_read_ranges = GetOrCreateFileWithLock(stripe, path);
+	file_read_ranges.last_access_ns = now_ns;
+	auto &ranges = file_read_ranges.ranges;
+	while (!ranges.empty() && ranges.front().timestamp_ns < expire_before_ns) {
+		ranges.pop_front();
+	}
+
+	// Collect overlaps with recent ranges, which could overlap with each other, so they're merged before counting.
+	std::array<std::pair<idx_t, idx_t>, MAX_RANGE_COUNT_PER_FILE> overlaps;
+	idx_t overlap_count = 0;
+	for (const auto &cur_range : ranges) {
+		const auto overlap_start = std::max(cur_range.start, location);
+		const auto overlap_end = std::min(cur_range.end, end);
+		if (overlap_start < overlap_end) {
+			overlaps[overlap_count++] = std::make_pair(overlap_start, overlap_end);
+		}
+	}
+	std::sort(overlaps.begin(), overlaps.begin() + overlap_count);
+	uint64_t duplicated_bytes = 0;
+	idx_t covered_end = 0;
+	for (idx_t idx = 0; idx < overlap_count; ++idx) {
+		const auto cur_start = std::max(overlaps[idx].first, covered_end);
+		if (cur_start < overlaps[idx].second) {
+			duplicated_bytes += overlaps[idx].second - cur_start;
+			covered_end = overlaps[idx].second;
+		}
+	}
+
+	if (ranges.size() >= MAX_RANGE_COUNT_PER_FILE) {
+		ranges.pop_front();
+	}
+	ranges.push_back(ReadRange {location, end, now_ns});
+
+	auto &stats = file_read_ranges.stats;
+	++stats.request_count;
+	if (duplicated_bytes > 0) {
+		++stats.duplicated_request_count;
+		stats.duplicated_bytes += duplicated_bytes;
+	}
+	return duplicated_bytes;
+}
+
+void RedundantReadDetector::SetWindowSec(int64_t window_sec) {
+	D_ASSERT(window_sec > 0);
+	window_ns.store(window_sec * NANOS_PER_SEC, std::memory_order_relaxed);
+}
+
+vector<RedundantReadStats> RedundantReadDetector::GetRedundantReadStats() {
+	vector<RedundantReadStats> redundant_read_stats;
+	for (auto &cur_stripe : stripes) {
+		std::lock_guard<std::mutex> lck(cur_stripe.mu);
+		for (const auto &path_and_ranges : cur_stripe.files) {
+			const auto &cur_stats = path_and_ranges.second->stats;
+			if (cur_stats.duplicated_request_count > 0) {
+				redundant_read_stats.emplace_back(cur_stats);
+			}
+		}
+	}
+	std::sort(redundant_read_stats.begin(), redundant_read_stats.end(),
+	          [](const RedundantReadStats &lhs, const RedundantReadStats &rhs) {
+		          if (lhs.duplicated_bytes != rhs.duplicated_bytes) {
+			          return lhs.duplicated_bytes > rhs.duplicated_bytes;
+		          }
+		          return lhs.path < rhs.path;
+	          });
+	return redundant_read_stats;
+}
+
+void RedundantReadDetector::Reset() {
+	for (auto &cur_stripe : stripes) {
+		std::lock_guard<std::mutex> lck(cur_stripe.mu);
+		cur_stripe.files.clear();
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,72 @@
+#include "redundant_reads_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct RedundantReadsRow {
+	string filesystem;
+	RedundantReadStats redundant_read_stats;
+};
+
+unique_ptr<FunctionData> ObservefsRedundantReadsQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                              vector<LogicalType> &return_types,
+                                                              vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        {"path", LogicalTypeId::VARCHAR},
+	        // Read requests since the file is tracked.
+	        {"requests", LogicalTypeId::UBIGINT},
+	        // Reads overlapping with any byte range read within the window.
+	        {"duplicated_requests", LogicalTypeId::UBIGINT},
+	        {"duplicated_bytes", LogicalTypeId::UBIGINT},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsRedundantReadsQueryFuncInit(ClientContext &context,
+                                                                          TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<RedundantReadsRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto filesystem = cur_filesystem->GetName();
+		auto redundant_reads = cur_filesystem->GetRedundantReads();
+		for (auto &cur_redundant_read_stats : redundant_reads) {
+			RedundantReadsRow row {filesystem, std::move(cur_redundant_read_stats)};
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	return std::move(result);
+}
+
+void EmitRedundantReadsRow(const RedundantReadsRow &row, DataChunk &output, idx_t row_idx) {
+	const auto &redundant_read_stats = row.redundant_read_stats;
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetStringColumnValue(output.data[1], row_idx, redundant_read_stats.path);
+	SetColumnValue<uint64_t>(output.data[2], row_idx, redundant_read_stats.request_count);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, redundant_read_stats.duplicated_request_count);
+	SetColumnValue<uint64_t>(output.data[4], row_idx, redundant_read_stats.duplicated_bytes);
+}
+
+} // namespace
+
+TableFunction ObservefsRedundantReadsQueryFunc() {
+	TableFunction redundant_reads_query_func {
+	    /*name=*/"observefs_redundant_reads",
+	    /*arguments=*/ {},
+	    /*function=*/EmitMaterializedRows<RedundantReadsRow, EmitRedundantReadsRow>,
+	    /*bind=*/ObservefsRedundantReadsQueryFuncBind,
+	    /*init_global=*/ObservefsRedundantReadsQueryFuncInit};
+	return redundant_reads_query_func;
+}
+
+} // namespace duckdb
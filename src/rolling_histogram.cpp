@@ -0,0 +1,91 @@
+#include "rolling_histogram.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/helper.hpp"
+
+namespace duckdb {
+
+constexpr int64_t RollingHistogram::SLOT_INTERVAL_SEC;
+constexpr idx_t RollingHistogram::SLOT_COUNT;
+constexpr idx_t RollingHistogram::SUB_BUCKET_BITS;
+
+namespace {
+constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+
+int64_t GetInterval(int64_t timestamp_ns) {
+	return timestamp_ns / (RollingHistogram::SLOT_INTERVAL_SEC * NANOS_PER_SEC);
+}
+} // namespace
+
+RollingHistogram::RollingHistogram() {
+}
+
+RollingHistogram::Slot &RollingHistogram::GetOrRecycleSlot(int64_t interval) {
+	auto &slot = slots[static_cast<idx_t>(interval) % SLOT_COUNT];
+	if (slot.histogram == nullptr) {
+		slot.histogram = make_uniq<Histogram>(SUB_BUCKET_BITS);
+	} else if (slot.interval != interval) {
+		slot.histogram->Reset();
+	}
+	slot.interval = interval;
+	return slot;
+}
+
+void RollingHistogram::Add(double val, int64_t timestamp_ns) {
+	if (slots.empty()) {
+		slots.resize(SLOT_COUNT);
+	}
+	const int64_t interval = GetInterval(timestamp_ns);
+	auto &slot = slots[static_cast<idx_t>(interval) % SLOT_COUNT];
+	// Records for a slot which has already been recycled for a newer interval are dropped.
+	if (slot.interval > interval) {
+		return;
+	}
+	GetOrRecycleSlot(interval).histogram->Add(val);
+}
+
+void RollingHistogram::Merge(const RollingHistogram &other) {
+	if (other.slots.empty()) {
+		return;
+	}
+	if (slots.empty()) {
+		slots.resize(SLOT_COUNT);
+	}
+	for (const auto &other_slot : other.slots) {
+		if (other_slot.interval < 0 || other_slot.histogram->counts() == 0) {
+			continue;
+		}
+		auto &slot = slots[static_cast<idx_t>(other_slot.interval) % SLOT_COUNT];
+		if (slot.interval > other_slot.interval) {
+			continue;
+		}
+		GetOrRecycleSlot(other_slot.interval).histogram->Merge(*other_slot.histogram);
+	}
+}
+
+void RollingHistogram::MergeWindowInto(int64_t now_ns, int64_t window_sec, Histogram &histogram) const {
+	D_ASSERT(window_sec > 0 && window_sec <= GetMaxWindowSec());
+	const int64_t now_interval = GetInterval(now_ns);
+	const int64_t window_slots = (window_sec + SLOT_INTERVAL_SEC - 1) / SLOT_INTERVAL_SEC;
+	for (const auto &cur_slot : slots) {
+		if (cur_slot.interval < 0 || cur_slot.interval > now_interval) {
+			continue;
+		}
+		// Current interval is partially elapsed, so it's counted in addition to complete intervals.
+		if (now_interval - cur_slot.interval > window_slots) {
+			continue;
+		}
+		histogram.Merge(*cur_slot.histogram);
+	}
+}
+
+void RollingHistogram::Reset() {
+	for (auto &cur_slot : slots) {
+		if (cur_slot.histogram != nullptr) {
+			cur_slot.histogram->Reset();
+		}
+		cur_slot.interval = -1;
+	}
+}
+
+} // namespace duckdb
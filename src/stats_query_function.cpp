@@ -0,0 +1,136 @@
+#include "stats_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "io_operation.hpp"
+#include "metrics_collector.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct OperationStatsRow {
+	string filesystem;
+	// Empty for overall stats of the filesystem.
+	string bucket;
+	IoOperation io_oper = IoOperation::kUnknown;
+	uint64_t count = 0;
+	// Request size is only recorded for read and write operations.
+	bool has_bytes = false;
+	uint64_t bytes = 0;
+	double mean_latency = 0.0;
+	double min_latency = 0.0;
+	double max_latency = 0.0;
+	double p50_latency = 0.0;
+	double p90_latency = 0.0;
+	double p95_latency = 0.0;
+	double p99_latency = 0.0;
+	double p999_latency = 0.0;
+};
+
+// Append one row for each IO operation with records.
+void AppendOperationStatsRows(const string &filesystem, const string &bucket, const OperationStats &stats,
+                              vector<OperationStatsRow> &rows) {
+	for (idx_t cur_oper_idx = 0; cur_oper_idx < kIoOperationCount; ++cur_oper_idx) {
+		const auto io_oper = static_cast<IoOperation>(cur_oper_idx);
+		const auto &latency_histogram = stats.latency_collector->GetHistogram(io_oper);
+		if (latency_histogram.counts() == 0) {
+			continue;
+		}
+		const auto &quantile_estimator = stats.latency_collector->GetQuantileEstimator(io_oper);
+		const auto &size_histogram = stats.size_collector->GetHistogram(io_oper);
+
+		OperationStatsRow row;
+		row.filesystem = filesystem;
+		row.bucket = bucket;
+		row.io_oper = io_oper;
+		row.count = latency_histogram.counts();
+		row.has_bytes = size_histogram.counts() > 0;
+		row.bytes = static_cast<uint64_t>(size_histogram.sum());
+		row.mean_latency = latency_histogram.mean();
+		row.min_latency = latency_histogram.min();
+		row.max_latency = latency_histogram.max();
+		row.p50_latency = quantile_estimator.Quantile(0.50);
+		row.p90_latency = quantile_estimator.Quantile(0.90);
+		row.p95_latency = quantile_estimator.Quantile(0.95);
+		row.p99_latency = quantile_estimator.Quantile(0.99);
+		row.p999_latency = quantile_estimator.Quantile(0.999);
+		rows.emplace_back(std::move(row));
+	}
+}
+
+unique_ptr<FunctionData> ObservefsStatsQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        // NULL for overall stats of the filesystem.
+	        {"bucket", LogicalTypeId::VARCHAR},
+	        {"operation", LogicalTypeId::VARCHAR},
+	        {"count", LogicalTypeId::UBIGINT},
+	        // NULL for operations without request size.
+	        {"bytes", LogicalTypeId::UBIGINT},
+	        // Latency stats, all in microseconds.
+	        {"mean_latency_us", LogicalTypeId::DOUBLE},
+	        {"min_latency_us", LogicalTypeId::DOUBLE},
+	        {"max_latency_us", LogicalTypeId::DOUBLE},
+	        {"p50_latency_us", LogicalTypeId::DOUBLE},
+	        {"p90_latency_us", LogicalTypeId::DOUBLE},
+	        {"p95_latency_us", LogicalTypeId::DOUBLE},
+	        {"p99_latency_us", LogicalTypeId::DOUBLE},
+	        {"p999_latency_us", LogicalTypeId::DOUBLE},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsStatsQueryFuncInit(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<OperationStatsRow>>();
+	const auto snapshots = GetAllMetricsSnapshots(context);
+	for (const auto &cur_snapshot : snapshots) {
+		const auto &filesystem = cur_snapshot.first;
+		AppendOperationStatsRows(filesystem, /*bucket=*/"", cur_snapshot.second.overall_stats, result->rows);
+		for (const auto &bucket_and_stats : cur_snapshot.second.bucket_stats) {
+			AppendOperationStatsRows(filesystem, bucket_and_stats.first, *bucket_and_stats.second, result->rows);
+		}
+	}
+	return std::move(result);
+}
+
+void EmitOperationStatsRow(const OperationStatsRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetStringColumnValueOrNull(output.data[1], row_idx, row.bucket);
+	SetStringColumnValue(output.data[2], row_idx, OPER_NAMES[static_cast<idx_t>(row.io_oper)]);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, row.count);
+	if (row.has_bytes) {
+		SetColumnValue<uint64_t>(output.data[4], row_idx, row.bytes);
+	} else {
+		FlatVector::SetNull(output.data[4], row_idx, true);
+	}
+	SetColumnValue<double>(output.data[5], row_idx, row.mean_latency);
+	SetColumnValue<double>(output.data[6], row_idx, row.min_latency);
+	SetColumnValue<double>(output.data[7], row_idx, row.max_latency);
+	SetColumnValue<double>(output.data[8], row_idx, row.p50_latency);
+	SetColumnValue<double>(output.data[9], row_idx, row.p90_latency);
+	SetColumnValue<double>(output.data[10], row_idx, row.p95_latency);
+	SetColumnValue<double>(output.data[11], row_idx, row.p99_latency);
+	SetColumnValue<double>(output.data[12], row_idx, row.p999_latency);
+}
+
+} // namespace
+
+TableFunction ObservefsStatsQueryFunc() {
+	TableFunction stats_query_func {/*name=*/"observefs_stats",
+	                                /*arguments=*/ {},
+	                                /*function=*/EmitMaterializedRows<OperationStatsRow, EmitOperationStatsRow>,
+	                                /*bind=*/ObservefsStatsQueryFuncBind,
+	                                /*init_global=*/ObservefsStatsQueryFuncInit};
+	return stats_query_func;
+}
+
+} // namespace duckdb
@@ -1,5 +1,8 @@
 #include "string_utils.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include "duckdb/common/string_util.hpp"
 
 namespace duckdb {
@@ -8,30 +11,47 @@ namespace {
 const char *S3_PREFIX = "s3://";
 const char *GCS_PREFIX = "gs://";
 
-// Precondition: [`filepath`] starts with [`s3://`].
-string GetS3Bucket(const string &filepath) {
-	string rest = filepath.substr(5);
-	auto pos = rest.find('/');
-	return (pos == string::npos) ? rest : rest.substr(0, pos);
+// Compare prefix in place, which avoids materializing any temporary string.
+bool HasPrefix(const string &filepath, const char *prefix, idx_t prefix_len) {
+	return filepath.compare(0, prefix_len, prefix, prefix_len) == 0;
 }
 
-// Precondition: [`filepath`] starts with [`gs://`].
-string GetGcsBucket(const string &filepath) {
-	string rest = filepath.substr(5);
-	auto pos = rest.find('/');
-	return (pos == string::npos) ? rest : rest.substr(0, pos);
+// Get bucket name out of an object storage path, with the given scheme prefix already matched.
+StringSlice GetBucketAfterPrefix(const string &filepath, idx_t prefix_len) {
+	StringSlice bucket;
+	bucket.data = filepath.data() + prefix_len;
+	const auto pos = filepath.find('/', prefix_len);
+	bucket.size = (pos == string::npos) ? filepath.size() - prefix_len : pos - prefix_len;
+	return bucket;
 }
 
 } // namespace
 
-string GetObjectStorageBucket(const string &filepath) {
-	if (StringUtil::StartsWith(filepath, S3_PREFIX)) {
-		return GetS3Bucket(filepath);
+StringSlice GetObjectStorageBucketSlice(const string &filepath) {
+	const idx_t s3_prefix_len = std::strlen(S3_PREFIX);
+	if (HasPrefix(filepath, S3_PREFIX, s3_prefix_len)) {
+		return GetBucketAfterPrefix(filepath, s3_prefix_len);
 	}
-	if (StringUtil::StartsWith(filepath, GCS_PREFIX)) {
-		return GetGcsBucket(filepath);
+	const idx_t gcs_prefix_len = std::strlen(GCS_PREFIX);
+	if (HasPrefix(filepath, GCS_PREFIX, gcs_prefix_len)) {
+		return GetBucketAfterPrefix(filepath, gcs_prefix_len);
+	}
+	return StringSlice {};
+}
+
+string GetObjectStorageBucket(const string &filepath) {
+	return GetObjectStorageBucketSlice(filepath).ToString();
+}
+
+string GetFileType(const string &filepath) {
+	const auto path_end = std::min(filepath.find('?'), filepath.find('#'));
+	const auto path = filepath.substr(0, path_end);
+	const auto slash_pos = path.rfind('/');
+	const auto dot_pos = path.rfind('.');
+	if (dot_pos == string::npos || (slash_pos != string::npos && dot_pos < slash_pos) || dot_pos + 1 == path.size()) {
+		return "";
 	}
-	return "";
+	return StringUtil::Lower(path.substr(dot_pos + 1));
 }
 
 } // namespace duckdb
@@ -0,0 +1,36 @@
+#include "thread_sharded_state.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace duckdb {
+
+namespace {
+// Min and max number of shards, used to bound memory footprint.
+constexpr idx_t MIN_SHARD_COUNT = 8;
+constexpr idx_t MAX_SHARD_COUNT = 128;
+
+// Next slot to assign to a newly seen thread.
+std::atomic<idx_t> g_next_thread_slot {0};
+
+idx_t ComputeThreadShardCount() {
+	const idx_t hardware_concurrency = static_cast<idx_t>(std::thread::hardware_concurrency());
+	idx_t shard_count = MIN_SHARD_COUNT;
+	while (shard_count < hardware_concurrency && shard_count < MAX_SHARD_COUNT) {
+		shard_count *= 2;
+	}
+	return shard_count;
+}
+} // namespace
+
+idx_t GetThreadShardSlot() {
+	thread_local const idx_t slot = g_next_thread_slot.fetch_add(1, std::memory_order_relaxed);
+	return slot;
+}
+
+idx_t GetThreadShardCount() {
+	static const idx_t shard_count = ComputeThreadShardCount();
+	return shard_count;
+}
+
+} // namespace duckdb
@@ -1,9 +1,179 @@
 #include "time_utils.hpp"
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <mutex>
+
+#include "duckdb/common/typedefs.hpp"
+#include "no_destructor.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define OBSERVEFS_HAS_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
 
 namespace {
 constexpr uint64_t kMilliToNanos = 1000ULL * 1000ULL;
+// Duration to busy wait for the initial TSC frequency calibration, which is refined by later recalibrations.
+constexpr int64_t kTscCalibrationNanos = 20 * kMilliToNanos;
+
+#ifdef OBSERVEFS_HAS_TSC
+// Max deviation of TSC from steady clock between two calibrations, in ratio of the elapsed time; it's well above
+// steady clock slewing, so only a TSC ticking at unstable rate exceeds it.
+constexpr double kMaxTscDriftRatio = 0.01;
+
+uint64_t ReadTsc() {
+	return __rdtsc();
+}
+
+// Invariant TSC ticks at a constant rate regardless of CPU frequency and power states, which is required to convert
+// ticks into wall time.
+bool HasInvariantTsc() {
+	constexpr unsigned int kExtendedPowerLeaf = 0x80000007;
+	constexpr unsigned int kInvariantTscBit = 1U << 8;
+#ifdef _MSC_VER
+	int regs[4];
+	__cpuid(regs, 0x80000000);
+	if (static_cast<unsigned int>(regs[0]) < kExtendedPowerLeaf) {
+		return false;
+	}
+	__cpuid(regs, kExtendedPowerLeaf);
+	return (static_cast<unsigned int>(regs[3]) & kInvariantTscBit) != 0;
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+	if (__get_cpuid(kExtendedPowerLeaf, &eax, &ebx, &ecx, &edx) == 0) {
+		return false;
+	}
+	return (edx & kInvariantTscBit) != 0;
+#endif
+}
+
+// Maps TSC ticks onto steady clock timeline, and recalibrates periodically against steady clock.
+//
+// Two calibrations are kept, readers use the current one while the other one is rewritten and then published; a
+// reader could only observe a calibration being rewritten if it's preempted for two recalibration intervals.
+class TscClock {
+public:
+	TscClock() {
+		if (!HasInvariantTsc()) {
+			return;
+		}
+		auto &calibration = calibrations[0];
+		const int64_t base_nanos = duckdb::GetSteadyNowNanoSecSinceEpoch();
+		const uint64_t base_ticks = ReadTsc();
+		int64_t cur_nanos = base_nanos;
+		while (cur_nanos - base_nanos < kTscCalibrationNanos) {
+			cur_nanos = duckdb::GetSteadyNowNanoSecSinceEpoch();
+		}
+		const uint64_t cur_ticks = ReadTsc();
+		if (cur_ticks <= base_ticks) {
+			return;
+		}
+		const double nanos_per_tick =
+		    static_cast<double>(cur_nanos - base_nanos) / static_cast<double>(cur_ticks - base_ticks);
+		calibration.base_ticks.store(cur_ticks, std::memory_order_relaxed);
+		calibration.base_nanos.store(cur_nanos, std::memory_order_relaxed);
+		calibration.nanos_per_tick.store(nanos_per_tick, std::memory_order_relaxed);
+		next_recalibration_ticks.store(cur_ticks + GetRecalibrationIntervalTicks(nanos_per_tick),
+		                               std::memory_order_relaxed);
+		stable.store(true, std::memory_order_release);
+	}
+
+	bool IsStable() const {
+		return stable.load(std::memory_order_acquire);
+	}
+
+	int64_t NowNanoSec() {
+		const uint64_t now_ticks = ReadTsc();
+		if (now_ticks >= next_recalibration_ticks.load(std::memory_order_relaxed)) {
+			MaybeRecalibrate();
+		}
+		if (!IsStable()) {
+			return duckdb::GetSteadyNowNanoSecSinceEpoch();
+		}
+		const auto &calibration = calibrations[cur_calibration_idx.load(std::memory_order_acquire)];
+		const auto elapsed_ticks =
+		    static_cast<int64_t>(now_ticks - calibration.base_ticks.load(std::memory_order_relaxed));
+		return calibration.base_nanos.load(std::memory_order_relaxed) +
+		       static_cast<int64_t>(static_cast<double>(elapsed_ticks) *
+		                            calibration.nanos_per_tick.load(std::memory_order_relaxed));
+	}
+
+private:
+	struct Calibration {
+		std::atomic<uint64_t> base_ticks {0};
+		std::atomic<int64_t> base_nanos {0};
+		std::atomic<double> nanos_per_tick {0.0};
+	};
+
+	static uint64_t GetRecalibrationIntervalTicks(double nanos_per_tick) {
+		return static_cast<uint64_t>(static_cast<double>(duckdb::TSC_RECALIBRATION_INTERVAL_NS) / nanos_per_tick);
+	}
+
+	// Compare TSC against steady clock since the current calibration, and either publish a new calibration over the
+	// whole interval, or mark TSC unstable. Skipped if another thread is recalibrating.
+	void MaybeRecalibrate() {
+		std::unique_lock<std::mutex> lck(recalibration_mu, std::try_to_lock);
+		if (!lck.owns_lock() || !IsStable()) {
+			return;
+		}
+		const uint64_t now_ticks = ReadTsc();
+		const int64_t now_nanos = duckdb::GetSteadyNowNanoSecSinceEpoch();
+		if (now_ticks < next_recalibration_ticks.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		const duckdb::idx_t cur_idx = cur_calibration_idx.load(std::memory_order_relaxed);
+		const auto &cur_calibration = calibrations[cur_idx];
+		const uint64_t base_ticks = cur_calibration.base_ticks.load(std::memory_order_relaxed);
+		const int64_t base_nanos = cur_calibration.base_nanos.load(std::memory_order_relaxed);
+		const double nanos_per_tick = cur_calibration.nanos_per_tick.load(std::memory_order_relaxed);
+		const double elapsed_nanos = static_cast<double>(now_nanos - base_nanos);
+		if (now_ticks <= base_ticks || elapsed_nanos <= 0) {
+			stable.store(false, std::memory_order_release);
+			return;
+		}
+		const double elapsed_ticks = static_cast<double>(now_ticks - base_ticks);
+		if (std::abs(elapsed_ticks * nanos_per_tick - elapsed_nanos) > elapsed_nanos * kMaxTscDriftRatio) {
+			stable.store(false, std::memory_order_release);
+			return;
+		}
+
+		auto &new_calibration = calibrations[1 - cur_idx];
+		const double new_nanos_per_tick = elapsed_nanos / elapsed_ticks;
+		new_calibration.base_ticks.store(now_ticks, std::memory_order_relaxed);
+		new_calibration.base_nanos.store(now_nanos, std::memory_order_relaxed);
+		new_calibration.nanos_per_tick.store(new_nanos_per_tick, std::memory_order_relaxed);
+		cur_calibration_idx.store(1 - cur_idx, std::memory_order_release);
+		next_recalibration_ticks.store(now_ticks + GetRecalibrationIntervalTicks(new_nanos_per_tick),
+		                               std::memory_order_relaxed);
+	}
+
+	std::array<Calibration, 2> calibrations;
+	std::atomic<duckdb::idx_t> cur_calibration_idx {0};
+	// TSC tick, after which the next timestamp triggers recalibration.
+	std::atomic<uint64_t> next_recalibration_ticks {0};
+	// Whether TSC is invariant and hasn't drifted from steady clock; once unstable, it's never used again.
+	std::atomic<bool> stable {false};
+	std::mutex recalibration_mu;
+};
+
+TscClock &GetTscClock() {
+	static duckdb::NoDestructor<TscClock> tsc_clock;
+	return *tsc_clock;
+}
+#endif
+
 } // namespace
 
 namespace duckdb {
@@ -26,4 +196,21 @@ int64_t GetSystemNowMilliSecSinceEpoch() {
 	return GetSystemNowNanoSecSinceEpoch() / kMilliToNanos;
 }
 
+bool IsTscClockSupported() {
+#ifdef OBSERVEFS_HAS_TSC
+	return GetTscClock().IsStable();
+#else
+	return false;
+#endif
+}
+
+int64_t GetLatencyClockNowNanoSec(LatencyClockSource clock_source) {
+#ifdef OBSERVEFS_HAS_TSC
+	if (clock_source == LatencyClockSource::kTsc) {
+		return GetTscClock().NowNanoSec();
+	}
+#endif
+	return GetSteadyNowNanoSecSinceEpoch();
+}
+
 } // namespace duckdb
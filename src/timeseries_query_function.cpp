@@ -0,0 +1,88 @@
+#include "timeseries_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "io_operation.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct TimeSeriesRow {
+	string filesystem;
+	int64_t timestamp_ms = 0;
+	double interval_sec = 0.0;
+	TimeSeriesPoint point;
+};
+
+unique_ptr<FunctionData> ObservefsTimeSeriesQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                          vector<LogicalType> &return_types, vector<string> &names) {
+	BindQueryFunctionColumns(
+	    {
+	        // Wall clock timestamp at the end of the sample.
+	        {"timestamp", LogicalTypeId::TIMESTAMP},
+	        // Length of the sample, rates are averaged over it.
+	        {"interval_sec", LogicalTypeId::DOUBLE},
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        // NULL for overall stats of the filesystem.
+	        {"bucket", LogicalTypeId::VARCHAR},
+	        {"operation", LogicalTypeId::VARCHAR},
+	        {"ops_per_sec", LogicalTypeId::DOUBLE},
+	        {"bytes_per_sec", LogicalTypeId::DOUBLE},
+	        {"p50_latency_us", LogicalTypeId::DOUBLE},
+	        {"p99_latency_us", LogicalTypeId::DOUBLE},
+	    },
+	    return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsTimeSeriesQueryFuncInit(ClientContext &context,
+                                                                      TableFunctionInitInput &input) {
+	auto result = make_uniq<MaterializedRowsData<TimeSeriesRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto filesystem = cur_filesystem->GetName();
+		auto ticks = cur_filesystem->GetTimeSeries();
+		for (auto &cur_tick : ticks) {
+			for (auto &cur_point : cur_tick.points) {
+				TimeSeriesRow row;
+				row.filesystem = filesystem;
+				row.timestamp_ms = cur_tick.timestamp_ms;
+				row.interval_sec = cur_tick.interval_sec;
+				row.point = std::move(cur_point);
+				result->rows.emplace_back(std::move(row));
+			}
+		}
+	}
+	return std::move(result);
+}
+
+void EmitTimeSeriesRow(const TimeSeriesRow &row, DataChunk &output, idx_t row_idx) {
+	SetColumnValue<timestamp_t>(output.data[0], row_idx, Timestamp::FromEpochMs(row.timestamp_ms));
+	SetColumnValue<double>(output.data[1], row_idx, row.interval_sec);
+	SetStringColumnValue(output.data[2], row_idx, row.filesystem);
+	SetStringColumnValueOrNull(output.data[3], row_idx, row.point.bucket);
+	SetStringColumnValue(output.data[4], row_idx, OPER_NAMES[static_cast<idx_t>(row.point.io_oper)]);
+	SetColumnValue<double>(output.data[5], row_idx, row.point.ops_per_sec);
+	SetColumnValue<double>(output.data[6], row_idx, row.point.bytes_per_sec);
+	SetColumnValue<double>(output.data[7], row_idx, row.point.p50_latency_us);
+	SetColumnValue<double>(output.data[8], row_idx, row.point.p99_latency_us);
+}
+
+} // namespace
+
+TableFunction ObservefsTimeSeriesQueryFunc() {
+	TableFunction timeseries_query_func {/*name=*/"observefs_timeseries",
+	                                     /*arguments=*/ {},
+	                                     /*function=*/EmitMaterializedRows<TimeSeriesRow, EmitTimeSeriesRow>,
+	                                     /*bind=*/ObservefsTimeSeriesQueryFuncBind,
+	                                     /*init_global=*/ObservefsTimeSeriesQueryFuncInit};
+	return timeseries_query_func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,77 @@
+#include "timeseries_sampler.hpp"
+
+#include "duckdb/common/helper.hpp"
+
+namespace duckdb {
+
+constexpr idx_t TimeSeriesSampler::MAX_TICK_COUNT;
+
+namespace {
+constexpr double NANOS_PER_SEC = 1000.0 * 1000 * 1000;
+} // namespace
+
+TimeSeriesSampler::CumulativeStats::CumulativeStats() : latency_histogram(make_uniq<Histogram>()) {
+}
+
+void TimeSeriesSampler::AddTick(int64_t steady_timestamp_ns, int64_t system_timestamp_ms,
+                                CumulativeStatsMap current_stats) {
+	if (!has_baseline || steady_timestamp_ns <= last_steady_timestamp_ns) {
+		has_baseline = true;
+		last_steady_timestamp_ns = steady_timestamp_ns;
+		previous_stats = std::move(current_stats);
+		return;
+	}
+
+	TimeSeriesTick tick;
+	tick.timestamp_ms = system_timestamp_ms;
+	tick.interval_sec = static_cast<double>(steady_timestamp_ns - last_steady_timestamp_ns) / NANOS_PER_SEC;
+	for (const auto &key_and_stats : current_stats) {
+		const auto &cur_stats = key_and_stats.second;
+		Histogram delta_histogram;
+		delta_histogram.Merge(*cur_stats.latency_histogram);
+		double delta_bytes = cur_stats.bytes;
+
+		// Previous stats are ignored if metrics have been reset since then.
+		auto iter = previous_stats.find(key_and_stats.first);
+		if (iter != previous_stats.end() &&
+		    iter->second.latency_histogram->counts() <= cur_stats.latency_histogram->counts()) {
+			delta_histogram.Subtract(*iter->second.latency_histogram);
+			delta_bytes -= iter->second.bytes;
+		}
+		if (delta_histogram.counts() == 0) {
+			continue;
+		}
+
+		TimeSeriesPoint point;
+		point.bucket = key_and_stats.first.first;
+		point.io_oper = key_and_stats.first.second;
+		point.ops_per_sec = static_cast<double>(delta_histogram.counts()) / tick.interval_sec;
+		point.bytes_per_sec = delta_bytes / tick.interval_sec;
+		point.p50_latency_us = delta_histogram.Quantile(0.50);
+		point.p99_latency_us = delta_histogram.Quantile(0.99);
+		tick.points.emplace_back(std::move(point));
+	}
+
+	last_steady_timestamp_ns = steady_timestamp_ns;
+	previous_stats = std::move(current_stats);
+	if (tick.points.empty()) {
+		return;
+	}
+	ticks.emplace_back(std::move(tick));
+	if (ticks.size() > MAX_TICK_COUNT) {
+		ticks.pop_front();
+	}
+}
+
+vector<TimeSeriesTick> TimeSeriesSampler::GetTicks() const {
+	return vector<TimeSeriesTick>(ticks.begin(), ticks.end());
+}
+
+void TimeSeriesSampler::Reset() {
+	has_baseline = false;
+	last_steady_timestamp_ns = 0;
+	previous_stats.clear();
+	ticks.clear();
+}
+
+} // namespace duckdb
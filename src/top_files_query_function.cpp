@@ -0,0 +1,109 @@
+#include "top_files_query_function.hpp"
+
+#include <utility>
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "observability_filesystem.hpp"
+#include "query_function_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Valid values for `order_by` parameter.
+constexpr const char *TOP_FILES_ORDER_BY_REQUESTS = "requests";
+constexpr const char *TOP_FILES_ORDER_BY_BYTES = "bytes";
+constexpr const char *TOP_FILES_ORDER_BY_LATENCY = "latency";
+
+struct TopFilesBindData : public TableFunctionData {
+	// Number of top files to return for each filesystem.
+	idx_t k = 0;
+	TopFilesOrder order = TopFilesOrder::kRequests;
+};
+
+struct TopFilesRow {
+	string filesystem;
+	FileAccessStats file_stats;
+};
+
+unique_ptr<FunctionData> ObservefsTopFilesQueryFuncBind(ClientContext &context, TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types, vector<string> &names) {
+	const auto k = input.inputs[0].GetValue<int64_t>();
+	if (k <= 0) {
+		throw InvalidInputException("Number of top files should be positive, but got %d", k);
+	}
+	auto bind_data = make_uniq<TopFilesBindData>();
+	bind_data->k = static_cast<idx_t>(k);
+	auto order_by_iter = input.named_parameters.find("order_by");
+	if (order_by_iter != input.named_parameters.end()) {
+		const auto order_by = StringUtil::Lower(order_by_iter->second.ToString());
+		if (order_by == TOP_FILES_ORDER_BY_REQUESTS) {
+			bind_data->order = TopFilesOrder::kRequests;
+		} else if (order_by == TOP_FILES_ORDER_BY_BYTES) {
+			bind_data->order = TopFilesOrder::kBytes;
+		} else if (order_by == TOP_FILES_ORDER_BY_LATENCY) {
+			bind_data->order = TopFilesOrder::kLatency;
+		} else {
+			throw InvalidInputException("Unknown top files order %s, valid options are '%s', '%s' and '%s'", order_by,
+			                            TOP_FILES_ORDER_BY_REQUESTS, TOP_FILES_ORDER_BY_BYTES,
+			                            TOP_FILES_ORDER_BY_LATENCY);
+		}
+	}
+
+	BindQueryFunctionColumns(
+	    {
+	        {"filesystem", LogicalTypeId::VARCHAR},
+	        {"path", LogicalTypeId::VARCHAR},
+	        // Estimated request count, which never underestimates.
+	        {"requests", LogicalTypeId::UBIGINT},
+	        // Max overestimation of request count, 0 means the count is exact.
+	        {"requests_error", LogicalTypeId::UBIGINT},
+	        // Bytes and latency are only accumulated since the file is tracked.
+	        {"bytes", LogicalTypeId::UBIGINT},
+	        {"total_latency_us", LogicalTypeId::DOUBLE},
+	    },
+	    return_types, names);
+	return std::move(bind_data);
+}
+
+unique_ptr<GlobalTableFunctionState> ObservefsTopFilesQueryFuncInit(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	const auto &bind_data = input.bind_data->Cast<TopFilesBindData>();
+	auto result = make_uniq<MaterializedRowsData<TopFilesRow>>();
+	for (auto *cur_filesystem : GetAllObservabilityFs(context)) {
+		const auto filesystem = cur_filesystem->GetName();
+		auto top_files = cur_filesystem->GetTopFiles(bind_data.k, bind_data.order);
+		for (auto &cur_file_stats : top_files) {
+			TopFilesRow row {filesystem, std::move(cur_file_stats)};
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	return std::move(result);
+}
+
+void EmitTopFilesRow(const TopFilesRow &row, DataChunk &output, idx_t row_idx) {
+	SetStringColumnValue(output.data[0], row_idx, row.filesystem);
+	SetStringColumnValue(output.data[1], row_idx, row.file_stats.path);
+	SetColumnValue<uint64_t>(output.data[2], row_idx, row.file_stats.request_count);
+	SetColumnValue<uint64_t>(output.data[3], row_idx, row.file_stats.request_count_error);
+	SetColumnValue<uint64_t>(output.data[4], row_idx, row.file_stats.bytes);
+	SetColumnValue<double>(output.data[5], row_idx, row.file_stats.total_latency_microsec);
+}
+
+} // namespace
+
+TableFunction ObservefsTopFilesQueryFunc() {
+	TableFunction top_files_query_func {/*name=*/"observefs_top_files",
+	                                    /*arguments=*/ {LogicalTypeId::BIGINT},
+	                                    /*function=*/EmitMaterializedRows<TopFilesRow, EmitTopFilesRow>,
+	                                    /*bind=*/ObservefsTopFilesQueryFuncBind,
+	                                    /*init_global=*/ObservefsTopFilesQueryFuncInit};
+	top_files_query_func.named_parameters["order_by"] = LogicalType {LogicalTypeId::VARCHAR};
+	return top_files_query_func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,29 @@
+#include "top_files_sketch.hpp"
+
+#include "duckdb/common/assert.hpp"
+
+namespace duckdb {
+
+void FileAccessStats::RecordOperationStart(int64_t bytes_p) {
+	++request_count;
+	bytes += static_cast<uint64_t>(bytes_p);
+}
+
+void FileAccessStats::RecordOperationEnd(double latency_microsec) {
+	total_latency_microsec += latency_microsec;
+}
+
+void FileAccessStats::Merge(const FileAccessStats &other) {
+	D_ASSERT(path == other.path);
+	request_count += other.request_count;
+	request_count_error += other.request_count_error;
+	bytes += other.bytes;
+	total_latency_microsec += other.total_latency_microsec;
+}
+
+void FileAccessStats::ResetTrackedStats() {
+	bytes = 0;
+	total_latency_microsec = 0.0;
+}
+
+} // namespace duckdb
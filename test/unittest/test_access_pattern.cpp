@@ -0,0 +1,102 @@
+#include "catch/catch.hpp"
+
+#include "access_pattern.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t READ_SIZE = 1000;
+
+// Get stats for one closed handle.
+AccessPatternStats GetStats(const AccessPatternTracker &tracker) {
+	AccessPatternStats stats;
+	stats.RecordHandleClose(tracker);
+	return stats;
+}
+} // namespace
+
+TEST_CASE("Access pattern classification test", "[access pattern test]") {
+	// Single read has no transition.
+	{
+		AccessPatternTracker tracker;
+		tracker.RecordRead(/*location=*/0, READ_SIZE);
+		REQUIRE(tracker.Classify() == AccessPattern::kUnknown);
+	}
+	// Sequential scan.
+	{
+		AccessPatternTracker tracker;
+		for (idx_t idx = 0; idx < 10; ++idx) {
+			tracker.RecordRead(/*location=*/idx * READ_SIZE, READ_SIZE);
+		}
+		REQUIRE(tracker.Classify() == AccessPattern::kSequential);
+	}
+	// Strided reads, i.e., one column out of every four.
+	{
+		AccessPatternTracker tracker;
+		for (idx_t idx = 0; idx < 10; ++idx) {
+			tracker.RecordRead(/*location=*/idx * 4 * READ_SIZE, READ_SIZE);
+		}
+		REQUIRE(tracker.Classify() == AccessPattern::kStrided);
+	}
+	// Random reads.
+	{
+		AccessPatternTracker tracker;
+		for (idx_t location : {9000, 1000, 7000, 2000, 5000, 0}) {
+			tracker.RecordRead(location, READ_SIZE);
+		}
+		REQUIRE(tracker.Classify() == AccessPattern::kRandom);
+	}
+}
+
+TEST_CASE("Access pattern readahead suggestion test", "[access pattern test]") {
+	// Sequential reads are all served by readahead of one read size, rounded up to power of two.
+	{
+		AccessPatternTracker tracker;
+		for (idx_t idx = 0; idx < 10; ++idx) {
+			tracker.RecordRead(/*location=*/idx * READ_SIZE, READ_SIZE);
+		}
+		const auto stats = GetStats(tracker);
+		REQUIRE(stats.GetTransitionRatio(AccessPattern::kSequential) == 1.0);
+		REQUIRE(stats.GetSuggestedReadaheadBytes() == 1024);
+		REQUIRE(stats.GetAvoidableRequestCount(/*readahead_bytes=*/1024) == 9);
+		REQUIRE(stats.GetAvoidableRequestCount(/*readahead_bytes=*/512) == 0);
+	}
+	// Distance of exactly a power of two is covered by it.
+	{
+		AccessPatternTracker tracker;
+		tracker.RecordRead(/*location=*/0, /*nr_bytes=*/1024);
+		tracker.RecordRead(/*location=*/1024, /*nr_bytes=*/1024);
+		REQUIRE(GetStats(tracker).GetSuggestedReadaheadBytes() == 1024);
+	}
+	// Readahead doesn't help backward reads.
+	{
+		AccessPatternTracker tracker;
+		for (idx_t idx = 10; idx > 0; --idx) {
+			tracker.RecordRead(/*location=*/idx * 2 * READ_SIZE, READ_SIZE);
+		}
+		REQUIRE(GetStats(tracker).GetSuggestedReadaheadBytes() == 0);
+	}
+}
+
+TEST_CASE("Access pattern collector test", "[access pattern test]") {
+	AccessPatternTracker tracker;
+	tracker.RecordRead(/*location=*/0, READ_SIZE);
+	tracker.RecordRead(/*location=*/READ_SIZE, READ_SIZE);
+
+	AccessPatternCollector collector;
+	collector.RecordHandleClose("s3://bucket/a.parquet", tracker);
+	collector.RecordHandleClose("s3://bucket/b.parquet", tracker);
+	collector.RecordHandleClose("/tmp/c.csv", tracker);
+
+	AccessPatternCollector merged_collector;
+	merged_collector.Merge(collector);
+	const auto &all_stats = merged_collector.GetAllStats();
+	REQUIRE(all_stats.size() == 2);
+	const auto &parquet_stats = *all_stats.at(std::make_pair(string("bucket"), string("parquet")));
+	REQUIRE(parquet_stats.handle_count == 2);
+	REQUIRE(parquet_stats.read_count == 4);
+	REQUIRE(all_stats.at(std::make_pair(string(""), string("csv")))->handle_count == 1);
+
+	merged_collector.Reset();
+	REQUIRE(merged_collector.GetAllStats().empty());
+}
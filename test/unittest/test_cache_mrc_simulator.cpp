@@ -0,0 +1,74 @@
+#include "catch/catch.hpp"
+
+#include "cache_mrc_simulator.hpp"
+#include "duckdb/common/string.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr idx_t MIB = 1024 * 1024;
+
+// Scan [file_size] bytes of [path] sequentially with 1MiB reads.
+void ScanFile(CacheMrcSimulator &simulator, const string &path, idx_t file_size) {
+	for (idx_t offset = 0; offset < file_size; offset += MIB) {
+		simulator.RecordRead(path, offset, MIB);
+	}
+}
+} // namespace
+
+TEST_CASE("Cache MRC simulator disabled test", "[cache mrc simulator test]") {
+	CacheMrcSimulator simulator;
+	ScanFile(simulator, "s3://bucket/a.parquet", 4 * MIB);
+	const auto curve = simulator.GetMissRatioCurve();
+	REQUIRE(curve.sampled_access_count == 0);
+	REQUIRE(curve.points.size() == CacheMrcSimulator::CACHE_SIZE_COUNT);
+	REQUIRE(curve.points[0].cache_size_bytes == 64 * MIB);
+	REQUIRE(curve.points[1].cache_size_bytes == 256 * MIB);
+	REQUIRE(curve.points[0].hit_ratio == 0.0);
+}
+
+TEST_CASE("Cache MRC simulator exact test", "[cache mrc simulator test]") {
+	CacheMrcSimulator simulator;
+	simulator.SetEnabled(true);
+
+	// Scan a 128MiB file twice, which only hits if the cache holds the whole file.
+	ScanFile(simulator, "s3://bucket/a.parquet", 128 * MIB);
+	ScanFile(simulator, "s3://bucket/a.parquet", 128 * MIB);
+	const auto curve = simulator.GetMissRatioCurve();
+	REQUIRE(curve.block_size == CacheMrcSimulator::DEFAULT_BLOCK_SIZE);
+	REQUIRE(curve.sampled_access_count == 256);
+	REQUIRE(curve.sample_rate == 1.0);
+	REQUIRE(curve.points[0].hit_ratio == 0.0);
+	REQUIRE(curve.points[1].hit_ratio == 0.5);
+
+	// Reads covering multiple blocks reference each of them, which hit in all cache sizes.
+	simulator.RecordRead("s3://bucket/a.parquet", /*location=*/MIB / 2, /*nr_bytes=*/MIB);
+	REQUIRE(simulator.GetMissRatioCurve().sampled_access_count == 258);
+
+	// Changing block size resets the simulation.
+	simulator.SetBlockSize(64 * 1024);
+	REQUIRE(simulator.GetMissRatioCurve().sampled_access_count == 0);
+	ScanFile(simulator, "s3://bucket/a.parquet", 2 * MIB);
+	REQUIRE(simulator.GetMissRatioCurve().sampled_access_count == 32);
+
+	simulator.Reset();
+	REQUIRE(simulator.GetMissRatioCurve().sampled_access_count == 0);
+}
+
+TEST_CASE("Cache MRC simulator sampling test", "[cache mrc simulator test]") {
+	CacheMrcSimulator simulator;
+	simulator.SetEnabled(true);
+	simulator.SetBlockSize(64 * 1024);
+
+	// Working set of 2GiB with 64KiB blocks exceeds tracked block count, so blocks are sampled.
+	ScanFile(simulator, "s3://bucket/a.parquet", 2048 * MIB);
+	ScanFile(simulator, "s3://bucket/a.parquet", 2048 * MIB);
+	const auto curve = simulator.GetMissRatioCurve();
+	REQUIRE(curve.sample_rate < 1.0);
+
+	// Cache smaller than the working set never hits on a cyclic scan, while larger cache hits on the second scan.
+	REQUIRE(curve.points[0].hit_ratio < 0.05);
+	REQUIRE(curve.points[2].hit_ratio < 0.05);
+	REQUIRE(curve.points[3].hit_ratio > 0.3);
+	REQUIRE(curve.points[3].hit_ratio <= 0.5);
+}
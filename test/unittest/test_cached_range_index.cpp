@@ -0,0 +1,33 @@
+#include "catch/catch.hpp"
+
+#include "cached_range_index.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("Cached range index lookup test", "[cached range index test]") {
+	CachedRangeIndex index;
+	// Ranges are added out of order, with [100, 200) and [200, 300) adjacent, and [250, 280) overlapping.
+	index.AddRange("s3://bucket/a", /*location=*/200, /*nr_bytes=*/100);
+	index.AddRange("s3://bucket/a", /*location=*/100, /*nr_bytes=*/100);
+	index.AddRange("s3://bucket/a", /*location=*/250, /*nr_bytes=*/30);
+	index.AddRange("s3://bucket/a", /*location=*/500, /*nr_bytes=*/100);
+	index.AddRange("s3://bucket/b", /*location=*/0, /*nr_bytes=*/10);
+	index.Finalize();
+
+	// Request within a cached range, including one not aligned with its start.
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/100, /*nr_bytes=*/100) == 100);
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/150, /*nr_bytes=*/20) == 20);
+	// Request spanning adjacent cached ranges is fully covered.
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/150, /*nr_bytes=*/100) == 100);
+	// Request spanning a gap between cached ranges is partially covered.
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/250, /*nr_bytes=*/300) == 100);
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/0, /*nr_bytes=*/1000) == 300);
+	// Request outside of cached ranges.
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/0, /*nr_bytes=*/100) == 0);
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/300, /*nr_bytes=*/200) == 0);
+	REQUIRE(index.GetCachedBytes("s3://bucket/a", /*location=*/600, /*nr_bytes=*/10) == 0);
+	// Ranges are indexed per path.
+	REQUIRE(index.GetCachedBytes("s3://bucket/b", /*location=*/0, /*nr_bytes=*/100) == 10);
+	REQUIRE(index.GetCachedBytes("s3://bucket/c", /*location=*/0, /*nr_bytes=*/100) == 0);
+	REQUIRE(index.GetCachedBytes("s3://bucket/b", /*location=*/0, /*nr_bytes=*/0) == 0);
+}
@@ -0,0 +1,82 @@
+#include "catch/catch.hpp"
+
+#include <cmath>
+
+#include "ddsketch.hpp"
+#include "duckdb/common/vector.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+// Whether [actual] is within relative error of [expected].
+bool IsWithinRelativeError(double actual, double expected, double relative_error) {
+	return std::abs(actual - expected) <= expected * relative_error;
+}
+} // namespace
+
+TEST_CASE("Empty sketch test", "[ddsketch test]") {
+	DDSketch sketch;
+	REQUIRE(sketch.Count() == 0);
+	REQUIRE(sketch.Quantile(0.5) == 0);
+}
+
+TEST_CASE("Sketch quantile test", "[ddsketch test]") {
+	DDSketch sketch;
+	for (int val = 1; val <= 100000; ++val) {
+		sketch.Add(val);
+	}
+	REQUIRE(sketch.Count() == 100000);
+	REQUIRE(sketch.Quantile(0) == 1);
+	REQUIRE(sketch.Quantile(1) == 100000);
+	for (double q : {0.5, 0.9, 0.99, 0.999, 0.9999}) {
+		REQUIRE(IsWithinRelativeError(sketch.Quantile(q), q * 100000, DDSketch::DEFAULT_RELATIVE_ACCURACY));
+	}
+
+	// Zero is tracked separately from positive values.
+	sketch.Reset();
+	sketch.Add(0);
+	sketch.Add(0);
+	sketch.Add(10);
+	sketch.Add(10);
+	REQUIRE(sketch.Quantile(0.3) == 0);
+	REQUIRE(IsWithinRelativeError(sketch.Quantile(0.99), 10, DDSketch::DEFAULT_RELATIVE_ACCURACY));
+}
+
+TEST_CASE("Sketch merge test", "[ddsketch test]") {
+	DDSketch merged;
+	DDSketch whole;
+	DDSketch lower;
+	DDSketch upper;
+	for (int val = 1; val <= 5000; ++val) {
+		lower.Add(val);
+		whole.Add(val);
+	}
+	for (int val = 5001; val <= 10000; ++val) {
+		upper.Add(val);
+		whole.Add(val);
+	}
+	merged.Merge(lower);
+	merged.Merge(upper);
+
+	// Merge is lossless, so merged sketch is identical to the one recording all values.
+	REQUIRE(merged.Count() == whole.Count());
+	for (double q : {0.0, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+		REQUIRE(merged.Quantile(q) == whole.Quantile(q));
+	}
+}
+
+TEST_CASE("Sketch bounded bucket test", "[ddsketch test]") {
+	DDSketch sketch;
+	// Values spanning far more buckets than the limit, lowest buckets get collapsed.
+	vector<double> values;
+	for (double val = 1e-3; val < 1e30; val *= 1.5) {
+		values.push_back(val);
+		sketch.Add(val);
+	}
+	REQUIRE(sketch.Count() == values.size());
+
+	// High quantiles keep accuracy guarantee.
+	const idx_t p99_rank = static_cast<idx_t>(std::floor(0.99 * (values.size() - 1)));
+	REQUIRE(IsWithinRelativeError(sketch.Quantile(0.99), values[p99_rank], DDSketch::DEFAULT_RELATIVE_ACCURACY));
+	REQUIRE(sketch.Quantile(0.01) >= values.front());
+}
@@ -0,0 +1,105 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/string.hpp"
+#include "external_file_cache_breakdown.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("Cache access record test", "[external file cache breakdown test]") {
+	CacheAccessRecord record;
+	record.RecordAccess(/*requested_bytes=*/100, /*cached_bytes=*/100);
+	record.RecordAccess(/*requested_bytes=*/100, /*cached_bytes=*/0);
+	record.RecordAccess(/*requested_bytes=*/100, /*cached_bytes=*/25);
+	record.RecordAccess(/*requested_bytes=*/100, /*cached_bytes=*/26);
+	record.RecordAccess(/*requested_bytes=*/100, /*cached_bytes=*/99);
+	REQUIRE(record.hit_count == 1);
+	REQUIRE(record.miss_count == 1);
+	REQUIRE(record.partial_hit_count == 3);
+	REQUIRE(record.GetAccessCount() == 5);
+	REQUIRE(record.hit_bytes == 250);
+	REQUIRE(record.miss_bytes == 250);
+	// Coverage buckets are (0%, 25%], (25%, 50%], (50%, 75%] and (75%, 100%).
+	REQUIRE(record.partial_hit_coverage_counts[0] == 1);
+	REQUIRE(record.partial_hit_coverage_counts[1] == 1);
+	REQUIRE(record.partial_hit_coverage_counts[2] == 0);
+	REQUIRE(record.partial_hit_coverage_counts[3] == 1);
+
+	CacheAccessRecord other;
+	other.RecordAccess(/*requested_bytes=*/10, /*cached_bytes=*/10);
+	record.Merge(other);
+	REQUIRE(record.hit_count == 2);
+	REQUIRE(record.hit_bytes == 260);
+}
+
+TEST_CASE("External file cache breakdown test", "[external file cache breakdown test]") {
+	ExternalFileCacheBreakdown breakdown;
+	breakdown.RecordAccess("s3://bucket-a/a.parquet", /*requested_bytes=*/100, /*cached_bytes=*/100);
+	breakdown.RecordAccess("s3://bucket-a/b.parquet", /*requested_bytes=*/100, /*cached_bytes=*/0);
+	breakdown.RecordAccess("s3://bucket-b/c.parquet", /*requested_bytes=*/100, /*cached_bytes=*/50);
+	// Paths without object storage bucket are only tracked by path.
+	breakdown.RecordAccess("https://example.com/d.csv", /*requested_bytes=*/100, /*cached_bytes=*/0);
+
+	const auto bucket_records = breakdown.GetBucketRecords();
+	REQUIRE(bucket_records.size() == 2);
+	REQUIRE(bucket_records[0].name == "bucket-a");
+	REQUIRE(bucket_records[0].record.hit_count == 1);
+	REQUIRE(bucket_records[0].record.miss_count == 1);
+	REQUIRE(bucket_records[1].name == "bucket-b");
+	REQUIRE(bucket_records[1].record.partial_hit_count == 1);
+	idx_t tracked_path_count = 0;
+	for (const auto &cur_path_record : breakdown.GetPathRecords()) {
+		if (cur_path_record->request_count > 0) {
+			++tracked_path_count;
+			REQUIRE(cur_path_record->request_count == 1);
+			REQUIRE(cur_path_record->request_count_error == 0);
+		}
+	}
+	REQUIRE(tracked_path_count == 4);
+	REQUIRE(breakdown.GetMinPathAccessCount() == 0);
+
+	breakdown.Reset();
+	for (const auto &cur_bucket_record : breakdown.GetBucketRecords()) {
+		REQUIRE(cur_bucket_record.record.GetAccessCount() == 0);
+	}
+	for (const auto &cur_path_record : breakdown.GetPathRecords()) {
+		REQUIRE(cur_path_record->path.empty());
+		REQUIRE(cur_path_record->request_count == 0);
+		REQUIRE(cur_path_record->record.GetAccessCount() == 0);
+	}
+}
+
+TEST_CASE("External file cache breakdown bounded path test", "[external file cache breakdown test]") {
+	ExternalFileCacheBreakdown breakdown;
+	// Frequently accessed path stays tracked when many paths are accessed once.
+	for (idx_t idx = 0; idx < 10; ++idx) {
+		breakdown.RecordAccess("s3://bucket/hot.parquet", /*requested_bytes=*/10, /*cached_bytes=*/10);
+	}
+	for (idx_t idx = 0; idx < ExternalFileCacheBreakdown::PATH_CAPACITY * 4; ++idx) {
+		breakdown.RecordAccess("s3://bucket/cold-" + std::to_string(idx), /*requested_bytes=*/10, /*cached_bytes=*/0);
+	}
+
+	const auto &path_records = breakdown.GetPathRecords();
+	REQUIRE(path_records.size() == ExternalFileCacheBreakdown::PATH_CAPACITY);
+	bool hot_path_tracked = false;
+	bool last_cold_path_tracked = false;
+	const auto last_cold_path = "s3://bucket/cold-" + std::to_string(ExternalFileCacheBreakdown::PATH_CAPACITY * 4 - 1);
+	for (const auto &cur_path_record : path_records) {
+		if (cur_path_record->path == "s3://bucket/hot.parquet") {
+			hot_path_tracked = true;
+			REQUIRE(cur_path_record->request_count == 10);
+			REQUIRE(cur_path_record->request_count_error == 0);
+			REQUIRE(cur_path_record->record.hit_count == 10);
+		}
+		// Newly tracked path inherits the evicted access count as error, so it doesn't get evicted right away, and
+		// its cache record only covers accesses since it's tracked.
+		if (cur_path_record->path == last_cold_path) {
+			last_cold_path_tracked = true;
+			REQUIRE(cur_path_record->request_count_error > 0);
+			REQUIRE(cur_path_record->request_count == cur_path_record->request_count_error + 1);
+			REQUIRE(cur_path_record->record.GetAccessCount() == 1);
+		}
+	}
+	REQUIRE(hot_path_tracked);
+	REQUIRE(last_cold_path_tracked);
+	REQUIRE(breakdown.GetMinPathAccessCount() > 0);
+}
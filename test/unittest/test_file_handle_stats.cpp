@@ -0,0 +1,53 @@
+#include "catch/catch.hpp"
+
+#include "file_handle_stats.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t NANOS_PER_MICRO = 1000;
+
+double GetMetric(const std::array<double, kFileHandleMetricCount> &metrics, FileHandleMetric metric) {
+	return metrics[static_cast<idx_t>(metric)];
+}
+} // namespace
+
+TEST_CASE("File handle counters test", "[file handle stats test]") {
+	FileHandleCounters counters {/*open_timestamp_ns=*/0};
+	// A footer read, followed by a sequential scan from the beginning.
+	counters.RecordRead(/*location=*/900, /*nr_bytes=*/100);
+	counters.RecordSeek();
+	counters.RecordRead(/*location=*/0, /*nr_bytes=*/300);
+	counters.RecordRead(/*location=*/300, /*nr_bytes=*/300);
+	counters.RecordRead(/*location=*/600, /*nr_bytes=*/300);
+	counters.GetIoWaitCounter().fetch_add(5 * NANOS_PER_MICRO);
+
+	const auto metrics = counters.GetMetrics(/*close_timestamp_ns=*/10 * NANOS_PER_MICRO);
+	REQUIRE(GetMetric(metrics, FileHandleMetric::kReadCount) == 4);
+	REQUIRE(GetMetric(metrics, FileHandleMetric::kReadBytes) == 1000);
+	REQUIRE(GetMetric(metrics, FileHandleMetric::kSeekCount) == 1);
+	REQUIRE(GetMetric(metrics, FileHandleMetric::kSequentialReadPercent) == 50.0);
+	REQUIRE(GetMetric(metrics, FileHandleMetric::kOpenDuration) == 10.0);
+	REQUIRE(GetMetric(metrics, FileHandleMetric::kIoWait) == 5.0);
+}
+
+TEST_CASE("File handle stats collector test", "[file handle stats test]") {
+	FileHandleStatsCollector collector;
+	REQUIRE(collector.GetHumanReadableStats().empty());
+
+	FileHandleCounters counters {/*open_timestamp_ns=*/0};
+	counters.RecordRead(/*location=*/0, /*nr_bytes=*/100);
+	collector.RecordHandleClose(counters.GetMetrics(/*close_timestamp_ns=*/NANOS_PER_MICRO));
+
+	FileHandleStatsCollector other_collector;
+	other_collector.RecordHandleClose(counters.GetMetrics(/*close_timestamp_ns=*/NANOS_PER_MICRO));
+	collector.Merge(other_collector);
+
+	const auto &histogram = collector.GetHistogram(FileHandleMetric::kReadBytes);
+	REQUIRE(histogram.counts() == 2);
+	REQUIRE(histogram.sum() == 200);
+	REQUIRE(collector.GetHumanReadableStats().find("Per-open read_bytes") != string::npos);
+
+	collector.Reset();
+	REQUIRE(collector.GetHumanReadableStats().empty());
+}
@@ -0,0 +1,76 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/virtual_file_system.hpp"
+#include "observability_filesystem.hpp"
+
+using namespace duckdb;
+
+namespace {
+
+class MockFileSystemWithExtendedList : public FileSystem {
+public:
+	bool ListFiles(const string &directory, const std::function<void(const string &, bool)> &callback,
+	               FileOpener *opener = nullptr) override {
+		++list_invocation;
+		callback("file1.parquet", /*is_dir=*/false);
+		return true;
+	}
+
+	uint64_t GetListInvocation() const {
+		return list_invocation;
+	}
+	uint64_t GetListExtendedInvocation() const {
+		return list_extended_invocation;
+	}
+
+	string GetName() const override {
+		return "mock_with_extended_list";
+	}
+
+protected:
+	bool ListFilesExtended(const string &directory, const std::function<void(OpenFileInfo &info)> &callback,
+	                       optional_ptr<FileOpener> opener) override {
+		++list_extended_invocation;
+		OpenFileInfo info("file1.parquet");
+		info.extended_info = make_shared_ptr<ExtendedOpenFileInfo>();
+		info.extended_info->options["file_size"] = Value::BIGINT(1024);
+		callback(info);
+		return true;
+	}
+	bool SupportsListFilesExtended() const override {
+		return true;
+	}
+
+private:
+	uint64_t list_invocation = 0;
+	uint64_t list_extended_invocation = 0;
+};
+
+} // namespace
+
+TEST_CASE("Test ListFiles forwards extended listing", "[extended list test]") {
+	VirtualFileSystem vfs;
+	auto mock_filesystem = make_uniq<MockFileSystemWithExtendedList>();
+	auto *mock_ptr = mock_filesystem.get();
+
+	ObservabilityFileSystem observability_filesystem {std::move(mock_filesystem), vfs};
+	FileSystem &filesystem = observability_filesystem;
+
+	// Metadata attached by the internal filesystem reaches the caller.
+	vector<OpenFileInfo> listed_files;
+	const bool listed = filesystem.ListFiles(
+	    "s3://bucket/snapshots", [&](OpenFileInfo &info) { listed_files.emplace_back(info); }, /*opener=*/nullptr);
+	REQUIRE(listed);
+	REQUIRE(mock_ptr->GetListInvocation() == 0);
+	REQUIRE(mock_ptr->GetListExtendedInvocation() == 1);
+	REQUIRE(listed_files.size() == 1);
+	REQUIRE(listed_files[0].path == "file1.parquet");
+	REQUIRE(listed_files[0].extended_info != nullptr);
+	REQUIRE(listed_files[0].extended_info->options["file_size"] == Value::BIGINT(1024));
+
+	// Plain listing still goes to the non-extended variant.
+	vector<string> listed_names;
+	filesystem.ListFiles("s3://bucket/snapshots", [&](const string &name, bool) { listed_names.emplace_back(name); });
+	REQUIRE(mock_ptr->GetListInvocation() == 1);
+	REQUIRE(listed_names.size() == 1);
+}
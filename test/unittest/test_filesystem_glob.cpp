@@ -119,3 +119,60 @@ TEST_CASE("Test Glob uses GlobFilesExtended", "[glob test]") {
 	REQUIRE(results[0].path == "s3://bucket/snapshots/file1.parquet");
 	REQUIRE(results[1].path == "s3://bucket/snapshots/file2.parquet");
 }
+
+TEST_CASE("Test Glob with listing cache", "[glob test]") {
+	VirtualFileSystem vfs;
+	auto mock_filesystem = make_uniq<MockFileSystemWithoutExtendedGlob>();
+	auto *mock_ptr = mock_filesystem.get();
+
+	vector<OpenFileInfo> glob_results;
+	glob_results.emplace_back(OpenFileInfo("s3://bucket/snapshots/file1.parquet"));
+	mock_filesystem->SetExtendedGlobResults(std::move(glob_results));
+
+	auto observability_filesystem = make_uniq<ObservabilityFileSystem>(std::move(mock_filesystem), vfs);
+	observability_filesystem->SetListingCacheEnabled(true);
+	auto results = observability_filesystem->Glob("s3://bucket/snapshots/*.parquet");
+	REQUIRE(mock_ptr->GetGlobInvocation() == 1);
+	REQUIRE(results.size() == 1);
+
+	// Repeated glob is served by cached result.
+	results = observability_filesystem->Glob("s3://bucket/snapshots/*.parquet");
+	REQUIRE(mock_ptr->GetGlobInvocation() == 1);
+	REQUIRE(results.size() == 1);
+	REQUIRE(results[0].path == "s3://bucket/snapshots/file1.parquet");
+
+	// Another pattern goes to the internal filesystem.
+	observability_filesystem->Glob("s3://bucket/other/*.parquet");
+	REQUIRE(mock_ptr->GetGlobInvocation() == 2);
+
+	const auto stats = observability_filesystem->GetListingCacheStats();
+	REQUIRE(stats.glob_stats.hit_count == 1);
+	REQUIRE(stats.glob_stats.miss_count == 2);
+	REQUIRE(stats.glob_stats.entry_count == 2);
+}
+
+TEST_CASE("Test Glob passes through file list without materializing", "[glob test]") {
+	VirtualFileSystem vfs;
+	auto mock_filesystem = make_uniq<MockFileSystemWithExtendedGlob>();
+	auto *mock_ptr = mock_filesystem.get();
+
+	vector<OpenFileInfo> glob_results;
+	glob_results.emplace_back(OpenFileInfo("s3://bucket/snapshots/file1.parquet"));
+	glob_results.emplace_back(OpenFileInfo("s3://bucket/snapshots/file2.parquet"));
+	mock_filesystem->SetExtendedGlobResults(std::move(glob_results));
+
+	ObservabilityFileSystem observability_filesystem {std::move(mock_filesystem), vfs};
+	FileSystem &filesystem = observability_filesystem;
+	auto file_list = filesystem.Glob("s3://bucket/snapshots/*.parquet", FileGlobOptions::ALLOW_EMPTY);
+	REQUIRE(mock_ptr->GetGlobInvocation() == 0);
+	REQUIRE(mock_ptr->GetGlobExtendedInvocation() == 1);
+	REQUIRE(file_list->GetFirstFile().path == "s3://bucket/snapshots/file1.parquet");
+	REQUIRE(file_list->GetTotalFileCount() == 2);
+
+	vector<string> scanned_paths;
+	for (auto &cur_file : file_list->Files()) {
+		scanned_paths.emplace_back(cur_file.path);
+	}
+	REQUIRE(scanned_paths.size() == 2);
+	REQUIRE(scanned_paths[1] == "s3://bucket/snapshots/file2.parquet");
+}
@@ -0,0 +1,295 @@
+#include "catch/catch.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "duckdb/common/vector.hpp"
+#include "hedged_reader.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+// Latency threshold for tests, after which a duplicate request is issued.
+constexpr int64_t TEST_THRESHOLD_NS = 50LL * 1000 * 1000;
+
+// Content of the simulated remote file at the given offset.
+char GetFileByte(idx_t offset) {
+	return static_cast<char>(offset % 251);
+}
+
+// Simulated upstream with injected latency, where the n-th request sleeps for the n-th latency and fails if requested.
+struct LatencyInjectedFetcher {
+	void Fetch(idx_t handle_idx, char *buffer, idx_t nr_bytes, idx_t location) {
+		if (handle_in_use[handle_idx].exchange(true)) {
+			handle_shared = true;
+		}
+		const idx_t request_idx = request_count.fetch_add(1);
+		handle_indexes[request_idx] = handle_idx;
+		std::this_thread::sleep_for(std::chrono::milliseconds(latency_millisec[request_idx]));
+		handle_in_use[handle_idx] = false;
+		if (request_idx < failures.size() && failures[request_idx]) {
+			throw std::runtime_error("read failure");
+		}
+		for (idx_t idx = 0; idx < nr_bytes; ++idx) {
+			buffer[idx] = GetFileByte(location + idx);
+		}
+	}
+
+	HedgedReader::FetchFunc GetFetchFunc() {
+		return [this](idx_t handle_idx, char *buffer, idx_t nr_bytes, idx_t location) {
+			Fetch(handle_idx, buffer, nr_bytes, location);
+		};
+	}
+
+	vector<int64_t> latency_millisec;
+	vector<bool> failures;
+	std::atomic<idx_t> request_count {0};
+	// Handle used by each request.
+	std::array<idx_t, 8> handle_indexes {};
+	// Whether any handle is used by two requests at the same time.
+	std::atomic<bool> handle_shared {false};
+	std::array<std::atomic<bool>, HedgedReader::HANDLE_COUNT> handle_in_use {};
+};
+} // namespace
+
+TEST_CASE("Hedged reader fast read test", "[hedged reader test]") {
+	HedgedReadExecutor executor;
+	LatencyInjectedFetcher fetcher;
+	fetcher.latency_millisec = {0};
+	HedgedReadPolicy policy;
+	policy.SetBudgetPercent(100);
+	HedgedReadStats stats;
+	vector<char> buffer(10);
+	{
+		HedgedReader reader;
+		reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/100, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+		            stats, executor);
+	}
+	REQUIRE(buffer[0] == GetFileByte(100));
+	REQUIRE(buffer[9] == GetFileByte(109));
+	REQUIRE(fetcher.request_count.load() == 1);
+	REQUIRE(fetcher.handle_indexes[0] == 0);
+	REQUIRE(stats.request_count.load() == 1);
+	REQUIRE(stats.hedged_request_count.load() == 0);
+	REQUIRE(stats.hedge_win_count.load() == 0);
+
+	stats.Reset();
+	REQUIRE(stats.request_count.load() == 0);
+}
+
+TEST_CASE("Hedged reader slow read test", "[hedged reader test]") {
+	// The original request hits the long tail, while the duplicate one completes immediately.
+	HedgedReadExecutor executor;
+	LatencyInjectedFetcher fetcher;
+	fetcher.latency_millisec = {1000, 0};
+	HedgedReadPolicy policy;
+	policy.SetBudgetPercent(100);
+	HedgedReadStats stats;
+	vector<char> buffer(10);
+	{
+		HedgedReader reader;
+		const auto start = std::chrono::steady_clock::now();
+		reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/0, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+		            stats, executor);
+		REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+		// Destructing the reader waits for the losing request.
+	}
+	REQUIRE(buffer[5] == GetFileByte(5));
+	REQUIRE(fetcher.request_count.load() == 2);
+	// The duplicate request is issued on the second handle.
+	REQUIRE(fetcher.handle_indexes[0] == 0);
+	REQUIRE(fetcher.handle_indexes[1] == 1);
+	REQUIRE(!fetcher.handle_shared.load());
+	REQUIRE(stats.request_count.load() == 1);
+	REQUIRE(stats.hedged_request_count.load() == 1);
+	REQUIRE(stats.hedge_win_count.load() == 1);
+}
+
+TEST_CASE("Hedged reader buffer reuse test", "[hedged reader test]") {
+	// Handle buffers are reused by later reads, which are smaller or larger than earlier ones.
+	HedgedReadExecutor executor;
+	LatencyInjectedFetcher fetcher;
+	fetcher.latency_millisec = {0, 0, 0};
+	HedgedReadPolicy policy;
+	policy.SetBudgetPercent(100);
+	HedgedReadStats stats;
+	HedgedReader reader;
+	const std::array<std::pair<idx_t, idx_t>, 3> size_and_locations {{{100, 0}, {10, 1000}, {200, 50}}};
+	for (const auto &cur_size_and_location : size_and_locations) {
+		vector<char> buffer(cur_size_and_location.first);
+		reader.Read(buffer.data(), cur_size_and_location.first, cur_size_and_location.second, TEST_THRESHOLD_NS,
+		            fetcher.GetFetchFunc(), policy, stats, executor);
+		for (idx_t idx = 0; idx < cur_size_and_location.first; ++idx) {
+			REQUIRE(buffer[idx] == GetFileByte(cur_size_and_location.second + idx));
+		}
+	}
+	REQUIRE(fetcher.request_count.load() == 3);
+	REQUIRE(stats.hedged_request_count.load() == 0);
+}
+
+TEST_CASE("Hedged reader budget test", "[hedged reader test]") {
+	HedgedReadExecutor executor;
+	LatencyInjectedFetcher fetcher;
+	fetcher.latency_millisec = {100};
+	HedgedReadPolicy policy;
+	policy.SetBudgetPercent(0);
+	HedgedReadStats stats;
+	vector<char> buffer(10);
+	HedgedReader reader;
+	reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/0, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+	            stats, executor);
+	REQUIRE(buffer[5] == GetFileByte(5));
+	REQUIRE(fetcher.request_count.load() == 1);
+	REQUIRE(stats.hedged_request_count.load() == 0);
+	REQUIRE(stats.budget_exhausted_count.load() == 1);
+
+	// Budget is a percentage of eligible reads.
+	HedgedReadStats budget_stats;
+	policy.SetBudgetPercent(10);
+	budget_stats.request_count.store(10);
+	REQUIRE(policy.TryAcquireBudget(budget_stats));
+	REQUIRE(!policy.TryAcquireBudget(budget_stats));
+	REQUIRE(budget_stats.hedged_request_count.load() == 1);
+	REQUIRE(budget_stats.budget_exhausted_count.load() == 1);
+	REQUIRE(!policy.HasBudget(budget_stats));
+	policy.ReleaseBudget(budget_stats);
+	REQUIRE(policy.HasBudget(budget_stats));
+}
+
+TEST_CASE("Hedged reader error test", "[hedged reader test]") {
+	HedgedReadExecutor executor;
+	HedgedReadPolicy policy;
+	policy.SetBudgetPercent(100);
+	HedgedReadStats stats;
+	vector<char> buffer(10);
+
+	// The original request fails after the duplicate one is issued, which still serves the read.
+	{
+		LatencyInjectedFetcher fetcher;
+		fetcher.latency_millisec = {200, 300};
+		fetcher.failures = {true, false};
+		HedgedReader reader;
+		reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/20, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+		            stats, executor);
+		REQUIRE(buffer[0] == GetFileByte(20));
+		REQUIRE(stats.hedge_win_count.load() == 1);
+	}
+
+	// Exception is rethrown if all requests fail.
+	{
+		LatencyInjectedFetcher fetcher;
+		fetcher.latency_millisec = {200, 0};
+		fetcher.failures = {true, true};
+		HedgedReader reader;
+		bool has_error = false;
+		try {
+			reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/0, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(),
+			            policy, stats, executor);
+		} catch (const std::runtime_error &) {
+			has_error = true;
+		}
+		REQUIRE(has_error);
+		REQUIRE(fetcher.request_count.load() == 2);
+	}
+}
+
+TEST_CASE("Hedged reader handle exclusiveness test", "[hedged reader test]") {
+	HedgedReadExecutor executor;
+	LatencyInjectedFetcher fetcher;
+	// The first read's original request loses and keeps running on the primary handle.
+	fetcher.latency_millisec = {500, 0, 0, 0};
+	HedgedReadPolicy policy;
+	policy.SetBudgetPercent(100);
+	HedgedReadStats stats;
+	vector<char> buffer(10);
+	{
+		HedgedReader reader;
+		reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/0, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+		            stats, executor);
+		REQUIRE(reader.HasIssuedRequest());
+
+		// Later reads go to the second handle, and aren't hedged since no handle is free.
+		reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/10, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+		            stats, executor);
+		reader.ReadWithoutHedging(buffer.data(), /*nr_bytes=*/10, /*location=*/20, fetcher.GetFetchFunc());
+		REQUIRE(buffer[0] == GetFileByte(20));
+		REQUIRE(fetcher.handle_indexes[2] == 1);
+		REQUIRE(fetcher.handle_indexes[3] == 1);
+
+		// Reads depending on file position wait for the losing request on the primary handle.
+		const auto start = std::chrono::steady_clock::now();
+		reader.RunOnPrimaryHandle([]() {});
+		REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(300));
+	}
+	REQUIRE(fetcher.request_count.load() == 4);
+	REQUIRE(!fetcher.handle_shared.load());
+	REQUIRE(stats.hedged_request_count.load() == 1);
+}
+
+TEST_CASE("Hedged reader saturated executor test", "[hedged reader test]") {
+	HedgedReadPolicy policy;
+	policy.SetBudgetPercent(100);
+	HedgedReadStats stats;
+	vector<char> buffer(10);
+
+	// The original request takes the only thread, so the duplicate one can't be issued and its budget is returned.
+	{
+		HedgedReadExecutor executor(/*max_thread_count_p=*/1);
+		LatencyInjectedFetcher fetcher;
+		fetcher.latency_millisec = {200};
+		HedgedReader reader;
+		reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/30, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+		            stats, executor);
+		REQUIRE(buffer[0] == GetFileByte(30));
+		REQUIRE(fetcher.request_count.load() == 1);
+		REQUIRE(stats.hedged_request_count.load() == 0);
+	}
+
+	// Without any thread, the read is issued by the caller thread.
+	{
+		HedgedReadExecutor executor(/*max_thread_count_p=*/0);
+		LatencyInjectedFetcher fetcher;
+		fetcher.latency_millisec = {0};
+		HedgedReader reader;
+		reader.Read(buffer.data(), /*nr_bytes=*/10, /*location=*/40, TEST_THRESHOLD_NS, fetcher.GetFetchFunc(), policy,
+		            stats, executor);
+		REQUIRE(buffer[0] == GetFileByte(40));
+		REQUIRE(fetcher.request_count.load() == 1);
+	}
+}
+
+TEST_CASE("Hedged read policy threshold test", "[hedged reader test]") {
+	HedgedReadPolicy policy;
+	idx_t compute_count = 0;
+	double latency_microsec = -1;
+	const auto compute = [&](const string &bucket) {
+		++compute_count;
+		return latency_microsec;
+	};
+
+	// Not enough records.
+	REQUIRE(policy.GetThresholdNs("bucket", /*now_ns=*/0, compute) < 0);
+	REQUIRE(compute_count == 1);
+
+	// Threshold is cached until refresh interval elapses.
+	latency_microsec = 20 * 1000;
+	REQUIRE(policy.GetThresholdNs("bucket", /*now_ns=*/1, compute) < 0);
+	REQUIRE(compute_count == 1);
+	const int64_t refresh_ns = HedgedReadPolicy::THRESHOLD_REFRESH_INTERVAL_NS;
+	REQUIRE(policy.GetThresholdNs("bucket", refresh_ns, compute) == 20LL * 1000 * 1000);
+	REQUIRE(compute_count == 2);
+
+	// Each bucket has its own threshold.
+	latency_microsec = 10;
+	REQUIRE(policy.GetThresholdNs("fast-bucket", refresh_ns, compute) < 0);
+	REQUIRE(policy.GetThresholdNs("bucket", refresh_ns + 1, compute) == 20LL * 1000 * 1000);
+	REQUIRE(compute_count == 3);
+
+	policy.Reset();
+	REQUIRE(policy.GetThresholdNs("bucket", refresh_ns + 1, compute) < 0);
+	REQUIRE(compute_count == 4);
+}
@@ -1,15 +1,15 @@
 #include "catch/catch.hpp"
 
+#include <cmath>
+
 #include "histogram.hpp"
 
 using namespace duckdb; // NOLINT
 
 TEST_CASE("Histogram test", "[histogram test]") {
-	Histogram hist {/*min_val=*/0, /*max_val=*/10, /*num_bkt=*/10};
+	Histogram hist;
 	hist.Add(1);
 	hist.Add(3);
-	hist.Add(-3);
-	REQUIRE(hist.outliers() == std::vector<double> {-3});
 	REQUIRE(hist.min() == 1);
 	REQUIRE(hist.max() == 3);
 	REQUIRE(hist.counts() == 2);
@@ -18,9 +18,67 @@ TEST_CASE("Histogram test", "[histogram test]") {
 	// Reset and check again.
 	hist.Reset();
 	hist.Add(1);
-	REQUIRE(hist.outliers().empty());
 	REQUIRE(hist.min() == 1);
 	REQUIRE(hist.max() == 1);
 	REQUIRE(hist.counts() == 1);
 	REQUIRE(hist.mean() == 1);
 }
+
+TEST_CASE("Histogram bucket boundary test", "[histogram test]") {
+	Histogram hist;
+
+	// Zero and negative values go to the first bucket.
+	REQUIRE(hist.Bucket(0) == 0);
+	REQUIRE(hist.Bucket(-5) == 0);
+	REQUIRE(hist.BucketLowerBound(0) == 0);
+
+	// Every value falls into its bucket, whose width is bounded by relative error.
+	for (double val : {0.001, 0.5, 1.0, 3.0, 17.0, 1000.0, 123456.0, 6.0 * 1024 * 1024, 60.0 * 1000 * 1000}) {
+		const idx_t bucket_idx = hist.Bucket(val);
+		const double lower_bound = hist.BucketLowerBound(bucket_idx);
+		const double upper_bound = hist.BucketUpperBound(bucket_idx);
+		REQUIRE(lower_bound <= val);
+		REQUIRE(val < upper_bound);
+		REQUIRE((upper_bound - lower_bound) / lower_bound <= 1.0 / 16);
+	}
+
+	// Adjacent buckets are contiguous.
+	for (idx_t idx = 0; idx < 200; ++idx) {
+		REQUIRE(hist.BucketUpperBound(idx) == hist.BucketLowerBound(idx + 1));
+	}
+
+	// Huge values are clamped to the last bucket, but stats stay exact.
+	hist.Add(1e30);
+	REQUIRE(hist.Bucket(1e30) == hist.Bucket(1e20));
+	REQUIRE(hist.max() == 1e30);
+	REQUIRE(hist.counts() == 1);
+}
+
+TEST_CASE("Histogram quantile test", "[histogram test]") {
+	Histogram hist;
+	for (int idx = 1; idx <= 10000; ++idx) {
+		hist.Add(idx);
+	}
+	REQUIRE(hist.Quantile(0) == 1);
+	REQUIRE(hist.Quantile(1) == 10000);
+	REQUIRE(std::abs(hist.Quantile(0.5) - 5000) / 5000 <= 1.0 / 16);
+	REQUIRE(std::abs(hist.Quantile(0.99) - 9900) / 9900 <= 1.0 / 16);
+}
+
+TEST_CASE("Histogram merge test", "[histogram test]") {
+	Histogram hist;
+	hist.Add(1);
+	hist.Add(3);
+
+	Histogram other;
+	other.Add(5);
+	other.Add(1000);
+
+	hist.Merge(other);
+	REQUIRE(hist.min() == 1);
+	REQUIRE(hist.max() == 1000);
+	REQUIRE(hist.counts() == 4);
+	REQUIRE(hist.mean() == 252.25);
+	REQUIRE(hist.BucketRecordCount(hist.Bucket(1000)) == 1);
+	REQUIRE(hist.BucketRecordCount(hist.Bucket(1)) == 1);
+}
@@ -0,0 +1,192 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "listing_cache.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+} // namespace
+
+TEST_CASE("Listing cache glob prefix test", "[listing cache test]") {
+	REQUIRE(ListingCache::GetGlobPrefix("s3://bucket/year=2024/*.parquet") == "s3://bucket/year=2024/");
+	REQUIRE(ListingCache::GetGlobPrefix("s3://bucket/year=202?/a.parquet") == "s3://bucket/year=202");
+	REQUIRE(ListingCache::GetGlobPrefix("s3://bucket/{a,b}.parquet") == "s3://bucket/");
+	REQUIRE(ListingCache::GetGlobPrefix("s3://bucket/a.parquet") == "s3://bucket/a.parquet");
+}
+
+TEST_CASE("Listing cache glob test", "[listing cache test]") {
+	ListingCache cache;
+	cache.SetEnabled(true);
+	cache.SetTtlSec(10);
+	const string pattern = "s3://bucket/year=2024/*.parquet";
+
+	vector<OpenFileInfo> files;
+	REQUIRE(!cache.LookupGlob(pattern, /*now_ns=*/NANOS_PER_SEC, files));
+	vector<OpenFileInfo> fetched_files;
+	fetched_files.emplace_back(OpenFileInfo("s3://bucket/year=2024/a.parquet"));
+	fetched_files.emplace_back(OpenFileInfo("s3://bucket/year=2024/b.parquet"));
+	cache.UpdateGlob(pattern, /*now_ns=*/NANOS_PER_SEC, cache.GetGeneration(), fetched_files);
+
+	REQUIRE(cache.LookupGlob(pattern, /*now_ns=*/2 * NANOS_PER_SEC, files));
+	REQUIRE(files.size() == 2);
+	REQUIRE(files[0].path == "s3://bucket/year=2024/a.parquet");
+	REQUIRE(files[1].path == "s3://bucket/year=2024/b.parquet");
+
+	// Entries expire after TTL.
+	REQUIRE(!cache.LookupGlob(pattern, /*now_ns=*/11 * NANOS_PER_SEC, files));
+
+	const auto stats = cache.GetStats();
+	REQUIRE(stats.glob_stats.hit_count == 1);
+	REQUIRE(stats.glob_stats.miss_count == 2);
+	REQUIRE(stats.glob_stats.entry_count == 0);
+	REQUIRE(stats.list_stats.hit_count == 0);
+	REQUIRE(stats.list_stats.miss_count == 0);
+}
+
+TEST_CASE("Listing cache list test", "[listing cache test]") {
+	ListingCache cache;
+	cache.SetEnabled(true);
+	const string directory = "s3://bucket/year=2024";
+
+	vector<ListedFile> files;
+	bool listed = false;
+	REQUIRE(!cache.LookupList(directory, /*now_ns=*/1, files, listed));
+	cache.UpdateList(directory, /*now_ns=*/1, cache.GetGeneration(),
+	                 {ListedFile {"a.parquet", false}, ListedFile {"month=01", true}}, /*listed=*/true);
+
+	REQUIRE(cache.LookupList(directory, /*now_ns=*/2, files, listed));
+	REQUIRE(listed);
+	REQUIRE(files.size() == 2);
+	REQUIRE(files[0].name == "a.parquet");
+	REQUIRE(!files[0].is_directory);
+	REQUIRE(files[1].name == "month=01");
+	REQUIRE(files[1].is_directory);
+
+	// Glob and list entries don't collide even with the same key.
+	vector<OpenFileInfo> glob_files;
+	REQUIRE(!cache.LookupGlob(directory, /*now_ns=*/2, glob_files));
+
+	const auto stats = cache.GetStats();
+	REQUIRE(stats.list_stats.hit_count == 1);
+	REQUIRE(stats.list_stats.miss_count == 1);
+	REQUIRE(stats.list_stats.entry_count == 1);
+}
+
+TEST_CASE("Listing cache extended list test", "[listing cache test]") {
+	ListingCache cache;
+	cache.SetEnabled(true);
+	const string directory = "s3://bucket/year=2024";
+
+	vector<OpenFileInfo> files;
+	bool listed = false;
+	REQUIRE(!cache.LookupListExtended(directory, /*now_ns=*/1, files, listed));
+	cache.UpdateListExtended(directory, /*now_ns=*/1, cache.GetGeneration(),
+	                         {OpenFileInfo("s3://bucket/year=2024/a.parquet")}, /*listed=*/true);
+
+	REQUIRE(cache.LookupListExtended(directory, /*now_ns=*/2, files, listed));
+	REQUIRE(listed);
+	REQUIRE(files.size() == 1);
+	REQUIRE(files[0].path == "s3://bucket/year=2024/a.parquet");
+
+	// Plain and extended list entries don't collide, but share stats.
+	vector<ListedFile> list_files;
+	REQUIRE(!cache.LookupList(directory, /*now_ns=*/2, list_files, listed));
+	auto stats = cache.GetStats();
+	REQUIRE(stats.list_stats.hit_count == 1);
+	REQUIRE(stats.list_stats.miss_count == 2);
+	REQUIRE(stats.list_stats.entry_count == 1);
+
+	cache.Invalidate("s3://bucket/year=2024/b.parquet");
+	REQUIRE(!cache.LookupListExtended(directory, /*now_ns=*/2, files, listed));
+	stats = cache.GetStats();
+	REQUIRE(stats.list_stats.invalidated_entry_count == 1);
+	REQUIRE(stats.list_stats.entry_count == 0);
+}
+
+TEST_CASE("Listing cache invalidation test", "[listing cache test]") {
+	ListingCache cache;
+	cache.SetEnabled(true);
+	cache.UpdateGlob("s3://bucket/year=2024/*.parquet", /*now_ns=*/1, cache.GetGeneration(), {});
+	cache.UpdateGlob("s3://bucket/year=2025/*.parquet", /*now_ns=*/1, cache.GetGeneration(), {});
+	cache.UpdateList("s3://bucket/year=2024", /*now_ns=*/1, cache.GetGeneration(), {}, /*listed=*/false);
+
+	// Only entries whose prefix covers the modified file are dropped.
+	cache.Invalidate("s3://bucket/year=2024/c.parquet");
+	vector<OpenFileInfo> glob_files;
+	vector<ListedFile> list_files;
+	bool listed = false;
+	REQUIRE(!cache.LookupGlob("s3://bucket/year=2024/*.parquet", /*now_ns=*/2, glob_files));
+	REQUIRE(cache.LookupGlob("s3://bucket/year=2025/*.parquet", /*now_ns=*/2, glob_files));
+	REQUIRE(!cache.LookupList("s3://bucket/year=2024", /*now_ns=*/2, list_files, listed));
+
+	auto stats = cache.GetStats();
+	REQUIRE(stats.glob_stats.invalidated_entry_count == 1);
+	REQUIRE(stats.list_stats.invalidated_entry_count == 1);
+	REQUIRE(stats.glob_stats.entry_count == 1);
+
+	cache.Reset();
+	stats = cache.GetStats();
+	REQUIRE(stats.glob_stats.invalidated_entry_count == 0);
+	REQUIRE(stats.glob_stats.entry_count == 0);
+	REQUIRE(stats.glob_stats.hit_count == 0);
+}
+
+TEST_CASE("Listing cache drops listing straddling invalidation test", "[listing cache test]") {
+	ListingCache cache;
+	cache.SetEnabled(true);
+	const string directory = "s3://bucket/year=2024";
+
+	// Listing starts before a file is written, and finishes after invalidation.
+	const auto generation = cache.GetGeneration();
+	cache.Invalidate("s3://bucket/year=2024/a.parquet");
+	cache.UpdateList(directory, /*now_ns=*/1, generation, {}, /*listed=*/true);
+	vector<ListedFile> files;
+	bool listed = false;
+	REQUIRE(!cache.LookupList(directory, /*now_ns=*/2, files, listed));
+
+	// Listing starts after invalidation is cached.
+	cache.UpdateList(directory, /*now_ns=*/2, cache.GetGeneration(), {ListedFile {"a.parquet", false}},
+	                 /*listed=*/true);
+	REQUIRE(cache.LookupList(directory, /*now_ns=*/3, files, listed));
+	REQUIRE(files.size() == 1);
+}
+
+TEST_CASE("Listing cache bounded memory test", "[listing cache test]") {
+	ListingCache cache;
+	cache.SetEnabled(true);
+	vector<ListedFile> list_files;
+	bool listed = false;
+	for (idx_t idx = 0; idx < 2 * ListingCache::MAX_ENTRY_COUNT; ++idx) {
+		const auto key = "s3://bucket/" + std::to_string(idx);
+		cache.UpdateGlob(key + "/*", /*now_ns=*/static_cast<int64_t>(idx + 1), cache.GetGeneration(), {});
+		cache.UpdateList(key, /*now_ns=*/static_cast<int64_t>(idx + 1), cache.GetGeneration(), {}, /*listed=*/true);
+	}
+	auto stats = cache.GetStats();
+	REQUIRE(stats.glob_stats.entry_count + stats.list_stats.entry_count == ListingCache::MAX_ENTRY_COUNT);
+
+	// The earliest entries are evicted first.
+	vector<OpenFileInfo> glob_files;
+	REQUIRE(!cache.LookupGlob("s3://bucket/0/*", /*now_ns=*/1, glob_files));
+	const auto last_key = "s3://bucket/" + std::to_string(2 * ListingCache::MAX_ENTRY_COUNT - 1);
+	REQUIRE(cache.LookupGlob(last_key + "/*", /*now_ns=*/1, glob_files));
+
+	// Refreshed entry is moved behind all others, so it's evicted last.
+	const auto first_kept_key = "s3://bucket/" + std::to_string(3 * ListingCache::MAX_ENTRY_COUNT / 2);
+	cache.UpdateGlob(first_kept_key + "/*", /*now_ns=*/1, cache.GetGeneration(), {});
+	cache.UpdateGlob("s3://bucket/new/*", /*now_ns=*/1, cache.GetGeneration(), {});
+	REQUIRE(cache.LookupGlob(first_kept_key + "/*", /*now_ns=*/1, glob_files));
+	REQUIRE(!cache.LookupList(first_kept_key, /*now_ns=*/1, list_files, listed));
+
+	// Results with too many files are not cached.
+	vector<OpenFileInfo> huge_files(ListingCache::MAX_FILE_COUNT_PER_ENTRY + 1);
+	cache.UpdateGlob("s3://bucket/huge/*", /*now_ns=*/1, cache.GetGeneration(), huge_files);
+	REQUIRE(!cache.LookupGlob("s3://bucket/huge/*", /*now_ns=*/1, glob_files));
+
+	// Cached entries are dropped on disable.
+	cache.SetEnabled(false);
+	stats = cache.GetStats();
+	REQUIRE(stats.glob_stats.entry_count + stats.list_stats.entry_count == 0);
+}
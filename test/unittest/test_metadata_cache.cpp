@@ -0,0 +1,162 @@
+#include "catch/catch.hpp"
+
+#include <thread>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "metadata_cache.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+
+// Look up file size of [path], return -1 if not cached.
+int64_t LookupFileSize(MetadataCache &cache, const string &path, int64_t now_ns) {
+	int64_t file_size = -1;
+	cache.Lookup(path, MetadataField::kFileSize, now_ns,
+	             [&file_size](const CachedFileMetadata &metadata) { file_size = metadata.file_size; });
+	return file_size;
+}
+
+void UpdateFileSize(MetadataCache &cache, const string &path, int64_t now_ns, int64_t file_size) {
+	cache.Update(path, MetadataField::kFileSize, now_ns, cache.GetGeneration(path),
+	             [file_size](CachedFileMetadata &metadata) { metadata.file_size = file_size; });
+}
+} // namespace
+
+TEST_CASE("Metadata cache hit and miss test", "[metadata cache test]") {
+	MetadataCache cache;
+	cache.SetEnabled(true);
+	const string path = "s3://bucket/a.parquet";
+
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/1) == -1);
+	UpdateFileSize(cache, path, /*now_ns=*/1, /*file_size=*/100);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/2) == 100);
+
+	// Fields are cached independently, even for the same path.
+	REQUIRE(!cache.Lookup(path, MetadataField::kFileExists, /*now_ns=*/2, [](const CachedFileMetadata &) {}));
+	cache.Update(path, MetadataField::kFileExists, /*now_ns=*/2, cache.GetGeneration(path),
+	             [](CachedFileMetadata &metadata) { metadata.file_exists = true; });
+	bool file_exists = false;
+	REQUIRE(cache.Lookup(path, MetadataField::kFileExists, /*now_ns=*/3,
+	                     [&file_exists](const CachedFileMetadata &metadata) { file_exists = metadata.file_exists; }));
+	REQUIRE(file_exists);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/3) == 100);
+
+	// Other paths are not affected.
+	REQUIRE(LookupFileSize(cache, "s3://bucket/b.parquet", /*now_ns=*/3) == -1);
+
+	auto stats = cache.GetStats();
+	REQUIRE(stats.hit_count == 3);
+	REQUIRE(stats.miss_count == 3);
+	REQUIRE(stats.entry_count == 1);
+
+	// Invalidation drops all fields of the path.
+	cache.Invalidate(path);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/4) == -1);
+	stats = cache.GetStats();
+	REQUIRE(stats.entry_count == 0);
+	REQUIRE(stats.invalidated_entry_count == 1);
+
+	cache.Reset();
+	stats = cache.GetStats();
+	REQUIRE(stats.hit_count == 0);
+	REQUIRE(stats.miss_count == 0);
+	REQUIRE(stats.invalidated_entry_count == 0);
+}
+
+TEST_CASE("Metadata cache drops fetch straddling invalidation test", "[metadata cache test]") {
+	MetadataCache cache;
+	cache.SetEnabled(true);
+	const string path = "s3://bucket/a.parquet";
+	const auto update_file_size = [](CachedFileMetadata &metadata) { metadata.file_size = 100; };
+
+	// Fetch starts before the file is modified, and finishes after invalidation.
+	const auto generation = cache.GetGeneration(path);
+	cache.Invalidate(path);
+	cache.Update(path, MetadataField::kFileSize, /*now_ns=*/1, generation, update_file_size);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/2) == -1);
+
+	// Fetch starts after invalidation is cached.
+	cache.Update(path, MetadataField::kFileSize, /*now_ns=*/2, cache.GetGeneration(path), update_file_size);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/3) == 100);
+}
+
+TEST_CASE("Metadata cache ttl test", "[metadata cache test]") {
+	MetadataCache cache;
+	cache.SetEnabled(true);
+	cache.SetTtlSec(10);
+	REQUIRE(cache.GetTtlSec() == 10);
+	const string path = "s3://bucket/a.parquet";
+
+	UpdateFileSize(cache, path, /*now_ns=*/NANOS_PER_SEC, /*file_size=*/100);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/10 * NANOS_PER_SEC) == 100);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/11 * NANOS_PER_SEC) == -1);
+
+	// Refetched field is cached again.
+	UpdateFileSize(cache, path, /*now_ns=*/11 * NANOS_PER_SEC, /*file_size=*/200);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/12 * NANOS_PER_SEC) == 200);
+
+	// Shorter TTL applies to cached fields as well.
+	cache.SetTtlSec(1);
+	REQUIRE(LookupFileSize(cache, path, /*now_ns=*/13 * NANOS_PER_SEC) == -1);
+}
+
+TEST_CASE("Metadata cache disable test", "[metadata cache test]") {
+	MetadataCache cache;
+	REQUIRE(!cache.IsEnabled());
+	cache.SetEnabled(true);
+	REQUIRE(cache.IsEnabled());
+
+	UpdateFileSize(cache, "s3://bucket/a.parquet", /*now_ns=*/1, /*file_size=*/100);
+	REQUIRE(cache.GetStats().entry_count == 1);
+
+	// Cached entries are dropped on disable.
+	cache.SetEnabled(false);
+	REQUIRE(cache.GetStats().entry_count == 0);
+}
+
+TEST_CASE("Metadata cache bounded memory test", "[metadata cache test]") {
+	MetadataCache cache;
+	cache.SetEnabled(true);
+	const idx_t max_entry_count = MetadataCache::STRIPE_COUNT * MetadataCache::MAX_ENTRY_COUNT_PER_STRIPE;
+	for (idx_t idx = 0; idx < 2 * max_entry_count; ++idx) {
+		const auto path = "s3://bucket/" + std::to_string(idx);
+		UpdateFileSize(cache, path, /*now_ns=*/static_cast<int64_t>(idx + 1), static_cast<int64_t>(idx));
+	}
+	REQUIRE(cache.GetStats().entry_count <= max_entry_count);
+
+	// The latest entry is kept, while the earliest one has been evicted.
+	const auto last_idx = 2 * max_entry_count - 1;
+	REQUIRE(LookupFileSize(cache, "s3://bucket/" + std::to_string(last_idx), /*now_ns=*/2 * max_entry_count) ==
+	        static_cast<int64_t>(last_idx));
+	REQUIRE(LookupFileSize(cache, "s3://bucket/0", /*now_ns=*/2 * max_entry_count) == -1);
+}
+
+TEST_CASE("Metadata cache concurrent access test", "[metadata cache test]") {
+	MetadataCache cache;
+	cache.SetEnabled(true);
+	constexpr idx_t THREAD_COUNT = 8;
+	constexpr idx_t ITERATION_COUNT = 1000;
+
+	vector<std::thread> threads;
+	threads.reserve(THREAD_COUNT);
+	for (idx_t thd_idx = 0; thd_idx < THREAD_COUNT; ++thd_idx) {
+		threads.emplace_back([&cache]() {
+			for (idx_t idx = 0; idx < ITERATION_COUNT; ++idx) {
+				const auto path = "s3://bucket/" + std::to_string(idx % 16);
+				if (LookupFileSize(cache, path, /*now_ns=*/1) == -1) {
+					UpdateFileSize(cache, path, /*now_ns=*/1, static_cast<int64_t>(idx % 16));
+				}
+			}
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+
+	const auto stats = cache.GetStats();
+	REQUIRE(stats.hit_count + stats.miss_count == THREAD_COUNT * ITERATION_COUNT);
+	REQUIRE(stats.entry_count == 16);
+}
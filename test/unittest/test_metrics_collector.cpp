@@ -0,0 +1,130 @@
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <thread>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "metrics_collector.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr idx_t THREAD_NUM = 16;
+constexpr idx_t OPERATION_PER_THREAD = 100;
+} // namespace
+
+TEST_CASE("Metrics collector records from multiple threads", "[metrics collector test]") {
+	MetricsCollector metrics_collector;
+	vector<std::thread> threads;
+	threads.reserve(THREAD_NUM);
+	for (idx_t idx = 0; idx < THREAD_NUM; ++idx) {
+		threads.emplace_back([&metrics_collector]() {
+			for (idx_t op_idx = 0; op_idx < OPERATION_PER_THREAD; ++op_idx) {
+				metrics_collector.RecordOperationStart(IoOperation::kRead, "s3://bucket/object", /*bytes_to_read=*/1);
+			}
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+
+	// Records from all shards are merged when stats requested.
+	const auto stats = metrics_collector.GetHumanReadableStats();
+	REQUIRE(stats.find("Count = 1600") != string::npos);
+	REQUIRE(stats.find("Bucket: bucket") != string::npos);
+	const auto top_files = metrics_collector.GetTopFiles(/*k=*/10);
+	REQUIRE(top_files.size() == 1);
+	REQUIRE(top_files[0].path == "s3://bucket/object");
+	REQUIRE(top_files[0].request_count == THREAD_NUM * OPERATION_PER_THREAD);
+
+	// Reset clears records on all shards.
+	metrics_collector.Reset();
+	REQUIRE(metrics_collector.GetHumanReadableStats().empty());
+}
+
+TEST_CASE("Metrics collector shares latency window among shards", "[metrics collector test]") {
+	MetricsCollector metrics_collector;
+	vector<std::thread> threads;
+	threads.reserve(THREAD_NUM);
+	for (idx_t idx = 0; idx < THREAD_NUM; ++idx) {
+		threads.emplace_back([&metrics_collector]() {
+			for (idx_t op_idx = 0; op_idx < OPERATION_PER_THREAD; ++op_idx) {
+				metrics_collector.RecordOperationStart(IoOperation::kRead, "s3://bucket/object", /*bytes_to_read=*/1);
+			}
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+
+	const auto window_sec = RollingHistogram::GetMaxWindowSec();
+	REQUIRE(metrics_collector.GetRecentLatencyHistogram(IoOperation::kRead, /*bucket=*/"", window_sec)->counts() ==
+	        THREAD_NUM * OPERATION_PER_THREAD);
+	REQUIRE(metrics_collector.GetRecentLatencyHistogram(IoOperation::kRead, "bucket", window_sec)->counts() ==
+	        THREAD_NUM * OPERATION_PER_THREAD);
+	REQUIRE(metrics_collector.GetRecentLatencyHistogram(IoOperation::kRead, "other-bucket", window_sec)->counts() == 0);
+	REQUIRE(metrics_collector.GetRecentLatencyQuantile(IoOperation::kRead, "bucket", /*quantile=*/0.5, window_sec,
+	                                                   /*min_record_count=*/THREAD_NUM * OPERATION_PER_THREAD + 1) < 0);
+
+	metrics_collector.Reset();
+	REQUIRE(metrics_collector.GetRecentLatencyHistogram(IoOperation::kRead, "bucket", window_sec)->counts() == 0);
+}
+
+TEST_CASE("Metrics collector merges top files with bounded error", "[metrics collector test]") {
+	constexpr idx_t HOT_FILE_REQUEST_COUNT = 10;
+	MetricsCollector metrics_collector;
+	// One thread fills up its shard with cold files accessed twice, and another one accesses the hot file only.
+	std::thread cold_thread([&metrics_collector]() {
+		for (idx_t idx = 0; idx < TopFilesSketch::CAPACITY; ++idx) {
+			const auto filepath = "s3://bucket/cold-" + std::to_string(idx);
+			metrics_collector.RecordOperationStart(IoOperation::kRead, filepath, /*bytes_to_read=*/1);
+			metrics_collector.RecordOperationStart(IoOperation::kRead, filepath, /*bytes_to_read=*/1);
+		}
+	});
+	cold_thread.join();
+	std::thread hot_thread([&metrics_collector]() {
+		for (idx_t idx = 0; idx < HOT_FILE_REQUEST_COUNT; ++idx) {
+			metrics_collector.RecordOperationStart(IoOperation::kRead, "s3://bucket/hot", /*bytes_to_read=*/100);
+		}
+	});
+	hot_thread.join();
+
+	// Requests on the shard not tracking the hot file are bounded by its min tracked count.
+	auto top_files = metrics_collector.GetTopFiles(/*k=*/1);
+	REQUIRE(top_files.size() == 1);
+	REQUIRE(top_files[0].path == "s3://bucket/hot");
+	REQUIRE(top_files[0].request_count == HOT_FILE_REQUEST_COUNT + 2);
+	REQUIRE(top_files[0].request_count_error == 2);
+
+	// Bytes are only accumulated on the shard tracking the file.
+	top_files = metrics_collector.GetTopFiles(/*k=*/1, TopFilesOrder::kBytes);
+	REQUIRE(top_files.size() == 1);
+	REQUIRE(top_files[0].path == "s3://bucket/hot");
+	REQUIRE(top_files[0].bytes == HOT_FILE_REQUEST_COUNT * 100);
+}
+
+TEST_CASE("Metrics collector attributes redundant reads to queries", "[metrics collector test]") {
+	MetricsCollector metrics_collector;
+	metrics_collector.SetRedundantReadDetectionEnabled(true);
+	QueryTag query_tag;
+	query_tag.connection_id = 1;
+	query_tag.query_id = 2;
+	for (idx_t idx = 0; idx < 2; ++idx) {
+		metrics_collector.RecordOperationStart(IoOperation::kRead, "s3://bucket/object", /*bytes_to_read=*/100,
+		                                       query_tag);
+		metrics_collector.RecordReadRange("s3://bucket/object", /*location=*/0, /*nr_bytes=*/100, query_tag);
+	}
+
+	const auto query_stats = metrics_collector.GetQueryStats();
+	REQUIRE(query_stats.size() == 1);
+	REQUIRE(query_stats[0].request_count == 2);
+	REQUIRE(query_stats[0].duplicated_request_count == 1);
+	REQUIRE(query_stats[0].duplicated_bytes == 100);
+	const auto redundant_reads = metrics_collector.GetRedundantReads();
+	REQUIRE(redundant_reads.size() == 1);
+	REQUIRE(redundant_reads[0].duplicated_bytes == 100);
+
+	metrics_collector.Reset();
+	REQUIRE(metrics_collector.GetRedundantReads().empty());
+}
@@ -0,0 +1,69 @@
+// Allocation tests replace global allocation functions, so they're built into their own binary, which doesn't affect
+// any other test.
+
+#include "catch/catch.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#include "duckdb/common/string.hpp"
+#include "metrics_collector.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+// Number of heap allocations made by the current thread, only counted within [`AllocationCounter`] scope.
+thread_local bool g_count_allocation = false;
+thread_local idx_t g_allocation_count = 0;
+
+// Counts heap allocations made by the current thread during its lifetime.
+class AllocationCounter {
+public:
+	AllocationCounter() {
+		g_allocation_count = 0;
+		g_count_allocation = true;
+	}
+	~AllocationCounter() {
+		g_count_allocation = false;
+	}
+
+	idx_t GetAllocationCount() const {
+		return g_allocation_count;
+	}
+};
+} // namespace
+
+void *operator new(std::size_t size) {
+	if (g_count_allocation) {
+		++g_allocation_count;
+	}
+	void *ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete(void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+TEST_CASE("Metrics collector doesn't allocate in steady state", "[metrics collector allocation test]") {
+	constexpr idx_t WARMUP_OPERATION_NUM = 1000;
+	constexpr idx_t MEASURED_OPERATION_NUM = 1000;
+	// Use a path longer than small string optimization capacity, so any copy would allocate.
+	const string filepath = "s3://a-bucket-name-which-is-long-enough/directory/object.parquet";
+
+	MetricsCollector metrics_collector;
+	for (idx_t idx = 0; idx < WARMUP_OPERATION_NUM; ++idx) {
+		metrics_collector.RecordOperationStart(IoOperation::kRead, filepath, /*bytes_to_read=*/1);
+	}
+
+	AllocationCounter allocation_counter;
+	for (idx_t idx = 0; idx < MEASURED_OPERATION_NUM; ++idx) {
+		metrics_collector.RecordOperationStart(IoOperation::kRead, filepath, /*bytes_to_read=*/1);
+	}
+	REQUIRE(allocation_counter.GetAllocationCount() == 0);
+}
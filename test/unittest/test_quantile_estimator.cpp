@@ -132,3 +132,55 @@ TEST_CASE("Large scale quantile test", "[quantile test]") {
 	REQUIRE(p99 >= 990 - MAX_TOLERABLE_DIFF);
 	REQUIRE(p99 <= 990 + MAX_TOLERABLE_DIFF);
 }
+
+TEST_CASE("Arbitrary quantile test", "[quantile test]") {
+	constexpr size_t NUM_VALUE = 10000;
+
+	QuantileEstimator qe {METRICS_NAME, METRICS_UNIT};
+	const auto values = GetRandomNumbers(NUM_VALUE);
+	for (int cur_val : values) {
+		qe.Add(cur_val);
+	}
+	REQUIRE(qe.Count() == NUM_VALUE);
+
+	const double p999 = qe.Quantile(0.999);
+	REQUIRE(p999 >= 9990 * 0.99);
+	REQUIRE(p999 <= 9990 * 1.01);
+}
+
+TEST_CASE("Quantile merge test", "[quantile test]") {
+	// Small scale data points are merged exactly.
+	{
+		QuantileEstimator qe {METRICS_NAME, METRICS_UNIT};
+		QuantileEstimator other {METRICS_NAME, METRICS_UNIT};
+		qe.Add(1);
+		qe.Add(2);
+		other.Add(3);
+		other.Add(4);
+		other.Add(5);
+		qe.Merge(other);
+		REQUIRE(qe.Count() == 5);
+		REQUIRE(IsDoubleEqual(qe.p50(), 3.0, /*print_if_unequal=*/true));
+		REQUIRE(IsDoubleEqual(qe.p99(), 4.96, /*print_if_unequal=*/true));
+	}
+
+	// Large scale data points are merged losslessly by sketch.
+	{
+		QuantileEstimator merged {METRICS_NAME, METRICS_UNIT};
+		QuantileEstimator whole {METRICS_NAME, METRICS_UNIT};
+		QuantileEstimator part1 {METRICS_NAME, METRICS_UNIT};
+		QuantileEstimator part2 {METRICS_NAME, METRICS_UNIT};
+		const auto values = GetRandomNumbers(/*max_val=*/2000);
+		for (size_t idx = 0; idx < values.size(); ++idx) {
+			whole.Add(values[idx]);
+			auto &cur_part = idx % 2 == 0 ? part1 : part2;
+			cur_part.Add(values[idx]);
+		}
+		merged.Merge(part1);
+		merged.Merge(part2);
+		REQUIRE(merged.Count() == whole.Count());
+		for (double q : {0.5, 0.9, 0.99, 0.999}) {
+			REQUIRE(merged.Quantile(q) == whole.Quantile(q));
+		}
+	}
+}
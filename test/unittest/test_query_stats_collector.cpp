@@ -0,0 +1,97 @@
+#include "catch/catch.hpp"
+
+#include "query_stats_collector.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+QueryTag MakeQueryTag(idx_t query_id) {
+	QueryTag query_tag;
+	query_tag.connection_id = 1;
+	query_tag.query_id = query_id;
+	return query_tag;
+}
+
+// Get number of entries tracking a query.
+idx_t GetTrackedQueryCount(const QueryStatsCollector &collector) {
+	idx_t tracked_count = 0;
+	for (const auto &cur_query_stats : collector.GetAllQueryStats()) {
+		tracked_count += cur_query_stats->query_tag.IsValid() ? 1 : 0;
+	}
+	return tracked_count;
+}
+} // namespace
+
+TEST_CASE("Query stats record test", "[query stats collector test]") {
+	QueryStatsCollector collector;
+	auto &query_stats = collector.GetOrCreate(MakeQueryTag(/*query_id=*/10));
+	query_stats.RecordOperationStart(/*bytes=*/100);
+	query_stats.RecordOperationEnd(/*latency_microsec=*/20.0);
+	query_stats.RecordOperationStart(/*bytes=*/50);
+	query_stats.RecordOperationEnd(/*latency_microsec=*/30.0);
+
+	// Stats for the same query are accumulated into the same entry.
+	auto &same_query_stats = collector.GetOrCreate(MakeQueryTag(/*query_id=*/10));
+	REQUIRE(&same_query_stats == &query_stats);
+	REQUIRE(same_query_stats.request_count == 2);
+	REQUIRE(same_query_stats.bytes == 150);
+	REQUIRE(same_query_stats.io_wait_microsec == 50.0);
+	REQUIRE(same_query_stats.latency_sketch.Count() == 2);
+
+	// A different query gets its own entry.
+	auto &other_query_stats = collector.GetOrCreate(MakeQueryTag(/*query_id=*/11));
+	REQUIRE(&other_query_stats != &query_stats);
+	REQUIRE(other_query_stats.request_count == 0);
+	REQUIRE(GetTrackedQueryCount(collector) == 2);
+}
+
+TEST_CASE("Query stats eviction test", "[query stats collector test]") {
+	QueryStatsCollector collector;
+	for (idx_t query_id = 0; query_id < QueryStatsCollector::MAX_QUERY_COUNT; ++query_id) {
+		collector.GetOrCreate(MakeQueryTag(query_id)).RecordOperationStart(/*bytes=*/1);
+	}
+	REQUIRE(GetTrackedQueryCount(collector) == QueryStatsCollector::MAX_QUERY_COUNT);
+
+	// The oldest query is evicted and its entry recycled in place.
+	const auto *oldest_query_stats = &collector.GetOrCreate(MakeQueryTag(/*query_id=*/0));
+	auto &new_query_stats = collector.GetOrCreate(MakeQueryTag(QueryStatsCollector::MAX_QUERY_COUNT));
+	REQUIRE(&new_query_stats == oldest_query_stats);
+	REQUIRE(new_query_stats.request_count == 0);
+	REQUIRE(GetTrackedQueryCount(collector) == QueryStatsCollector::MAX_QUERY_COUNT);
+}
+
+TEST_CASE("Query stats reset test", "[query stats collector test]") {
+	QueryStatsCollector collector;
+	auto &query_stats = collector.GetOrCreate(MakeQueryTag(/*query_id=*/10));
+	query_stats.RecordOperationStart(/*bytes=*/100);
+	collector.Reset();
+
+	// Entries are kept after reset, and recycled before evicting any live query.
+	REQUIRE(GetTrackedQueryCount(collector) == 0);
+	REQUIRE(query_stats.request_count == 0);
+	REQUIRE(!query_stats.query_tag.IsValid());
+	auto &new_query_stats = collector.GetOrCreate(MakeQueryTag(/*query_id=*/20));
+	REQUIRE(&new_query_stats == &query_stats);
+	REQUIRE(GetTrackedQueryCount(collector) == 1);
+}
+
+TEST_CASE("Query stats merge test", "[query stats collector test]") {
+	QueryStats lhs;
+	lhs.Reset(MakeQueryTag(/*query_id=*/10));
+	lhs.RecordOperationStart(/*bytes=*/100);
+	lhs.RecordOperationEnd(/*latency_microsec=*/10.0);
+
+	QueryStats rhs;
+	rhs.Reset(MakeQueryTag(/*query_id=*/10));
+	rhs.RecordOperationStart(/*bytes=*/200);
+	rhs.RecordOperationEnd(/*latency_microsec=*/30.0);
+	rhs.RecordDuplicatedRead(/*duplicated_bytes=*/50);
+
+	lhs.Merge(rhs);
+	REQUIRE(lhs.request_count == 2);
+	REQUIRE(lhs.bytes == 300);
+	REQUIRE(lhs.io_wait_microsec == 40.0);
+	REQUIRE(lhs.latency_sketch.Count() == 2);
+	REQUIRE(lhs.duplicated_request_count == 1);
+	REQUIRE(lhs.duplicated_bytes == 50);
+}
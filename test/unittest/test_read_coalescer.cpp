@@ -0,0 +1,144 @@
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "duckdb/common/vector.hpp"
+#include "read_coalescer.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+// Content of the simulated remote file at the given offset.
+char GetFileByte(idx_t offset) {
+	return static_cast<char>(offset % 251);
+}
+
+// Fill [buffer] with file content, which blocks the first fetch until all reader threads have started, so their reads
+// are queued behind it.
+struct BlockingFetcher {
+	void Fetch(char *buffer, idx_t nr_bytes, idx_t location) {
+		if (fetch_count.fetch_add(1) == 0) {
+			while (started_reader_count.load() < expected_reader_count) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+		for (idx_t idx = 0; idx < nr_bytes; ++idx) {
+			buffer[idx] = GetFileByte(location + idx);
+		}
+	}
+
+	idx_t expected_reader_count = 0;
+	std::atomic<idx_t> started_reader_count {0};
+	std::atomic<idx_t> fetch_count {0};
+};
+
+// Issue one blocking read, then read [reader_count] ranges of [nr_bytes] starting at offsets spaced by [stride]
+// concurrently, which are queued behind the blocking read.
+void ReadConcurrently(ReadCoalescer &coalescer, ReadCoalescingStats &stats, idx_t reader_count, idx_t nr_bytes,
+                      idx_t stride, idx_t max_gap_bytes) {
+	BlockingFetcher fetcher;
+	fetcher.expected_reader_count = reader_count;
+	const ReadCoalescer::FetchFunc fetch = [&fetcher](char *buffer, idx_t cur_nr_bytes, idx_t location) {
+		fetcher.Fetch(buffer, cur_nr_bytes, location);
+	};
+
+	vector<char> first_buffer(nr_bytes);
+	std::thread first_reader([&]() {
+		coalescer.Read(first_buffer.data(), nr_bytes, /*location=*/0, max_gap_bytes, fetch, stats);
+	});
+	while (fetcher.fetch_count.load() == 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	vector<vector<char>> buffers(reader_count, vector<char>(nr_bytes));
+	vector<std::thread> readers;
+	readers.reserve(reader_count);
+	for (idx_t idx = 0; idx < reader_count; ++idx) {
+		readers.emplace_back([&, idx]() {
+			fetcher.started_reader_count.fetch_add(1);
+			coalescer.Read(buffers[idx].data(), nr_bytes, /*location=*/(idx + 1) * stride, max_gap_bytes, fetch,
+			               stats);
+		});
+	}
+	first_reader.join();
+	for (auto &cur_reader : readers) {
+		cur_reader.join();
+	}
+
+	// Every caller gets its own range.
+	for (idx_t idx = 0; idx < reader_count; ++idx) {
+		for (idx_t offset = 0; offset < nr_bytes; ++offset) {
+			REQUIRE(buffers[idx][offset] == GetFileByte((idx + 1) * stride + offset));
+		}
+	}
+}
+} // namespace
+
+TEST_CASE("Read coalescer single read test", "[read coalescer test]") {
+	ReadCoalescer coalescer;
+	ReadCoalescingStats stats;
+	vector<char> buffer(10);
+	coalescer.Read(
+	    buffer.data(), /*nr_bytes=*/10, /*location=*/100, /*max_gap_bytes=*/1024,
+	    [](char *cur_buffer, idx_t nr_bytes, idx_t location) {
+		    for (idx_t idx = 0; idx < nr_bytes; ++idx) {
+			    cur_buffer[idx] = GetFileByte(location + idx);
+		    }
+	    },
+	    stats);
+	REQUIRE(buffer[0] == GetFileByte(100));
+	REQUIRE(stats.request_count.load() == 1);
+	REQUIRE(stats.upstream_request_count.load() == 1);
+	REQUIRE(stats.merged_request_count.load() == 0);
+	REQUIRE(stats.extra_bytes.load() == 0);
+
+	stats.Reset();
+	REQUIRE(stats.request_count.load() == 0);
+}
+
+TEST_CASE("Read coalescer merge test", "[read coalescer test]") {
+	ReadCoalescer coalescer;
+	ReadCoalescingStats stats;
+	// Queued reads are 10 bytes apart, within the gap threshold, so they're fetched in one upstream request.
+	ReadConcurrently(coalescer, stats, /*reader_count=*/4, /*nr_bytes=*/100, /*stride=*/110, /*max_gap_bytes=*/10);
+	REQUIRE(stats.request_count.load() == 5);
+	REQUIRE(stats.upstream_request_count.load() == 2);
+	REQUIRE(stats.merged_request_count.load() == 3);
+	REQUIRE(stats.extra_bytes.load() == 30);
+}
+
+TEST_CASE("Read coalescer gap threshold test", "[read coalescer test]") {
+	ReadCoalescer coalescer;
+	ReadCoalescingStats stats;
+	// Queued reads are too far apart to merge.
+	ReadConcurrently(coalescer, stats, /*reader_count=*/4, /*nr_bytes=*/100, /*stride=*/1000, /*max_gap_bytes=*/10);
+	REQUIRE(stats.request_count.load() == 5);
+	REQUIRE(stats.upstream_request_count.load() == 5);
+	REQUIRE(stats.merged_request_count.load() == 0);
+	REQUIRE(stats.extra_bytes.load() == 0);
+}
+
+TEST_CASE("Read coalescer error test", "[read coalescer test]") {
+	ReadCoalescer coalescer;
+	ReadCoalescingStats stats;
+	vector<char> buffer(10);
+	bool has_error = false;
+	try {
+		coalescer.Read(
+		    buffer.data(), /*nr_bytes=*/10, /*location=*/0, /*max_gap_bytes=*/0,
+		    [](char *cur_buffer, idx_t nr_bytes, idx_t location) { throw std::runtime_error("read failure"); }, stats);
+	} catch (const std::runtime_error &) {
+		has_error = true;
+	}
+	REQUIRE(has_error);
+
+	// Coalescer is still usable after a failed read.
+	coalescer.Read(
+	    buffer.data(), /*nr_bytes=*/10, /*location=*/0, /*max_gap_bytes=*/0,
+	    [](char *cur_buffer, idx_t nr_bytes, idx_t location) { cur_buffer[0] = 'a'; }, stats);
+	REQUIRE(buffer[0] == 'a');
+}
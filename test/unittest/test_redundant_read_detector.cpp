@@ -0,0 +1,121 @@
+#include "catch/catch.hpp"
+
+#include <thread>
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "redundant_read_detector.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+} // namespace
+
+TEST_CASE("Redundant read detector disabled test", "[redundant read detector test]") {
+	RedundantReadDetector detector;
+	const string path = "s3://bucket/a.parquet";
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/0) == 0);
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/1) == 0);
+	REQUIRE(detector.GetRedundantReadStats().empty());
+}
+
+TEST_CASE("Redundant read detector overlap test", "[redundant read detector test]") {
+	RedundantReadDetector detector;
+	detector.SetEnabled(true);
+	const string path = "s3://bucket/a.parquet";
+
+	// First read never duplicates.
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/0) == 0);
+	// Adjacent read doesn't overlap.
+	REQUIRE(detector.RecordRead(path, /*location=*/100, /*nr_bytes=*/100, /*now_ns=*/1) == 0);
+	// Read across both ranges duplicates [50, 200).
+	REQUIRE(detector.RecordRead(path, /*location=*/50, /*nr_bytes=*/200, /*now_ns=*/2) == 150);
+	// Overlapping recorded ranges are only counted once.
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/300, /*now_ns=*/3) == 250);
+	// Zero-sized reads are ignored.
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/0, /*now_ns=*/4) == 0);
+	// Same range of another file isn't duplicated.
+	REQUIRE(detector.RecordRead("s3://bucket/b.parquet", /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/5) == 0);
+
+	const auto redundant_read_stats = detector.GetRedundantReadStats();
+	REQUIRE(redundant_read_stats.size() == 1);
+	REQUIRE(redundant_read_stats[0].path == path);
+	REQUIRE(redundant_read_stats[0].request_count == 4);
+	REQUIRE(redundant_read_stats[0].duplicated_request_count == 2);
+	REQUIRE(redundant_read_stats[0].duplicated_bytes == 400);
+
+	detector.Reset();
+	REQUIRE(detector.GetRedundantReadStats().empty());
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/6) == 0);
+}
+
+TEST_CASE("Redundant read detector window test", "[redundant read detector test]") {
+	RedundantReadDetector detector;
+	detector.SetEnabled(true);
+	detector.SetWindowSec(10);
+	REQUIRE(detector.GetWindowSec() == 10);
+	const string path = "s3://bucket/a.parquet";
+
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/0) == 0);
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/5 * NANOS_PER_SEC) == 100);
+	// The first read has expired, while the second one is still within the window.
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/12 * NANOS_PER_SEC) == 100);
+	// All previous reads have expired.
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/100, /*now_ns=*/30 * NANOS_PER_SEC) == 0);
+}
+
+TEST_CASE("Redundant read detector bounded memory test", "[redundant read detector test]") {
+	RedundantReadDetector detector;
+	detector.SetEnabled(true);
+	const string path = "s3://bucket/a.parquet";
+
+	// Only the most recent ranges are kept for one file, so the oldest read is no longer detected.
+	for (idx_t idx = 0; idx <= RedundantReadDetector::MAX_RANGE_COUNT_PER_FILE; ++idx) {
+		REQUIRE(detector.RecordRead(path, /*location=*/idx * 10, /*nr_bytes=*/10, /*now_ns=*/idx) == 0);
+	}
+	REQUIRE(detector.RecordRead(path, /*location=*/0, /*nr_bytes=*/10, /*now_ns=*/1000) == 0);
+	REQUIRE(detector.RecordRead(path, /*location=*/20, /*nr_bytes=*/10, /*now_ns=*/1001) == 10);
+
+	// Least recently accessed files are evicted when too many files are read.
+	const idx_t file_count = RedundantReadDetector::STRIPE_COUNT * RedundantReadDetector::MAX_FILE_COUNT_PER_STRIPE * 2;
+	for (idx_t idx = 0; idx < file_count; ++idx) {
+		const auto cur_path = "s3://bucket/file-" + std::to_string(idx);
+		const auto now_ns = 2000 + static_cast<int64_t>(idx);
+		detector.RecordRead(cur_path, /*location=*/0, /*nr_bytes=*/10, now_ns);
+		detector.RecordRead(cur_path, /*location=*/0, /*nr_bytes=*/10, now_ns);
+	}
+	const auto redundant_read_stats = detector.GetRedundantReadStats();
+	REQUIRE(redundant_read_stats.size() <=
+	        RedundantReadDetector::STRIPE_COUNT * RedundantReadDetector::MAX_FILE_COUNT_PER_STRIPE);
+	for (const auto &cur_stats : redundant_read_stats) {
+		REQUIRE(cur_stats.path != path);
+	}
+}
+
+TEST_CASE("Redundant read detector multi-thread test", "[redundant read detector test]") {
+	constexpr idx_t THREAD_COUNT = 8;
+	constexpr idx_t READ_COUNT_PER_THREAD = 100;
+	RedundantReadDetector detector;
+	detector.SetEnabled(true);
+
+	// Every thread reads the same ranges, so all but the first read of each range are redundant.
+	vector<std::thread> threads;
+	threads.reserve(THREAD_COUNT);
+	for (idx_t thread_idx = 0; thread_idx < THREAD_COUNT; ++thread_idx) {
+		threads.emplace_back([&detector]() {
+			for (idx_t idx = 0; idx < READ_COUNT_PER_THREAD; ++idx) {
+				detector.RecordRead("s3://bucket/a.parquet", /*location=*/0, /*nr_bytes=*/10, /*now_ns=*/0);
+			}
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+
+	const auto redundant_read_stats = detector.GetRedundantReadStats();
+	REQUIRE(redundant_read_stats.size() == 1);
+	REQUIRE(redundant_read_stats[0].request_count == THREAD_COUNT * READ_COUNT_PER_THREAD);
+	REQUIRE(redundant_read_stats[0].duplicated_request_count == THREAD_COUNT * READ_COUNT_PER_THREAD - 1);
+	REQUIRE(redundant_read_stats[0].duplicated_bytes == (THREAD_COUNT * READ_COUNT_PER_THREAD - 1) * 10);
+}
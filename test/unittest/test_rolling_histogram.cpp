@@ -0,0 +1,65 @@
+#include "catch/catch.hpp"
+
+#include "histogram.hpp"
+#include "rolling_histogram.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+// An arbitrary starting timestamp, which is aligned to slot boundary.
+constexpr int64_t START_NS = 1000 * RollingHistogram::SLOT_INTERVAL_SEC * NANOS_PER_SEC;
+
+// Get the number of records within window.
+size_t GetWindowCount(const RollingHistogram &rolling_histogram, int64_t now_ns, int64_t window_sec) {
+	Histogram histogram {RollingHistogram::SUB_BUCKET_BITS};
+	rolling_histogram.MergeWindowInto(now_ns, window_sec, histogram);
+	return histogram.counts();
+}
+} // namespace
+
+TEST_CASE("Rolling histogram window test", "[rolling histogram test]") {
+	RollingHistogram rolling_histogram;
+	REQUIRE(GetWindowCount(rolling_histogram, START_NS, /*window_sec=*/60) == 0);
+
+	// One record per second for 5 minutes.
+	for (int64_t sec = 0; sec < 300; ++sec) {
+		rolling_histogram.Add(/*val=*/sec, START_NS + sec * NANOS_PER_SEC);
+	}
+	const int64_t now_ns = START_NS + 299 * NANOS_PER_SEC;
+
+	// Window is rounded up to slot granularity, with the current partial slot included.
+	REQUIRE(GetWindowCount(rolling_histogram, now_ns, /*window_sec=*/60) == 70);
+	REQUIRE(GetWindowCount(rolling_histogram, now_ns, /*window_sec=*/RollingHistogram::GetMaxWindowSec()) == 300);
+
+	// Records expire as time goes on.
+	const int64_t later_ns = now_ns + 120 * NANOS_PER_SEC;
+	REQUIRE(GetWindowCount(rolling_histogram, later_ns, /*window_sec=*/60) == 0);
+
+	// Slots wrap around after max window.
+	const int64_t wrapped_ns = now_ns + RollingHistogram::GetMaxWindowSec() * NANOS_PER_SEC;
+	rolling_histogram.Add(/*val=*/1, wrapped_ns);
+	REQUIRE(GetWindowCount(rolling_histogram, wrapped_ns, /*window_sec=*/RollingHistogram::GetMaxWindowSec()) == 1);
+}
+
+TEST_CASE("Rolling histogram merge test", "[rolling histogram test]") {
+	RollingHistogram rolling_histogram;
+	RollingHistogram other;
+	rolling_histogram.Add(/*val=*/1, START_NS);
+	other.Add(/*val=*/2, START_NS);
+	other.Add(/*val=*/3, START_NS + 30 * NANOS_PER_SEC);
+	rolling_histogram.Merge(other);
+
+	const int64_t now_ns = START_NS + 30 * NANOS_PER_SEC;
+	Histogram histogram {RollingHistogram::SUB_BUCKET_BITS};
+	rolling_histogram.MergeWindowInto(now_ns, /*window_sec=*/60, histogram);
+	REQUIRE(histogram.counts() == 3);
+	REQUIRE(histogram.min() == 1);
+	REQUIRE(histogram.max() == 3);
+
+	// Only the latest slot falls into a short window.
+	REQUIRE(GetWindowCount(rolling_histogram, now_ns, /*window_sec=*/10) == 1);
+
+	rolling_histogram.Reset();
+	REQUIRE(GetWindowCount(rolling_histogram, now_ns, /*window_sec=*/60) == 0);
+}
@@ -22,3 +22,33 @@ TEST_CASE("Get bucket name test", "[string utils test]") {
 		REQUIRE(GetObjectStorageBucket(filepath) == "bucket");
 	}
 }
+
+TEST_CASE("Get file type test", "[string utils test]") {
+	REQUIRE(GetFileType("/tmp/local/file.csv") == "csv");
+	REQUIRE(GetFileType("s3://bucket/directory/object.Parquet") == "parquet");
+	REQUIRE(GetFileType("s3://bucket/directory/object.csv.gz") == "gz");
+	REQUIRE(GetFileType("https://host/data.json?version=1.2") == "json");
+	// Files without extension.
+	REQUIRE(GetFileType("s3://bucket/directory.d/object") == "");
+	REQUIRE(GetFileType("/tmp/local/file.") == "");
+}
+
+TEST_CASE("Get bucket slice test", "[string utils test]") {
+	// Local filepath.
+	{
+		const string filepath = "/tmp/local/file";
+		REQUIRE(GetObjectStorageBucketSlice(filepath).empty());
+	}
+	// Bucket without object.
+	{
+		const string filepath = "s3://bucket";
+		const auto bucket = GetObjectStorageBucketSlice(filepath);
+		REQUIRE(bucket.ToString() == "bucket");
+		REQUIRE(bucket.data == filepath.data() + 5);
+	}
+	// GCS filepath.
+	{
+		const string filepath = "gs://bucket/directory/object";
+		REQUIRE(GetObjectStorageBucketSlice(filepath).ToString() == "bucket");
+	}
+}
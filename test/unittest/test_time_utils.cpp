@@ -0,0 +1,49 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include "time_utils.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t SLEEP_MILLISEC = 20;
+constexpr int64_t NANOS_PER_MILLI = 1000 * 1000;
+
+// Check latency clock measures a sleep with reasonable accuracy.
+void CheckLatencyClockMeasurement(LatencyClockSource clock_source) {
+	const auto start_ns = GetLatencyClockNowNanoSec(clock_source);
+	std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MILLISEC));
+	const auto end_ns = GetLatencyClockNowNanoSec(clock_source);
+	REQUIRE(end_ns - start_ns >= SLEEP_MILLISEC * NANOS_PER_MILLI * 9 / 10);
+	REQUIRE(end_ns - start_ns < SLEEP_MILLISEC * NANOS_PER_MILLI * 100);
+}
+} // namespace
+
+TEST_CASE("Steady latency clock test", "[time utils test]") {
+	CheckLatencyClockMeasurement(LatencyClockSource::kSteadyClock);
+}
+
+TEST_CASE("TSC latency clock test", "[time utils test]") {
+	// Unsupported TSC falls back to steady clock.
+	CheckLatencyClockMeasurement(LatencyClockSource::kTsc);
+	if (!IsTscClockSupported()) {
+		return;
+	}
+
+	// TSC timestamps are mapped onto steady clock timeline.
+	auto steady_ns = GetSteadyNowNanoSecSinceEpoch();
+	auto tsc_ns = GetLatencyClockNowNanoSec(LatencyClockSource::kTsc);
+	REQUIRE(std::abs(tsc_ns - steady_ns) < SLEEP_MILLISEC * NANOS_PER_MILLI);
+
+	// TSC is recalibrated after the interval, and stays on steady clock timeline.
+	std::this_thread::sleep_for(std::chrono::nanoseconds(TSC_RECALIBRATION_INTERVAL_NS));
+	GetLatencyClockNowNanoSec(LatencyClockSource::kTsc);
+	REQUIRE(IsTscClockSupported());
+	CheckLatencyClockMeasurement(LatencyClockSource::kTsc);
+	steady_ns = GetSteadyNowNanoSecSinceEpoch();
+	tsc_ns = GetLatencyClockNowNanoSec(LatencyClockSource::kTsc);
+	REQUIRE(std::abs(tsc_ns - steady_ns) < SLEEP_MILLISEC * NANOS_PER_MILLI);
+}
@@ -0,0 +1,73 @@
+#include "catch/catch.hpp"
+
+#include <utility>
+
+#include "timeseries_sampler.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int64_t NANOS_PER_SEC = 1000LL * 1000 * 1000;
+
+// Add [count] read records with the given latency and request size into cumulative stats.
+void AddReads(TimeSeriesSampler::CumulativeStatsMap &cumulative_stats, const string &bucket, idx_t count,
+              double latency_us, double bytes) {
+	auto &cur_stats = cumulative_stats[std::make_pair(bucket, IoOperation::kRead)];
+	for (idx_t idx = 0; idx < count; ++idx) {
+		cur_stats.latency_histogram->Add(latency_us);
+		cur_stats.bytes += bytes;
+	}
+}
+} // namespace
+
+TEST_CASE("Time series sampler rate test", "[timeseries sampler test]") {
+	TimeSeriesSampler sampler;
+
+	// First tick is baseline only.
+	{
+		TimeSeriesSampler::CumulativeStatsMap cumulative_stats;
+		AddReads(cumulative_stats, /*bucket=*/"", /*count=*/10, /*latency_us=*/100, /*bytes=*/1024);
+		sampler.AddTick(/*steady_timestamp_ns=*/NANOS_PER_SEC, /*system_timestamp_ms=*/1000,
+		                std::move(cumulative_stats));
+	}
+	REQUIRE(sampler.GetTicks().empty());
+
+	// 20 more reads over the next 2 seconds, with higher latency.
+	{
+		TimeSeriesSampler::CumulativeStatsMap cumulative_stats;
+		AddReads(cumulative_stats, /*bucket=*/"", /*count=*/10, /*latency_us=*/100, /*bytes=*/1024);
+		AddReads(cumulative_stats, /*bucket=*/"", /*count=*/20, /*latency_us=*/1000, /*bytes=*/1024);
+		sampler.AddTick(/*steady_timestamp_ns=*/3 * NANOS_PER_SEC, /*system_timestamp_ms=*/3000,
+		                std::move(cumulative_stats));
+	}
+	const auto ticks = sampler.GetTicks();
+	REQUIRE(ticks.size() == 1);
+	REQUIRE(ticks[0].timestamp_ms == 3000);
+	REQUIRE(ticks[0].interval_sec == 2.0);
+	REQUIRE(ticks[0].points.size() == 1);
+	const auto &point = ticks[0].points[0];
+	REQUIRE(point.bucket.empty());
+	REQUIRE(point.io_oper == IoOperation::kRead);
+	REQUIRE(point.ops_per_sec == 10.0);
+	REQUIRE(point.bytes_per_sec == 10.0 * 1024);
+	// Latency quantiles only reflect records within the tick.
+	REQUIRE(point.p50_latency_us >= 1000 * 15.0 / 16);
+	REQUIRE(point.p50_latency_us <= 1000 * 17.0 / 16);
+
+	sampler.Reset();
+	REQUIRE(sampler.GetTicks().empty());
+}
+
+TEST_CASE("Time series sampler bounded tick test", "[timeseries sampler test]") {
+	TimeSeriesSampler sampler;
+	for (idx_t idx = 0; idx <= TimeSeriesSampler::MAX_TICK_COUNT + 10; ++idx) {
+		TimeSeriesSampler::CumulativeStatsMap cumulative_stats;
+		AddReads(cumulative_stats, /*bucket=*/"bucket", /*count=*/idx + 1, /*latency_us=*/100, /*bytes=*/1);
+		sampler.AddTick(/*steady_timestamp_ns=*/(idx + 1) * NANOS_PER_SEC, /*system_timestamp_ms=*/(idx + 1) * 1000,
+		                std::move(cumulative_stats));
+	}
+	const auto ticks = sampler.GetTicks();
+	REQUIRE(ticks.size() == TimeSeriesSampler::MAX_TICK_COUNT);
+	REQUIRE(ticks.back().points[0].bucket == "bucket");
+	REQUIRE(ticks.back().points[0].ops_per_sec == 1.0);
+}
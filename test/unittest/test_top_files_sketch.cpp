@@ -0,0 +1,79 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/string.hpp"
+#include "top_files_sketch.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+// Get stats for the given file if tracked, otherwise nullptr.
+const FileAccessStats *FindFileStats(const TopFilesSketch &sketch, const string &path) {
+	for (const auto &cur_file_stats : sketch.GetAllEntries()) {
+		if (cur_file_stats->request_count > 0 && cur_file_stats->path == path) {
+			return cur_file_stats.get();
+		}
+	}
+	return nullptr;
+}
+
+void RecordRequest(TopFilesSketch &sketch, const string &path, int64_t bytes) {
+	auto &file_stats = sketch.GetOrCreate(path);
+	file_stats.RecordOperationStart(bytes);
+	file_stats.RecordOperationEnd(/*latency_microsec=*/1.0);
+}
+} // namespace
+
+TEST_CASE("Top files sketch exact test", "[top files sketch test]") {
+	TopFilesSketch sketch;
+	RecordRequest(sketch, "s3://bucket/a", /*bytes=*/10);
+	RecordRequest(sketch, "s3://bucket/a", /*bytes=*/20);
+	RecordRequest(sketch, "s3://bucket/b", /*bytes=*/5);
+
+	// Counts are exact when there're fewer files than capacity.
+	const auto *file_stats = FindFileStats(sketch, "s3://bucket/a");
+	REQUIRE(file_stats != nullptr);
+	REQUIRE(file_stats->request_count == 2);
+	REQUIRE(file_stats->request_count_error == 0);
+	REQUIRE(file_stats->bytes == 30);
+	REQUIRE(file_stats->total_latency_microsec == 2.0);
+	REQUIRE(FindFileStats(sketch, "s3://bucket/b")->request_count == 1);
+}
+
+TEST_CASE("Top files sketch heavy hitters test", "[top files sketch test]") {
+	TopFilesSketch sketch;
+	// One hot file interleaved with a long tail of files accessed once, which is far more than capacity.
+	constexpr idx_t COLD_FILE_COUNT = 100 * TopFilesSketch::CAPACITY;
+	for (idx_t idx = 0; idx < COLD_FILE_COUNT; ++idx) {
+		RecordRequest(sketch, "s3://bucket/cold-" + std::to_string(idx), /*bytes=*/1);
+		if (idx % 10 == 0) {
+			RecordRequest(sketch, "s3://bucket/hot", /*bytes=*/1);
+		}
+	}
+
+	// Memory is bounded, and the hot file is never evicted with its count never underestimated.
+	REQUIRE(sketch.GetAllEntries().size() == TopFilesSketch::CAPACITY);
+	const auto *file_stats = FindFileStats(sketch, "s3://bucket/hot");
+	REQUIRE(file_stats != nullptr);
+	REQUIRE(file_stats->request_count >= COLD_FILE_COUNT / 10);
+	REQUIRE(file_stats->request_count - file_stats->request_count_error <= COLD_FILE_COUNT / 10);
+
+	// Hash index stays consistent over evictions, every tracked file is looked up to its own entry.
+	for (const auto &cur_file_stats : sketch.GetAllEntries()) {
+		REQUIRE(&sketch.GetOrCreate(cur_file_stats->path) == cur_file_stats.get());
+	}
+}
+
+TEST_CASE("Top files sketch reset test", "[top files sketch test]") {
+	TopFilesSketch sketch;
+	auto &file_stats = sketch.GetOrCreate("s3://bucket/a");
+	file_stats.RecordOperationStart(/*bytes=*/10);
+	sketch.Reset();
+
+	// Entries are kept in place after reset.
+	REQUIRE(FindFileStats(sketch, "s3://bucket/a") == nullptr);
+	REQUIRE(file_stats.request_count == 0);
+	REQUIRE(file_stats.bytes == 0);
+
+	RecordRequest(sketch, "s3://bucket/a", /*bytes=*/5);
+	REQUIRE(FindFileStats(sketch, "s3://bucket/a")->request_count == 1);
+}